@@ -0,0 +1,423 @@
+#include "arrival_process.h"
+
+#include "utils.h" // For SplitSpec, ParseSpecNumber
+#include "ns3/log.h"
+#include "ns3/double.h"                 // For DoubleValue
+#include "ns3/random-variable-stream.h" // For ExponentialRandomVariable, ParetoRandomVariable
+#include "ns3/core-module.h"            // For TimeValue, CreateObject
+
+#include <algorithm> // For std::max, std::min
+#include <cmath>     // For std::sqrt
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("ArrivalProcess");
+
+NS_OBJECT_ENSURE_REGISTERED(ArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(ConstantArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(PoissonArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(ParetoArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(OnOffArrivalProcess);
+NS_OBJECT_ENSURE_REGISTERED(RampArrivalProcess);
+
+// --- ArrivalProcess ---
+
+TypeId ArrivalProcess::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ArrivalProcess")
+                            .SetParent<Object>()
+                            .SetGroupName("Applications");
+    return tid;
+}
+
+ArrivalProcess::ArrivalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ArrivalProcess::~ArrivalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void ArrivalProcess::Reset()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+// --- ConstantArrivalProcess ---
+
+TypeId ConstantArrivalProcess::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ConstantArrivalProcess")
+                            .SetParent<ArrivalProcess>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<ConstantArrivalProcess>()
+                            .AddAttribute("Interval",
+                                          "Fixed time between consecutive requests.",
+                                          TimeValue(Seconds(1.0)),
+                                          MakeTimeAccessor(&ConstantArrivalProcess::m_interval),
+                                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+ConstantArrivalProcess::ConstantArrivalProcess()
+    : m_interval(Seconds(1.0))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ConstantArrivalProcess::~ConstantArrivalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time ConstantArrivalProcess::GetNextInterArrival()
+{
+    return m_interval;
+}
+
+int64_t ConstantArrivalProcess::AssignStreams(int64_t stream [[maybe_unused]])
+{
+    return 0; // Deterministic, no random variables.
+}
+
+// --- PoissonArrivalProcess ---
+
+TypeId PoissonArrivalProcess::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::PoissonArrivalProcess")
+                            .SetParent<ArrivalProcess>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<PoissonArrivalProcess>()
+                            .AddAttribute("MeanInterval",
+                                          "Mean time between consecutive requests.",
+                                          TimeValue(Seconds(1.0)),
+                                          MakeTimeAccessor(&PoissonArrivalProcess::m_meanInterval),
+                                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+PoissonArrivalProcess::PoissonArrivalProcess()
+    : m_meanInterval(Seconds(1.0)),
+      m_gap(CreateObject<ExponentialRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PoissonArrivalProcess::~PoissonArrivalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time PoissonArrivalProcess::GetNextInterArrival()
+{
+    // Bound of 0 means the exponential is not truncated.
+    return Seconds(m_gap->GetValue(m_meanInterval.GetSeconds(), 0.0));
+}
+
+int64_t PoissonArrivalProcess::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_gap->SetStream(stream);
+    return 1;
+}
+
+// --- ParetoArrivalProcess ---
+
+TypeId ParetoArrivalProcess::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ParetoArrivalProcess")
+                            .SetParent<ArrivalProcess>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<ParetoArrivalProcess>()
+                            .AddAttribute("MeanInterval",
+                                          "Mean time between consecutive requests.",
+                                          TimeValue(Seconds(1.0)),
+                                          MakeTimeAccessor(&ParetoArrivalProcess::m_meanInterval),
+                                          MakeTimeChecker(Time(0)))
+                            .AddAttribute("Shape",
+                                          "Pareto shape parameter (alpha). Must be > 1 for a finite mean; "
+                                          "values close to 1 give the heaviest tails.",
+                                          DoubleValue(1.5),
+                                          MakeDoubleAccessor(&ParetoArrivalProcess::m_shape),
+                                          MakeDoubleChecker<double>(1.01));
+    return tid;
+}
+
+ParetoArrivalProcess::ParetoArrivalProcess()
+    : m_meanInterval(Seconds(1.0)),
+      m_shape(1.5),
+      m_gap(CreateObject<ParetoRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ParetoArrivalProcess::~ParetoArrivalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time ParetoArrivalProcess::GetNextInterArrival()
+{
+    // Mean of a Pareto(scale, shape) is shape * scale / (shape - 1); invert for the scale.
+    const double scale = m_meanInterval.GetSeconds() * (m_shape - 1.0) / m_shape;
+    return Seconds(m_gap->GetValue(scale, m_shape, 0.0));
+}
+
+int64_t ParetoArrivalProcess::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_gap->SetStream(stream);
+    return 1;
+}
+
+// --- OnOffArrivalProcess ---
+
+TypeId OnOffArrivalProcess::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::OnOffArrivalProcess")
+                            .SetParent<ArrivalProcess>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<OnOffArrivalProcess>()
+                            .AddAttribute("MeanInterval",
+                                          "Long-run mean time between consecutive requests.",
+                                          TimeValue(Seconds(1.0)),
+                                          MakeTimeAccessor(&OnOffArrivalProcess::m_meanInterval),
+                                          MakeTimeChecker(Time(0)))
+                            .AddAttribute("MeanOnTime",
+                                          "Mean duration of an ON (burst) phase.",
+                                          TimeValue(MilliSeconds(100)),
+                                          MakeTimeAccessor(&OnOffArrivalProcess::m_meanOnTime),
+                                          MakeTimeChecker(Time(1)))
+                            .AddAttribute("MeanOffTime",
+                                          "Mean duration of an OFF (quiet) phase.",
+                                          TimeValue(MilliSeconds(900)),
+                                          MakeTimeAccessor(&OnOffArrivalProcess::m_meanOffTime),
+                                          MakeTimeChecker(Time(0)))
+                            .AddAttribute("OffRateFraction",
+                                          "Arrival rate during OFF phases as a fraction of the ON rate "
+                                          "(0 = silent OFF phases, 1 = plain Poisson).",
+                                          DoubleValue(0.0),
+                                          MakeDoubleAccessor(&OnOffArrivalProcess::m_offRateFraction),
+                                          MakeDoubleChecker<double>(0.0, 1.0));
+    return tid;
+}
+
+OnOffArrivalProcess::OnOffArrivalProcess()
+    : m_meanInterval(Seconds(1.0)),
+      m_meanOnTime(MilliSeconds(100)),
+      m_meanOffTime(MilliSeconds(900)),
+      m_offRateFraction(0.0),
+      m_on(true),
+      m_phaseRemainingS(0.0),
+      m_onRate(0.0),
+      m_offRate(0.0),
+      m_arrivalDraw(CreateObject<ExponentialRandomVariable>()),
+      m_phaseDraw(CreateObject<ExponentialRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OnOffArrivalProcess::~OnOffArrivalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void OnOffArrivalProcess::UpdateRates()
+{
+    const double onS = m_meanOnTime.GetSeconds();
+    const double offS = m_meanOffTime.GetSeconds();
+    const double intervalS = std::max(1e-9, m_meanInterval.GetSeconds());
+
+    // Long-run rate = (onRate * onS + offRate * offS) / (onS + offS) must equal 1 / interval.
+    m_onRate = (onS + offS) / (intervalS * (onS + m_offRateFraction * offS));
+    m_offRate = m_offRateFraction * m_onRate;
+    NS_LOG_DEBUG("OnOff arrivals: ON rate " << m_onRate << " req/s, OFF rate " << m_offRate
+                 << " req/s (mean ON " << onS << "s, mean OFF " << offS << "s)");
+}
+
+void OnOffArrivalProcess::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    UpdateRates();
+    m_on = true;
+    m_phaseRemainingS = m_phaseDraw->GetValue(1.0, 0.0) * m_meanOnTime.GetSeconds();
+}
+
+Time OnOffArrivalProcess::GetNextInterArrival()
+{
+    if (m_onRate <= 0.0) {
+        Reset(); // First use without an explicit Reset().
+    }
+
+    // Both phases are memoryless, so we can race the next arrival against the end of
+    // the current phase and carry the elapsed time over phase switches.
+    double gapS = 0.0;
+    while (true) {
+        const double rate = m_on ? m_onRate : m_offRate;
+        if (rate > 0.0) {
+            const double candidateS = m_arrivalDraw->GetValue(1.0, 0.0) / rate;
+            if (candidateS < m_phaseRemainingS) {
+                m_phaseRemainingS -= candidateS;
+                gapS += candidateS;
+                break;
+            }
+        }
+        gapS += m_phaseRemainingS;
+        m_on = !m_on;
+        const double meanPhaseS = m_on ? m_meanOnTime.GetSeconds() : m_meanOffTime.GetSeconds();
+        m_phaseRemainingS = m_phaseDraw->GetValue(1.0, 0.0) * meanPhaseS;
+    }
+    return Seconds(gapS);
+}
+
+int64_t OnOffArrivalProcess::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_arrivalDraw->SetStream(stream);
+    m_phaseDraw->SetStream(stream + 1);
+    return 2;
+}
+
+// --- RampArrivalProcess ---
+
+TypeId RampArrivalProcess::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::RampArrivalProcess")
+                            .SetParent<ArrivalProcess>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<RampArrivalProcess>()
+                            .AddAttribute("BaseInterval",
+                                          "Inter-arrival time corresponding to a rate factor of 1.0.",
+                                          TimeValue(Seconds(1.0)),
+                                          MakeTimeAccessor(&RampArrivalProcess::m_baseInterval),
+                                          MakeTimeChecker(Time(1)))
+                            .AddAttribute("StartFactor",
+                                          "Rate multiplier at the start of the ramp.",
+                                          DoubleValue(1.0),
+                                          MakeDoubleAccessor(&RampArrivalProcess::m_startFactor),
+                                          MakeDoubleChecker<double>(0.001))
+                            .AddAttribute("EndFactor",
+                                          "Rate multiplier reached at the end of the ramp (held afterwards).",
+                                          DoubleValue(2.0),
+                                          MakeDoubleAccessor(&RampArrivalProcess::m_endFactor),
+                                          MakeDoubleChecker<double>(0.001))
+                            .AddAttribute("RampDuration",
+                                          "Time over which the rate moves from StartFactor to EndFactor.",
+                                          TimeValue(Seconds(10.0)),
+                                          MakeTimeAccessor(&RampArrivalProcess::m_rampDuration),
+                                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+RampArrivalProcess::RampArrivalProcess()
+    : m_baseInterval(Seconds(1.0)),
+      m_startFactor(1.0),
+      m_endFactor(2.0),
+      m_rampDuration(Seconds(10.0)),
+      m_elapsedS(0.0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RampArrivalProcess::~RampArrivalProcess()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void RampArrivalProcess::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    m_elapsedS = 0.0;
+}
+
+Time RampArrivalProcess::GetNextInterArrival()
+{
+    const double baseRate = 1.0 / m_baseInterval.GetSeconds();
+    const double durationS = m_rampDuration.GetSeconds();
+    const double endRate = baseRate * m_endFactor;
+
+    double gapS = 0.0;
+    if (m_elapsedS >= durationS || durationS <= 0.0) {
+        gapS = 1.0 / endRate;
+    } else {
+        // Rate is linear in time: r(t) = r0 + slope * (t - elapsed). Find the gap whose
+        // integrated rate is exactly one request, falling back to the flat end rate if
+        // the ramp finishes first.
+        const double slope = baseRate * (m_endFactor - m_startFactor) / durationS;
+        const double rate0 = baseRate * m_startFactor + slope * m_elapsedS;
+        const double remainingRampS = durationS - m_elapsedS;
+        const double rampArea = rate0 * remainingRampS + 0.5 * slope * remainingRampS * remainingRampS;
+
+        if (rampArea >= 1.0) {
+            // Numerically stable root of 0.5 * slope * g^2 + rate0 * g - 1 = 0.
+            gapS = 2.0 / (rate0 + std::sqrt(std::max(0.0, rate0 * rate0 + 2.0 * slope)));
+        } else {
+            gapS = remainingRampS + (1.0 - rampArea) / endRate;
+        }
+    }
+
+    m_elapsedS += gapS;
+    return Seconds(gapS);
+}
+
+int64_t RampArrivalProcess::AssignStreams(int64_t stream [[maybe_unused]])
+{
+    return 0; // Deterministic, no random variables.
+}
+
+// --- Factory ---
+
+Ptr<ArrivalProcess> CreateArrivalProcess(const std::string& spec, Time meanInterval)
+{
+    NS_LOG_FUNCTION(spec << meanInterval);
+    std::vector<std::string> fields = SplitSpec(spec);
+    const std::string kind = fields.empty() ? "fixed" : fields[0];
+
+    // Parses fields[index] as a number, aborting with a helpful message on failure.
+    auto numberAt = [&](size_t index, const char* what) {
+        double value = 0.0;
+        if (index >= fields.size() || !ParseSpecNumber(fields[index], value)) {
+            NS_FATAL_ERROR("Invalid arrival spec '" << spec << "': expected a number for " << what << ".");
+        }
+        return value;
+    };
+
+    Ptr<ArrivalProcess> process;
+    if (kind == "fixed") {
+        process = CreateObject<ConstantArrivalProcess>();
+        process->SetAttribute("Interval", TimeValue(meanInterval));
+    } else if (kind == "poisson") {
+        process = CreateObject<PoissonArrivalProcess>();
+        process->SetAttribute("MeanInterval", TimeValue(meanInterval));
+    } else if (kind == "pareto") {
+        process = CreateObject<ParetoArrivalProcess>();
+        process->SetAttribute("MeanInterval", TimeValue(meanInterval));
+        if (fields.size() > 1) {
+            process->SetAttribute("Shape", DoubleValue(numberAt(1, "the Pareto shape")));
+        }
+    } else if (kind == "onoff") {
+        process = CreateObject<OnOffArrivalProcess>();
+        process->SetAttribute("MeanInterval", TimeValue(meanInterval));
+        process->SetAttribute("MeanOnTime", TimeValue(MilliSeconds(numberAt(1, "the mean ON time (ms)"))));
+        process->SetAttribute("MeanOffTime", TimeValue(MilliSeconds(numberAt(2, "the mean OFF time (ms)"))));
+        if (fields.size() > 3) {
+            process->SetAttribute("OffRateFraction", DoubleValue(numberAt(3, "the OFF rate fraction")));
+        }
+    } else if (kind == "ramp") {
+        process = CreateObject<RampArrivalProcess>();
+        process->SetAttribute("BaseInterval", TimeValue(meanInterval));
+        process->SetAttribute("StartFactor", DoubleValue(numberAt(1, "the start factor")));
+        process->SetAttribute("EndFactor", DoubleValue(numberAt(2, "the end factor")));
+        process->SetAttribute("RampDuration", TimeValue(Seconds(numberAt(3, "the ramp duration (s)"))));
+    } else {
+        NS_FATAL_ERROR("Unknown arrival process '" << kind << "' in spec '" << spec
+                       << "'. Supported: fixed, poisson, pareto, onoff, ramp.");
+    }
+    return process;
+}
+
+} // namespace ns3
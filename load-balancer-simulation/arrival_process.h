@@ -0,0 +1,201 @@
+#ifndef ARRIVAL_PROCESS_H
+#define ARRIVAL_PROCESS_H
+
+// NS-3 Includes
+#include "ns3/nstime.h"                 // For ns3::Time
+#include "ns3/object.h"                 // Base class
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h" // For Ptr<ExponentialRandomVariable>, Ptr<ParetoRandomVariable>
+
+// Standard Library Includes
+#include <cstdint> // For int64_t
+#include <string>
+
+namespace ns3 {
+
+/**
+ * @brief Abstract generator of request inter-arrival times for open-loop clients.
+ *
+ * An ArrivalProcess decides *when* a client issues its next request, independently
+ * of when responses come back. Implementations draw all randomness from ns-3
+ * RandomVariableStream objects so that runs are reproducible once streams are
+ * assigned via AssignStreams().
+ */
+class ArrivalProcess : public Object
+{
+  public:
+    /**
+     * @brief Gets the TypeId for this class.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    ArrivalProcess();
+    virtual ~ArrivalProcess() override;
+
+    /**
+     * @brief Returns the gap between the previous request and the next one.
+     * @return The next inter-arrival time (never negative).
+     */
+    virtual Time GetNextInterArrival() = 0;
+
+    /**
+     * @brief Resets any internal state (e.g., ramp position or MMPP phase).
+     * Called by the client when it (re)starts.
+     */
+    virtual void Reset();
+
+    /**
+     * @brief Assigns fixed random variable stream numbers to the random variables used.
+     * @param stream First stream index to use.
+     * @return The number of stream indices assigned.
+     */
+    virtual int64_t AssignStreams(int64_t stream) = 0;
+};
+
+/**
+ * @brief Perfectly periodic arrivals (the original client behavior).
+ */
+class ConstantArrivalProcess : public ArrivalProcess
+{
+  public:
+    static TypeId GetTypeId();
+    ConstantArrivalProcess();
+    virtual ~ConstantArrivalProcess() override;
+
+    virtual Time GetNextInterArrival() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_interval; //!< Fixed gap between requests (attribute).
+};
+
+/**
+ * @brief Poisson arrivals: exponentially distributed inter-arrival times.
+ */
+class PoissonArrivalProcess : public ArrivalProcess
+{
+  public:
+    static TypeId GetTypeId();
+    PoissonArrivalProcess();
+    virtual ~PoissonArrivalProcess() override;
+
+    virtual Time GetNextInterArrival() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_meanInterval;                      //!< Mean inter-arrival time (attribute).
+    Ptr<ExponentialRandomVariable> m_gap;     //!< Source of exponential gaps.
+};
+
+/**
+ * @brief Heavy-tailed arrivals: Pareto distributed inter-arrival times.
+ *
+ * The Pareto scale is derived from the configured mean so that the long-run
+ * request rate matches the other processes; lower shapes produce burstier
+ * traffic (long silences followed by clusters of requests).
+ */
+class ParetoArrivalProcess : public ArrivalProcess
+{
+  public:
+    static TypeId GetTypeId();
+    ParetoArrivalProcess();
+    virtual ~ParetoArrivalProcess() override;
+
+    virtual Time GetNextInterArrival() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_meanInterval;                //!< Mean inter-arrival time (attribute).
+    double m_shape;                     //!< Pareto shape (alpha > 1 for a finite mean) (attribute).
+    Ptr<ParetoRandomVariable> m_gap;    //!< Source of Pareto gaps.
+};
+
+/**
+ * @brief Bursty on-off arrivals modelled as a two-state Markov-modulated Poisson process (MMPP).
+ *
+ * The process alternates between an ON and an OFF phase with exponentially distributed
+ * sojourn times. Within a phase arrivals are Poisson; the OFF rate is a fraction of the
+ * ON rate (0 for silent OFF periods). The ON rate is chosen so that the long-run mean
+ * inter-arrival time equals MeanInterval.
+ */
+class OnOffArrivalProcess : public ArrivalProcess
+{
+  public:
+    static TypeId GetTypeId();
+    OnOffArrivalProcess();
+    virtual ~OnOffArrivalProcess() override;
+
+    virtual Time GetNextInterArrival() override;
+    virtual void Reset() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    /**
+     * @brief Computes the per-phase arrival rates (requests/second) from the attributes.
+     */
+    void UpdateRates();
+
+    Time m_meanInterval;        //!< Long-run mean inter-arrival time (attribute).
+    Time m_meanOnTime;          //!< Mean ON phase duration (attribute).
+    Time m_meanOffTime;         //!< Mean OFF phase duration (attribute).
+    double m_offRateFraction;   //!< OFF-phase rate as a fraction of the ON-phase rate (attribute).
+
+    bool m_on;                  //!< True while in the ON phase.
+    double m_phaseRemainingS;   //!< Time left in the current phase (seconds).
+    double m_onRate;            //!< Arrival rate during ON (requests/second).
+    double m_offRate;           //!< Arrival rate during OFF (requests/second).
+
+    Ptr<ExponentialRandomVariable> m_arrivalDraw;  //!< Unit-mean exponential for arrival gaps.
+    Ptr<ExponentialRandomVariable> m_phaseDraw;    //!< Unit-mean exponential for phase durations.
+};
+
+/**
+ * @brief Deterministic linear ramp of the request rate.
+ *
+ * The rate moves linearly from StartFactor to EndFactor times the base rate
+ * (1 / BaseInterval) over RampDuration and then holds at the end rate. Arrivals
+ * are placed exactly where the integrated rate crosses each whole request, so the
+ * schedule is fully deterministic.
+ */
+class RampArrivalProcess : public ArrivalProcess
+{
+  public:
+    static TypeId GetTypeId();
+    RampArrivalProcess();
+    virtual ~RampArrivalProcess() override;
+
+    virtual Time GetNextInterArrival() override;
+    virtual void Reset() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_baseInterval;    //!< Inter-arrival time corresponding to a factor of 1.0 (attribute).
+    double m_startFactor;   //!< Rate multiplier at the start of the ramp (attribute).
+    double m_endFactor;     //!< Rate multiplier at the end of the ramp (attribute).
+    Time m_rampDuration;    //!< Duration of the ramp (attribute).
+
+    double m_elapsedS;      //!< Time since Reset() at which the previous arrival occurred (seconds).
+};
+
+/**
+ * @brief Builds an ArrivalProcess from a compact command-line spec.
+ *
+ * Supported specs (fields separated by ':'):
+ * - `fixed`                                     Periodic, one request every @p meanInterval.
+ * - `poisson`                                   Exponential gaps with mean @p meanInterval.
+ * - `pareto[:shape]`                            Pareto gaps with mean @p meanInterval (shape defaults to 1.5).
+ * - `onoff:onMs:offMs[:offRateFraction]`        Two-state MMPP with the given mean phase durations.
+ * - `ramp:startFactor:endFactor:durationS`      Linear rate ramp relative to 1 / @p meanInterval.
+ *
+ * Terminates the simulation with NS_FATAL_ERROR on an unknown or malformed spec.
+ *
+ * @param spec The spec string.
+ * @param meanInterval The base/mean inter-arrival time (normally --reqInterval).
+ * @return The configured arrival process.
+ */
+Ptr<ArrivalProcess> CreateArrivalProcess(const std::string& spec, Time meanInterval);
+
+} // namespace ns3
+
+#endif // ARRIVAL_PROCESS_H
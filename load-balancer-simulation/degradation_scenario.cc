@@ -0,0 +1,282 @@
+#include "degradation_scenario.h"
+
+#include "latency_server_app.h"
+#include "service_time_distribution.h" // For CreateServiceTimeDistribution
+#include "utils.h"                     // For SplitSpec, ParseSpecNumber
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm> // For std::min
+#include <fstream>
+#include <string>
+#include <utility> // For std::pair
+#include <vector>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("DegradationScenario");
+
+namespace { // Anonymous namespace for internal linkage helpers
+
+// Parses a non-negative ns-3 style time string ("250ms", "1.5s"); a bare number is seconds.
+bool ParseScenarioTime(const std::string& field, Time& time)
+{
+    static const std::pair<std::string, double> kUnits[] = {
+        {"ns", 1e-9}, {"us", 1e-6}, {"ms", 1e-3}, {"min", 60.0}, {"s", 1.0}};
+    double value = 0.0;
+    double scale = 1.0;
+    bool parsed = ParseSpecNumber(field, value);
+    for (const auto& [unit, unitScale] : kUnits)
+    {
+        if (parsed) {
+            break;
+        }
+        if (field.size() > unit.size() && field.compare(field.size() - unit.size(), unit.size(), unit) == 0) {
+            parsed = ParseSpecNumber(field.substr(0, field.size() - unit.size()), value);
+            scale = unitScale;
+        }
+    }
+    if (!parsed || value < 0.0) {
+        return false;
+    }
+    time = Seconds(value * scale);
+    return true;
+}
+
+// Schedules a call at an absolute simulation time.
+template <typename... Params, typename... Args>
+void ScheduleAt(Time at, void (LatencyServerApp::*method)(Params...), Ptr<LatencyServerApp> server, Args... args)
+{
+    Simulator::Schedule(at - Simulator::Now(), method, server, args...);
+}
+
+} // namespace
+
+DegradationScenario::DegradationScenario()
+{
+}
+
+void
+DegradationScenario::AddEvents(const std::string& spec)
+{
+    NS_LOG_FUNCTION(this << spec);
+    for (const std::string& text : SplitSpec(spec, ';'))
+    {
+        if (!text.empty()) {
+            AddEvent(text);
+        }
+    }
+}
+
+void
+DegradationScenario::LoadFile(const std::string& path)
+{
+    NS_LOG_FUNCTION(this << path);
+    std::ifstream in(path);
+    if (!in) {
+        NS_FATAL_ERROR("Cannot open degradation scenario file '" << path << "'.");
+    }
+    std::string line;
+    while (std::getline(in, line))
+    {
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        AddEvents(line);
+    }
+}
+
+void
+DegradationScenario::AddEvent(const std::string& text)
+{
+    NS_LOG_FUNCTION(this << text);
+    const std::vector<std::string> fields = SplitSpec(text);
+    Event event{};
+    event.kind = fields.empty() ? "" : fields[0];
+    event.text = text;
+    event.factor = 1.0;
+
+    // Parses fields[index], aborting with a helpful message on failure.
+    auto timeAt = [&](size_t index, const char* what) {
+        Time time;
+        if (index >= fields.size() || !ParseScenarioTime(fields[index], time)) {
+            NS_FATAL_ERROR("Invalid degradation event '" << text << "': expected a non-negative time for "
+                           << what << ".");
+        }
+        return time;
+    };
+    auto numberAt = [&](size_t index, const char* what) {
+        double value = 0.0;
+        if (index >= fields.size() || !ParseSpecNumber(fields[index], value) || value < 0.0) {
+            NS_FATAL_ERROR("Invalid degradation event '" << text << "': expected a non-negative number for "
+                           << what << ".");
+        }
+        return value;
+    };
+    auto checkFieldCount = [&](size_t count, const char* usage) {
+        if (fields.size() != count) {
+            NS_FATAL_ERROR("Invalid degradation event '" << text << "': expected " << usage << ".");
+        }
+    };
+
+    if (fields.size() < 2) {
+        NS_FATAL_ERROR("Invalid degradation event '" << text << "': expected <kind>:<server>:...");
+    }
+    event.allServers = (fields[1] == "*");
+    if (!event.allServers) {
+        event.server = static_cast<uint32_t>(numberAt(1, "the server index"));
+    }
+
+    if (event.kind == "set") {
+        // Take the rest of the event verbatim: the service-time spec has its own ':' fields.
+        size_t specStart = 0;
+        for (int colon = 0; colon < 3 && specStart != std::string::npos; ++colon) {
+            specStart = text.find(':', specStart);
+            if (specStart != std::string::npos) {
+                specStart++;
+            }
+        }
+        if (fields.size() < 4 || specStart == std::string::npos) {
+            NS_FATAL_ERROR("Invalid degradation event '" << text << "': expected set:<server>:<at>:<service-time spec>.");
+        }
+        event.start = timeAt(2, "the switch time");
+        event.serviceTime = text.substr(specStart);
+        CreateServiceTimeDistribution(event.serviceTime); // Validates the spec now rather than mid-run.
+    } else if (event.kind == "slow") {
+        checkFieldCount(4, "slow:<server>:<at>:<factor>");
+        event.start = timeAt(2, "the start time");
+        event.factor = numberAt(3, "the slowdown factor");
+    } else if (event.kind == "ramp") {
+        checkFieldCount(5, "ramp:<server>:<from>:<to>:<factor>");
+        event.start = timeAt(2, "the ramp start");
+        event.end = timeAt(3, "the ramp end");
+        event.factor = numberAt(4, "the slowdown factor");
+    } else if (event.kind == "pause") {
+        checkFieldCount(6, "pause:<server>:<from>:<to>:<every>:<duration>");
+        event.start = timeAt(2, "the first pause");
+        event.end = timeAt(3, "the end of the pauses");
+        event.period = timeAt(4, "the pause interval");
+        event.duration = timeAt(5, "the pause length");
+        if (!event.period.IsStrictlyPositive()) {
+            NS_FATAL_ERROR("Invalid degradation event '" << text << "': the pause interval must be positive.");
+        }
+    } else if (event.kind == "flap") {
+        checkFieldCount(6, "flap:<server>:<from>:<to>:<period>:<factor>");
+        event.start = timeAt(2, "the flapping start");
+        event.end = timeAt(3, "the flapping end");
+        event.period = timeAt(4, "the flapping period");
+        event.factor = numberAt(5, "the slowdown factor");
+        if (!event.period.IsStrictlyPositive()) {
+            NS_FATAL_ERROR("Invalid degradation event '" << text << "': the flapping period must be positive.");
+        }
+    } else if (IsFault(event.kind)) {
+        if (fields.size() != 3 && fields.size() != 4) {
+            NS_FATAL_ERROR("Invalid degradation event '" << text << "': expected " << event.kind
+                           << ":<server>:<at>[:<for>].");
+        }
+        event.start = timeAt(2, "the failure time");
+        if (fields.size() == 4) {
+            event.duration = timeAt(3, "the failure length");
+        }
+        event.end = event.start;
+    } else {
+        NS_FATAL_ERROR("Unknown degradation event '" << event.kind << "' in '" << text
+                       << "'. Supported: set, slow, ramp, pause, flap, stop, reset, hang, down.");
+    }
+    if (event.kind != "set" && event.kind != "slow" && event.end < event.start) {
+        NS_FATAL_ERROR("Invalid degradation event '" << text << "': it ends before it starts.");
+    }
+    m_events.push_back(event);
+}
+
+void
+DegradationScenario::CheckServerCount(uint32_t serverCount) const
+{
+    for (const Event& event : m_events)
+    {
+        if (!event.allServers && event.server >= serverCount) {
+            NS_FATAL_ERROR("Degradation event '" << event.text << "' targets server " << event.server
+                           << ", but there are only " << serverCount << " servers.");
+        }
+    }
+}
+
+void
+DegradationScenario::Install(Ptr<LatencyServerApp> server, uint32_t index) const
+{
+    NS_LOG_FUNCTION(this << server << index);
+    for (const Event& event : m_events)
+    {
+        if (!event.allServers && event.server != index) {
+            continue;
+        }
+        NS_LOG_INFO("Server " << index << ": scheduling degradation '" << event.text << "'");
+
+        if (event.kind == "set") {
+            server->ScheduleServiceTimeDistribution(event.start, CreateServiceTimeDistribution(event.serviceTime));
+        } else if (event.kind == "slow") {
+            ScheduleAt(event.start, &LatencyServerApp::SetSlowdown, server, event.factor);
+        } else if (event.kind == "ramp") {
+            ScheduleAt(event.start, &LatencyServerApp::RampSlowdown, server, event.factor, event.end - event.start);
+        } else if (event.kind == "pause") {
+            for (Time at = event.start; at < event.end; at += event.period)
+            {
+                ScheduleAt(at, &LatencyServerApp::Pause, server, event.duration);
+            }
+        } else if (event.kind == "flap") {
+            for (Time at = event.start; at < event.end; at += event.period)
+            {
+                ScheduleAt(at, &LatencyServerApp::SetSlowdown, server, event.factor);
+                ScheduleAt(std::min(at + NanoSeconds(event.period.GetNanoSeconds() / 2), event.end), &LatencyServerApp::SetSlowdown, server, 1.0);
+            }
+        } else if (event.kind == "stop") {
+            ScheduleAt(event.start, &LatencyServerApp::StopAccepting, server, event.duration);
+        } else if (event.kind == "reset") {
+            ScheduleAt(event.start, &LatencyServerApp::Crash, server, event.duration);
+        } else if (event.kind == "hang") {
+            ScheduleAt(event.start, &LatencyServerApp::Hang, server, event.duration);
+        } else if (event.kind == "down") {
+            ScheduleAt(event.start, &LatencyServerApp::TakeDown, server, event.duration);
+        }
+    }
+}
+
+std::vector<DegradationScenario::Fault>
+DegradationScenario::GetFaults(uint32_t serverCount) const
+{
+    std::vector<Fault> faults;
+    for (const Event& event : m_events)
+    {
+        if (!IsFault(event.kind)) {
+            continue;
+        }
+        for (uint32_t server = 0; server < serverCount; ++server)
+        {
+            if (event.allServers || event.server == server) {
+                faults.push_back(Fault{event.kind, server, event.start, event.duration});
+            }
+        }
+    }
+    return faults;
+}
+
+bool
+DegradationScenario::IsFault(const std::string& kind)
+{
+    return kind == "stop" || kind == "reset" || kind == "hang" || kind == "down";
+}
+
+size_t
+DegradationScenario::GetEventCount() const
+{
+    return m_events.size();
+}
+
+bool
+DegradationScenario::IsEmpty() const
+{
+    return m_events.empty();
+}
+
+} // namespace ns3
@@ -0,0 +1,143 @@
+#ifndef DEGRADATION_SCENARIO_H
+#define DEGRADATION_SCENARIO_H
+
+// NS-3 Includes
+#include "ns3/nstime.h" // For ns3::Time
+#include "ns3/ptr.h"
+
+// Standard Library Includes
+#include <cstddef> // For size_t
+#include <cstdint> // For uint32_t
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class LatencyServerApp;
+
+/**
+ * @brief A schedule of backend faults that change over time.
+ *
+ * A scenario is a list of events, each aimed at one server (by index) or at all of them.
+ * Events are written as ':'-separated fields; several are separated by ';' on the command
+ * line, or given one per line in a file (blank lines and lines starting with '#' are
+ * skipped). Times are ns-3 time strings ("2.5s", "300ms"); bare numbers are seconds.
+ *
+ * - `set:<server>:<at>:<service-time spec>`            Switch to another service-time distribution
+ *                                                       (see CreateServiceTimeDistribution()).
+ * - `slow:<server>:<at>:<factor>`                       Step the slowdown factor (1 restores the server).
+ * - `ramp:<server>:<from>:<to>:<factor>`                Ramp the slowdown factor linearly to @c factor.
+ * - `pause:<server>:<from>:<to>:<every>:<duration>`     Periodic stop-the-world pauses (e.g. GC).
+ * - `flap:<server>:<from>:<to>:<period>:<factor>`       Slowed by @c factor for the first half of
+ *                                                       every period, healthy for the second half.
+ * - `stop:<server>:<at>[:<for>]`                        Stop accepting connections (refused).
+ * - `reset:<server>:<at>[:<for>]`                       Crash: close every connection, lose the
+ *                                                       requests in progress, restart after @c for.
+ * - `hang:<server>:<at>[:<for>]`                        Accept and read requests, never respond.
+ * - `down:<server>:<at>[:<for>]`                        Network interfaces down: peers only notice
+ *                                                       through TCP retransmission timeouts.
+ *
+ * The last four are outright failures (see GetFaults()); without @c for (or with zero)
+ * the server never recovers.
+ *
+ * `<server>` is a server index or `*` for every server. Malformed events terminate the
+ * simulation with NS_FATAL_ERROR.
+ */
+class DegradationScenario
+{
+  public:
+    /**
+     * @brief One outright failure of one server, for reporting.
+     */
+    struct Fault
+    {
+        std::string kind; //!< stop, reset, hang or down.
+        uint32_t server;  //!< Index of the failed server.
+        Time start;       //!< When the failure starts.
+        Time duration;    //!< How long it lasts (zero = until the end of the simulation).
+    };
+
+    DegradationScenario();
+
+    /**
+     * @brief Parses and appends the events of a ';'-separated spec.
+     * @param spec The events (an empty spec adds none).
+     */
+    void AddEvents(const std::string& spec);
+
+    /**
+     * @brief Parses and appends the events of a scenario file, one per line.
+     * @param path Path of the scenario file.
+     */
+    void LoadFile(const std::string& path);
+
+    /**
+     * @brief Aborts the simulation if an event targets a server that does not exist.
+     * @param serverCount Number of servers in the simulation.
+     */
+    void CheckServerCount(uint32_t serverCount) const;
+
+    /**
+     * @brief Schedules the events aimed at one server. Must be called before the server's
+     * RNG streams are assigned, since `set` events add random variables to it.
+     * @param server The server application.
+     * @param index The server's index.
+     */
+    void Install(Ptr<LatencyServerApp> server, uint32_t index) const;
+
+    /**
+     * @brief Lists the outright failures (stop, reset, hang, down), one per affected server.
+     * @param serverCount Number of servers, to expand events aimed at every server.
+     * @return The failures in the order they were added.
+     */
+    std::vector<Fault> GetFaults(uint32_t serverCount) const;
+
+    /**
+     * @brief Gets the number of events in the scenario.
+     * @return The event count.
+     */
+    size_t GetEventCount() const;
+
+    /**
+     * @brief Checks whether the scenario has no events.
+     * @return True if there are no events.
+     */
+    bool IsEmpty() const;
+
+  private:
+    /**
+     * @brief One scheduled fault.
+     */
+    struct Event
+    {
+        std::string kind;        //!< set, slow, ramp, pause, flap, stop, reset, hang or down.
+        std::string text;        //!< The event as written, for logs.
+        bool allServers;         //!< Aimed at every server.
+        uint32_t server;         //!< Server index when not aimed at every server.
+        Time start;              //!< When the event starts.
+        Time end;                //!< When it ends (ramp, pause, flap).
+        Time period;             //!< Pause interval or flap period.
+        Time duration;           //!< Pause length, or how long a failure lasts.
+        double factor;           //!< Slowdown factor (slow, ramp, flap).
+        std::string serviceTime; //!< Service-time spec (set).
+    };
+
+    /**
+     * @brief Parses one event and appends it.
+     * @param text The event's fields.
+     */
+    void AddEvent(const std::string& text);
+
+    /**
+     * @brief Checks whether an event kind is an outright failure.
+     * @param kind The event kind.
+     * @return True for stop, reset, hang and down.
+     */
+    static bool IsFault(const std::string& kind);
+
+    std::vector<Event> m_events; //!< Events in the order they were added.
+};
+
+} // namespace ns3
+
+#endif // DEGRADATION_SCENARIO_H
@@ -0,0 +1,171 @@
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+// Custom modules
+#include "ns3/request_response_header.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace ns3 {
+
+namespace { // Anonymous namespace for internal linkage helpers
+
+/**
+ * @brief The fixed-layout header used before the TLV extensions, kept as the baseline.
+ */
+struct FixedHeader
+{
+    static constexpr uint32_t SIZE = 37; //!< seq, timestamp, payload, L7 id, hint, response size, status.
+
+    uint32_t seq = 0;
+    int64_t timestampNs = 0;
+    uint32_t payloadSize = 0;
+    uint64_t l7Identifier = 0;
+    int64_t serviceTimeHintNs = 0;
+    uint32_t responseSize = 0;
+    uint8_t status = 0;
+
+    void Serialize(Buffer::Iterator start) const
+    {
+        start.WriteHtonU32(seq);
+        start.WriteHtonU64(timestampNs);
+        start.WriteHtonU32(payloadSize);
+        start.WriteHtonU64(l7Identifier);
+        start.WriteHtonU64(serviceTimeHintNs);
+        start.WriteHtonU32(responseSize);
+        start.WriteU8(status);
+    }
+
+    void Deserialize(Buffer::Iterator start)
+    {
+        seq = start.ReadNtohU32();
+        timestampNs = static_cast<int64_t>(start.ReadNtohU64());
+        payloadSize = start.ReadNtohU32();
+        l7Identifier = start.ReadNtohU64();
+        serviceTimeHintNs = static_cast<int64_t>(start.ReadNtohU64());
+        responseSize = start.ReadNtohU32();
+        status = start.ReadU8();
+    }
+};
+
+// Times iterations of a step and returns the mean cost in nanoseconds.
+template <typename Step>
+double MeasureNs(uint32_t iterations, Step step)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        step(i);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+}
+
+void PrintRow(const std::string& name, uint32_t bytes, double encodeNs, double prefixNs, double fullNs)
+{
+    std::cout << std::left << std::setw(28) << name << std::right << std::setw(6) << bytes << std::fixed
+              << std::setprecision(1) << std::setw(12) << encodeNs << std::setw(14) << prefixNs << std::setw(12)
+              << fullNs << std::endl;
+}
+
+} // namespace
+
+/**
+ * Measures the per-message encode and decode cost of RequestResponseHeader against the
+ * fixed-layout header it replaced. "Prefix decode" is what a hop that only routes pays
+ * (sequence number and L7 identifier), such as the load balancer with DeadlineAware off;
+ * "full decode" also reads the extensions, as endpoints and a deadline-aware LB do.
+ */
+int MeasureHeaderCost(int argc, char* argv[])
+{
+    uint32_t iterations = 1000000;
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("iterations", "Messages encoded and decoded per measurement", iterations);
+    cmd.Parse(argc, argv);
+    if (iterations == 0) {
+        NS_FATAL_ERROR("iterations must be positive.");
+    }
+
+    Buffer buffer;
+    buffer.AddAtStart(RequestResponseHeader::PREFIX_SIZE + RequestResponseHeader::MAX_EXTENSION_SIZE);
+    volatile uint64_t sink = 0; // Keeps the decoded values alive.
+
+    std::cout << std::left << std::setw(28) << "Header" << std::right << std::setw(6) << "Bytes" << std::setw(12)
+              << "Encode ns" << std::setw(14) << "Prefix dec ns" << std::setw(12) << "Full dec ns" << std::endl;
+
+    // Baseline: every field is always on the wire and always parsed.
+    {
+        FixedHeader header;
+        header.payloadSize = 100;
+        header.l7Identifier = 42;
+        header.responseSize = 100;
+        const double encodeNs = MeasureNs(iterations, [&](uint32_t i) {
+            header.seq = i;
+            header.Serialize(buffer.Begin());
+        });
+        const double decodeNs = MeasureNs(iterations, [&](uint32_t) {
+            FixedHeader decoded;
+            decoded.Deserialize(buffer.Begin());
+            sink = sink + decoded.seq + decoded.l7Identifier + decoded.responseSize + decoded.status;
+        });
+        PrintRow("Fixed (previous)", FixedHeader::SIZE, encodeNs, decodeNs, decodeNs);
+    }
+
+    // Extensible header, for messages carrying progressively more extensions.
+    struct Shape
+    {
+        std::string name;
+        bool response;
+        bool everything;
+    };
+    const Shape shapes[] = {{"TLV request", false, false},
+                            {"TLV rejected response", true, false},
+                            {"TLV all extensions", true, true}};
+    for (const Shape& shape : shapes)
+    {
+        RequestResponseHeader header;
+        header.SetPayloadSize(100);
+        header.SetL7Identifier(42);
+        header.SetResponseSize(100);
+        if (shape.response) {
+            header.SetStatus(RequestResponseHeader::STATUS_REJECTED);
+        }
+        if (shape.everything) {
+            header.SetServiceTimeHint(MicroSeconds(500));
+            header.SetPriority(1);
+            header.SetDeadline(MilliSeconds(250));
+            header.SetLoadReport(RequestResponseHeader::LoadReport{8, 0.5});
+            header.SetTraceId(7);
+            header.SetSessionKey(9);
+        }
+        const double encodeNs = MeasureNs(iterations, [&](uint32_t i) {
+            header.SetSeq(i);
+            header.Serialize(buffer.Begin());
+        });
+        const double prefixNs = MeasureNs(iterations, [&](uint32_t) {
+            RequestResponseHeader decoded;
+            decoded.Deserialize(buffer.Begin());
+            sink = sink + decoded.GetSeq() + decoded.GetL7Identifier();
+        });
+        const double fullNs = MeasureNs(iterations, [&](uint32_t) {
+            RequestResponseHeader decoded;
+            decoded.Deserialize(buffer.Begin());
+            sink = sink + decoded.GetSeq() + decoded.GetL7Identifier() + decoded.GetResponseSize()
+                   + decoded.GetStatus();
+        });
+        PrintRow(shape.name, header.GetSerializedSize(), encodeNs, prefixNs, fullNs);
+    }
+    return 0;
+}
+
+} // namespace ns3
+
+int main(int argc, char* argv[])
+{
+    ns3::Time::SetResolution(ns3::Time::NS);
+    return ns3::MeasureHeaderCost(argc, argv);
+}
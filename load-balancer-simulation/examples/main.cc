@@ -16,6 +16,13 @@
 #include "ns3/ring_hash_load_balancer.h"
 #include "ns3/maglev_load_balancer.h"
 #include "ns3/peak_ewma_load_balancer.h"
+#include "ns3/arrival_process.h"
+#include "ns3/key_generator.h"
+#include "ns3/size_distribution.h"
+#include "ns3/service_time_distribution.h"
+#include "ns3/degradation_scenario.h"
+#include "ns3/latency_histogram.h"
+#include "ns3/latency_time_series.h"
 #include "ns3/latency_client_app.h"
 #include "ns3/latency_server_app.h"
 #include "ns3/request_response_header.h"
@@ -24,9 +31,9 @@
 #include <charconv>
 #include <cmath>
 #include <cstdint>
+#include <fstream>
 #include <iomanip>
 #include <memory>
-#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -39,9 +46,20 @@ NS_LOG_COMPONENT_DEFINE("LoadBalancerSimulationMain");
 namespace { // Anonymous namespace for internal linkage helpers
 
 constexpr uint32_t kDefaultWeight = 1;
-constexpr double kDefaultDelayMs = 0.0;
+const std::string kDefaultDelaySpec = "0";
 constexpr double kDefaultClientStartTimeStaggerS = 0.001; // Stagger to avoid all clients starting simultaneously
 
+/**
+ * @brief What the balancers did while one server was failed.
+ */
+struct FaultObservation
+{
+    uint64_t routedBefore = 0; //!< Requests routed to the server before the failure.
+    uint64_t routedDuring = 0; //!< Requests routed to it while it was failed.
+    Time lastRouted;           //!< Time of the last request routed to it while failed.
+    bool ended = false;        //!< True once the failure ended (or the simulation stopped).
+};
+
 // Helper to trim whitespace from both ends of a string segment.
 // Modifies the input string.
 void TrimWhitespace(std::string& s)
@@ -83,6 +101,51 @@ std::string FormatDouble(double val, int precision = 4)
     return oss.str();
 }
 
+// Logs the summary statistics and percentiles of a latency histogram
+void LogLatencySummary(const LatencyHistogram& latencies)
+{
+    NS_LOG_INFO("Min Latency:    " << FormatTimeMs(latencies.GetMin()) << " ms");
+    NS_LOG_INFO("Avg Latency:    " << FormatDouble(latencies.GetMeanMs()) << " ms");
+    NS_LOG_INFO("P50 Latency:    " << FormatTimeMs(latencies.GetPercentile(0.50)) << " ms");
+    NS_LOG_INFO("P75 Latency:    " << FormatTimeMs(latencies.GetPercentile(0.75)) << " ms");
+    NS_LOG_INFO("P90 Latency:    " << FormatTimeMs(latencies.GetPercentile(0.90)) << " ms");
+    NS_LOG_INFO("P95 Latency:    " << FormatTimeMs(latencies.GetPercentile(0.95)) << " ms");
+    NS_LOG_INFO("P99 Latency:    " << FormatTimeMs(latencies.GetPercentile(0.99)) << " ms");
+    NS_LOG_INFO("Max Latency:    " << FormatTimeMs(latencies.GetMax()) << " ms");
+    NS_LOG_INFO("Std Dev:        " << FormatDouble(latencies.GetStdDevMs()) << " ms");
+}
+
+// Writes the merged time series as CSV, one row per window (empty windows included)
+void WriteTimeSeriesCsv(const LatencyTimeSeries& series, const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out) {
+        NS_LOG_WARN("Cannot open time series file '" << path << "' for writing.");
+        return;
+    }
+    const double windowS = series.GetWindowLength().GetSeconds();
+    out << "window_start_s,responses,rps,rx_mbytes_per_s,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n";
+    for (size_t i = 0; i < series.GetWindowCount(); ++i)
+    {
+        const LatencyHistogram* latencies = series.GetLatencies(i);
+        const uint64_t responses = latencies ? latencies->GetCount() : 0;
+        out << FormatDouble(series.GetWindowStart(i).GetSeconds()) << ','
+            << responses << ','
+            << FormatDouble(static_cast<double>(responses) / windowS, 2) << ','
+            << FormatDouble(static_cast<double>(series.GetBytes(i)) / windowS / 1e6) << ',';
+        if (latencies) {
+            out << FormatDouble(latencies->GetMeanMs()) << ','
+                << FormatDouble(latencies->GetPercentile(0.50).GetSeconds() * 1e3) << ','
+                << FormatDouble(latencies->GetPercentile(0.90).GetSeconds() * 1e3) << ','
+                << FormatDouble(latencies->GetPercentile(0.99).GetSeconds() * 1e3) << ','
+                << FormatDouble(latencies->GetMax().GetSeconds() * 1e3) << '\n';
+        } else {
+            out << ",,,,\n";
+        }
+    }
+    NS_LOG_INFO("Time series (" << series.GetWindowCount() << " windows of " << windowS * 1000 << " ms) written to '"
+                  << path << "'");
+}
 
 } // namespace
 
@@ -117,9 +180,11 @@ std::vector<uint32_t> ParseWeights(const std::string& weightsStr)
     return weights;
 }
 
-std::vector<double> ParseDelays(const std::string& delaysStr)
+// Splits the comma-separated per-server service-time specs. Each spec is validated when
+// CreateServiceTimeDistribution() builds it.
+std::vector<std::string> ParseDelaySpecs(const std::string& delaysStr)
 {
-    std::vector<double> delays;
+    std::vector<std::string> specs;
     std::stringstream ss(delaysStr);
     std::string segment;
 
@@ -128,61 +193,56 @@ std::vector<double> ParseDelays(const std::string& delaysStr)
         TrimWhitespace(segment);
         if (segment.empty())
         {
-            NS_LOG_WARN("Empty delay segment. Using default delay: " << kDefaultDelayMs << "ms");
-            delays.push_back(kDefaultDelayMs);
+            NS_LOG_WARN("Empty delay segment. Using default delay: " << kDefaultDelaySpec << "ms");
+            specs.push_back(kDefaultDelaySpec);
             continue;
         }
-
-        double delay;
-        auto [ptr, ec] = std::from_chars(segment.data(), segment.data() + segment.size(), delay);
-        if (ec == std::errc() && ptr == segment.data() + segment.size() && delay >= 0.0)
-        {
-            delays.push_back(delay);
-        }
-        else
-        {
-            NS_LOG_WARN("Invalid delay segment: '" << segment << "'. Using default delay: " << kDefaultDelayMs << "ms");
-            delays.push_back(kDefaultDelayMs);
-        }
+        specs.push_back(segment);
     }
-    return delays;
+    return specs;
 }
 
-Time CalculatePercentile(std::vector<Time>& sortedData, double percentile)
+// Parses a comma-separated list of downstream tier sizes (e.g., "4,2"); aborts on a malformed entry.
+std::vector<uint32_t> ParseTierSizes(const std::string& tiersStr)
 {
-    if (sortedData.empty() || percentile < 0.0 || percentile > 1.0)
+    std::vector<uint32_t> sizes;
+    for (const std::string& field : SplitSpec(tiersStr, ','))
     {
-        NS_LOG_WARN("Invalid input for CalculatePercentile: empty data or percentile out of [0,1] range. Percentile: " << percentile);
-        return Seconds(0.0);
-    }
-
-    const double n = static_cast<double>(sortedData.size());
-    if (n == 1.0) { 
-        return sortedData[0];
-    }
-
-    const double h = (n - 1.0) * percentile;
-    const size_t lowerIdx = static_cast<size_t>(std::floor(h));
-    size_t upperIdx = static_cast<size_t>(std::ceil(h));
-
-    if (upperIdx >= sortedData.size()) {
-        upperIdx = sortedData.size() - 1;
+        double size = 0.0;
+        if (!ParseSpecNumber(field, size) || size < 1.0 || size != static_cast<uint32_t>(size)) {
+            NS_FATAL_ERROR("Invalid tiers entry '" << field << "': expected a positive server count.");
+        }
+        sizes.push_back(static_cast<uint32_t>(size));
     }
+    return sizes;
+}
 
-    const Time lowerVal = sortedData[lowerIdx];
-    const Time upperVal = sortedData[upperIdx];
-
-    if (lowerIdx == upperIdx) 
-    {
-        return lowerVal;
+// Sets the TypeId of a load balancer factory from an algorithm name; false if unknown.
+bool SetLoadBalancerType(ObjectFactory& factory, const std::string& algorithm)
+{
+    if (algorithm == "WRR") {
+        factory.SetTypeId(WeightedRoundRobinLoadBalancer::GetTypeId());
+    } else if (algorithm == "LR") {
+        factory.SetTypeId(LeastRequestLoadBalancer::GetTypeId());
+    } else if (algorithm == "Random") {
+        factory.SetTypeId(RandomLoadBalancer::GetTypeId());
+    } else if (algorithm == "RingHash") {
+        factory.SetTypeId(RingHashLoadBalancer::GetTypeId());
+    } else if (algorithm == "Maglev") {
+        factory.SetTypeId(MaglevLoadBalancer::GetTypeId());
+    } else if (algorithm == "PeakEWMA") {
+        factory.SetTypeId(PeakEwmaLoadBalancer::GetTypeId());
+    } else {
+        return false;
     }
+    return true;
+}
 
-    const double fraction = h - static_cast<double>(lowerIdx);
-    const int64_t lowerNs = lowerVal.GetNanoSeconds();
-    const int64_t upperNs = upperVal.GetNanoSeconds();
-    const int64_t interpolatedNs = static_cast<int64_t>(std::round(static_cast<double>(lowerNs) + fraction * (static_cast<double>(upperNs) - static_cast<double>(lowerNs))));
-
-    return NanoSeconds(interpolatedNs);
+// Formats a service-time spec for logs: bare numbers get their unit, distributions stay as given.
+std::string FormatDelaySpec(const std::string& spec)
+{
+    double ms = 0.0;
+    return ParseSpecNumber(spec, ms) ? spec + "ms" : spec;
 }
 
 
@@ -198,10 +258,55 @@ int MainSimulation(int argc, char* argv[])
     std::string lbVipAddressStr = "192.168.1.1";
     std::string serverWeightsStr = "1,1,1,1,1,1,1,1,1,1";
     std::string lbAlgorithm = "PeakEWMA"; 
+    std::string lbMode = "central";
     uint32_t clientRequestCount = 100;
     double clientRequestIntervalS = 0.1;
     uint32_t clientRequestSizeBytes = 100;
+    std::string clientArrivalSpec = "fixed";
+    std::string clientKeySpec = "uniform";
+    std::string clientRequestSizeSpec;
+    std::string clientResponseSizeSpec = "0";
+    uint32_t clientConcurrency = 0;
+    uint32_t clientFanOut = 1;
+    uint32_t clientFanOutQuorum = 0;
+    std::string clientThinkTime = "ns3::ConstantRandomVariable[Constant=0.0]";
+    std::string traceFile;
+    uint32_t histogramPrecision = 3;
+    double histogramHighestMs = 60000.0;
+    double timeSeriesWindowMs = 0.0;
+    std::string timeSeriesFile;
+    double convergeAfterS = -1.0;
+    double convergeQuantile = 0.9;
+    double convergeTolerance = 0.2;
+    uint32_t clientConnections = 1;
+    std::string clientConnSpreading = "RoundRobin";
+    double clientTimeoutMs = 0.0;
+    double clientSloMs = 0.0;
+    double clientDeadlineMs = 0.0;
     std::string serverDelaysStr = "5,5,5,5,5,5,5,5,5,50";
+    uint32_t serverWorkers = 0;
+    uint32_t serverQueueLimit = 0;
+    std::string serverQueueDiscipline = "FIFO";
+    std::string serverModel = "WorkerPool";
+    std::string serverAdmission = "None";
+    uint32_t serverAdmissionQueue = 16;
+    double serverAdmissionTargetMs = 100.0;
+    std::string serverCache = "None";
+    uint32_t serverCacheSize = 1000;
+    double serverCacheHitMs = 1.0;
+    std::string lbRejection = "Failure";
+    uint32_t lbRetries = 0;
+    double lbTimeoutMs = 0.0;
+    bool lbDeadlineAware = true;
+    std::string degradeSpec;
+    std::string degradeFile;
+    std::string tiersStr;
+    std::string tierDelaysStr = "5";
+    uint32_t tierCalls = 1;
+    std::string tierMode = "Sequential";
+    std::string tierAlgorithm;
+    uint32_t rngSeed = 1;
+    uint64_t rngRun = 1;
 
     // Command Line Argument Parsing
     CommandLine cmd(__FILE__);
@@ -211,19 +316,145 @@ int MainSimulation(int argc, char* argv[])
     cmd.AddValue("vip", "Load Balancer Virtual IP Address", lbVipAddressStr);
     cmd.AddValue("weights", "Comma-separated list of server weights (e.g., '2,1,1')", serverWeightsStr);
     cmd.AddValue("lbAlgorithm", "Load balancing algorithm (WRR, LR, Random, RingHash, Maglev, PeakEWMA)", lbAlgorithm);
+    cmd.AddValue("lbMode", "Where balancing happens: central (one LB node proxies all clients) or sidecar "
+                 "(each client runs its own picker and connects to the servers directly)", lbMode);
     cmd.AddValue("reqCount", "Number of requests per client (0 for continuous)", clientRequestCount);
     cmd.AddValue("reqInterval", "Interval between client requests (seconds)", clientRequestIntervalS);
     cmd.AddValue("reqSize", "Payload size of client requests (bytes)", clientRequestSizeBytes);
-    cmd.AddValue("serverDelays", "Comma-separated list of server processing delays (milliseconds, e.g., '0,10,10')", serverDelaysStr);
+    cmd.AddValue("reqSizes", "Request payload size distribution (overrides reqSize): <bytes>, "
+                 "lognormal:medianBytes:sigma[:maxBytes], empirical:<cdf file>", clientRequestSizeSpec);
+    cmd.AddValue("respSizes", "Response payload size distribution, same forms as reqSizes (default 0 bytes)",
+                 clientResponseSizeSpec);
+    cmd.AddValue("arrival", "Client inter-arrival process: fixed, poisson, pareto[:shape], "
+                 "onoff:onMs:offMs[:offRateFraction], ramp:startFactor:endFactor:durationS "
+                 "(mean/base interval is reqInterval)", clientArrivalSpec);
+    cmd.AddValue("keys", "Client L7 id popularity: uniform (unique random ids), uniform:keys, "
+                 "zipf:keys[:exponent] (keys are shared by all clients)", clientKeySpec);
+    cmd.AddValue("concurrency", "Closed-loop mode: requests each client keeps outstanding (0 = open loop)", clientConcurrency);
+    cmd.AddValue("fanOut", "Sub-requests per logical scatter-gather request (1 = no fan-out)", clientFanOut);
+    cmd.AddValue("fanOutQuorum", "Sub-responses that complete a logical request (0 = all)", clientFanOutQuorum);
+    cmd.AddValue("thinkTime", "Closed-loop think time as an ns-3 random variable in seconds "
+                 "(e.g., 'ns3::ExponentialRandomVariable[Mean=0.005]')", clientThinkTime);
+    cmd.AddValue("trace", "Binary request trace to replay; sharded across clients by record index "
+                 "(overrides reqSize, and arrival/reqInterval in open-loop mode). Each client still stops "
+                 "after reqCount requests; set reqCount=0 to replay its whole shard", traceFile);
+    cmd.AddValue("connections", "Parallel TCP connections per client", clientConnections);
+    cmd.AddValue("connSpreading", "How clients spread requests over their connections (RoundRobin, LeastOutstanding)", clientConnSpreading);
+    cmd.AddValue("timeout", "Client request timeout in milliseconds (0 = never time out)", clientTimeoutMs);
+    cmd.AddValue("slo", "Latency objective in milliseconds for goodput (0 = any response before the timeout)", clientSloMs);
+    cmd.AddValue("deadlineMs", "Time budget in milliseconds of each request, carried in its header as an absolute "
+                 "deadline that the LB and servers enforce (0 = no deadlines)", clientDeadlineMs);
+    cmd.AddValue("histPrecision", "Significant digits kept by the client latency histograms (1-5)", histogramPrecision);
+    cmd.AddValue("histHighestMs", "Largest latency in milliseconds tracked at full precision by the client and "
+                 "merged latency histograms", histogramHighestMs);
+    cmd.AddValue("tsWindow", "Window of the latency/throughput time series in milliseconds (0 = off)", timeSeriesWindowMs);
+    cmd.AddValue("tsFile", "CSV file to write the time series to (requires tsWindow)", timeSeriesFile);
+    cmd.AddValue("convergeAfter", "Start of the transient whose convergence time is reported, in seconds "
+                 "(default: client start)", convergeAfterS);
+    cmd.AddValue("convergeQuantile", "Latency quantile tracked for convergence (e.g., 0.9)", convergeQuantile);
+    cmd.AddValue("convergeTol", "Relative excess over the steady-state quantile still counted as converged", convergeTolerance);
+    cmd.AddValue("serverDelays", "Comma-separated list of per-server service times in milliseconds: a constant or "
+                 "exp:mean, lognorm:median:sigma[:bound], bimodal:fast:slow:slowFraction, pareto:min:shape[:bound], "
+                 "empirical:file (e.g., '5,exp:5,lognorm:5:1.2')", serverDelaysStr);
+    cmd.AddValue("serverWorkers", "Requests each server serves concurrently; the rest queue (0 = unlimited)", serverWorkers);
+    cmd.AddValue("serverQueue", "Waiting requests beyond which a server drops new ones (0 = unbounded)", serverQueueLimit);
+    cmd.AddValue("serverQueueDiscipline", "Order in which servers serve waiting requests (FIFO, LIFO, ShortestFirst)",
+                 serverQueueDiscipline);
+    cmd.AddValue("serverModel", "How servers share their workers: WorkerPool (queue for a free worker) or "
+                 "ProcessorSharing (serverWorkers cores shared equally by all requests)", serverModel);
+    cmd.AddValue("serverAdmission", "When servers reject requests at once instead of serving them: None, "
+                 "QueueLength (serverAdmissionQueue waiting) or LatencyTarget (predicted latency above "
+                 "serverAdmissionTargetMs)", serverAdmission);
+    cmd.AddValue("serverAdmissionQueue", "Waiting requests at which QueueLength admission rejects", serverAdmissionQueue);
+    cmd.AddValue("serverAdmissionTargetMs", "Predicted latency in milliseconds above which LatencyTarget admission rejects",
+                 serverAdmissionTargetMs);
+    cmd.AddValue("serverCache", "Cache of request keys on each server: None, LRU or ARC", serverCache);
+    cmd.AddValue("serverCacheSize", "Keys each server's cache holds", serverCacheSize);
+    cmd.AddValue("serverCacheHitMs", "Service time in milliseconds of a request whose key is cached", serverCacheHitMs);
+    cmd.AddValue("lbRejection", "How rejections are fed to the algorithm: Failure (PeakEWMA records a penalty) or "
+                 "Latency (recorded as fast responses)", lbRejection);
+    cmd.AddValue("lbRetries", "Times the central LB retries a rejected or failed request on a newly chosen backend", lbRetries);
+    cmd.AddValue("lbTimeoutMs", "Time in milliseconds a backend has to answer the central LB before the request "
+                 "is failed, retried or counted as lost (0 = no LB timeout)", lbTimeoutMs);
+    cmd.AddValue("lbDeadlineAware", "Whether the central LB fails a request at once when the chosen backend's "
+                 "latency estimate overruns its deadline", lbDeadlineAware);
+    cmd.AddValue("degrade", "';'-separated server degradation events, e.g. 'slow:9:5s:10;pause:*:2s:12s:1s:50ms' "
+                 "(kinds: set, slow, ramp, pause, flap, stop, reset, hang, down)", degradeSpec);
+    cmd.AddValue("degradeFile", "File of server degradation events, one per line", degradeFile);
+    cmd.AddValue("tiers", "Comma-separated server counts of the downstream tiers, e.g. '4' for a two-tier or "
+                 "'4,2' for a three-tier service graph (empty = servers answer directly)", tiersStr);
+    cmd.AddValue("tierDelays", "Comma-separated service-time spec per downstream tier (same syntax as serverDelays; "
+                 "the last one repeats)", tierDelaysStr);
+    cmd.AddValue("tierCalls", "Calls each mid-tier server makes to the next tier per request", tierCalls);
+    cmd.AddValue("tierMode", "How a mid-tier server makes its calls: Sequential or Parallel", tierMode);
+    cmd.AddValue("tierAlgorithm", "Algorithm of the pickers embedded in mid-tier servers (default: lbAlgorithm)",
+                 tierAlgorithm);
+    cmd.AddValue("seed", "RNG seed; keep it fixed and vary only lbAlgorithm for paired comparisons", rngSeed);
+    cmd.AddValue("run", "RNG run number; change it to draw an independent replication", rngRun);
     cmd.Parse(argc, argv);
 
+    // Must precede the creation of any random variable so every stream uses this seed/run.
+    RngSeedManager::SetSeed(rngSeed);
+    RngSeedManager::SetRun(rngRun);
+
+    if (lbMode != "central" && lbMode != "sidecar") {
+        NS_FATAL_ERROR("Invalid lbMode: " << lbMode << ". Supported: central, sidecar.");
+    }
+    const bool sidecar = (lbMode == "sidecar");
+
+    if (serverModel != "WorkerPool" && serverModel != "ProcessorSharing") {
+        NS_FATAL_ERROR("Invalid serverModel: " << serverModel << ". Supported: WorkerPool, ProcessorSharing.");
+    }
+    if (serverModel == "ProcessorSharing" && serverWorkers == 0) {
+        NS_FATAL_ERROR("serverModel=ProcessorSharing needs serverWorkers > 0 (the cores each server shares).");
+    }
+    if (serverAdmission != "None" && serverAdmission != "QueueLength" && serverAdmission != "LatencyTarget") {
+        NS_FATAL_ERROR("Invalid serverAdmission: " << serverAdmission << ". Supported: None, QueueLength, LatencyTarget.");
+    }
+    if (serverCache != "None" && serverCache != "LRU" && serverCache != "ARC") {
+        NS_FATAL_ERROR("Invalid serverCache: " << serverCache << ". Supported: None, LRU, ARC.");
+    }
+    if (serverCache != "None" && (serverCacheSize == 0 || serverCacheHitMs < 0.0)) {
+        NS_FATAL_ERROR("serverCacheSize must be positive and serverCacheHitMs non-negative.");
+    }
+    if (lbTimeoutMs < 0.0) {
+        NS_FATAL_ERROR("lbTimeoutMs must be non-negative.");
+    }
+    if (histogramHighestMs <= 0.0) {
+        NS_FATAL_ERROR("histHighestMs must be positive.");
+    }
+    if (clientDeadlineMs < 0.0) {
+        NS_FATAL_ERROR("deadlineMs must be non-negative.");
+    }
+    if (lbRejection != "Failure" && lbRejection != "Latency") {
+        NS_FATAL_ERROR("Invalid lbRejection: " << lbRejection << ". Supported: Failure, Latency.");
+    }
+    if (tierMode != "Sequential" && tierMode != "Parallel") {
+        NS_FATAL_ERROR("Invalid tierMode: " << tierMode << ". Supported: Sequential, Parallel.");
+    }
+    if (tierAlgorithm.empty()) {
+        tierAlgorithm = lbAlgorithm;
+    }
+    const std::vector<uint32_t> tierSizes = ParseTierSizes(tiersStr);
+    std::vector<std::string> tierDelaySpecs = ParseDelaySpecs(tierDelaysStr);
+    if (tierDelaySpecs.empty()) {
+        tierDelaySpecs.push_back(kDefaultDelaySpec);
+    }
+    tierDelaySpecs.resize(std::max<size_t>(tierSizes.size(), 1), tierDelaySpecs.back());
+    if (sidecar && lbRetries > 0) {
+        NS_LOG_WARN("lbRetries only applies to the central LB; sidecar clients report rejections without retrying.");
+    }
+    if (sidecar && lbTimeoutMs > 0.0) {
+        NS_LOG_WARN("lbTimeoutMs only applies to the central LB; sidecar clients rely on their own timeout.");
+    }
+
     if (numServers == 0 && lbAlgorithm != "None") { 
         NS_LOG_WARN("Number of servers is 0. Load balancer may not function as expected depending on algorithm.");
     }
 
     const Time clientRequestInterval = Seconds(clientRequestIntervalS);
     std::vector<uint32_t> serverWeights = ParseWeights(serverWeightsStr);
-    std::vector<double> serverDelaysMs = ParseDelays(serverDelaysStr);
+    std::vector<std::string> serverDelaySpecs = ParseDelaySpecs(serverDelaysStr);
 
     // Adjust weights vector size to match numServers
     if (serverWeights.size() < numServers) {
@@ -237,16 +468,23 @@ int MainSimulation(int argc, char* argv[])
     }
 
     // Adjust delays vector size to match numServers
-    if (serverDelaysMs.size() < numServers) {
-        NS_LOG_WARN("Delays count (" << serverDelaysMs.size() << ") < numServers (" << numServers
-                      << "). Assigning default delay (" << kDefaultDelayMs << "ms) to remaining servers.");
-        serverDelaysMs.resize(numServers, kDefaultDelayMs);
-    } else if (serverDelaysMs.size() > numServers) {
-        NS_LOG_WARN("Delays count (" << serverDelaysMs.size() << ") > numServers (" << numServers
+    if (serverDelaySpecs.size() < numServers) {
+        NS_LOG_WARN("Delays count (" << serverDelaySpecs.size() << ") < numServers (" << numServers
+                      << "). Assigning default delay (" << kDefaultDelaySpec << "ms) to remaining servers.");
+        serverDelaySpecs.resize(numServers, kDefaultDelaySpec);
+    } else if (serverDelaySpecs.size() > numServers) {
+        NS_LOG_WARN("Delays count (" << serverDelaySpecs.size() << ") > numServers (" << numServers
                       << "). Ignoring extra delays.");
-        serverDelaysMs.resize(numServers);
+        serverDelaySpecs.resize(numServers);
     }
 
+    DegradationScenario degradation;
+    degradation.AddEvents(degradeSpec);
+    if (!degradeFile.empty()) {
+        degradation.LoadFile(degradeFile);
+    }
+    degradation.CheckServerCount(numServers);
+
     // Logging Configuration
     LogComponentEnable("LoadBalancerSimulationMain", LOG_LEVEL_INFO);
     LogComponentEnable("SimulationUtils", LOG_LEVEL_WARN); 
@@ -259,18 +497,85 @@ int MainSimulation(int argc, char* argv[])
     LogComponentEnable("MaglevLoadBalancer", LOG_LEVEL_WARN);
     LogComponentEnable("PeakEwmaLoadBalancer", LOG_LEVEL_INFO);
     LogComponentEnable("LatencyClientApp", LOG_LEVEL_INFO);
+    LogComponentEnable("ArrivalProcess", LOG_LEVEL_WARN);
+    LogComponentEnable("KeyGenerator", LOG_LEVEL_WARN);
+    LogComponentEnable("SizeDistribution", LOG_LEVEL_WARN);
+    LogComponentEnable("ServiceTimeDistribution", LOG_LEVEL_WARN);
+    LogComponentEnable("DegradationScenario", LOG_LEVEL_INFO);
+    LogComponentEnable("TraceReader", LOG_LEVEL_WARN);
+    LogComponentEnable("LatencyHistogram", LOG_LEVEL_WARN);
+    LogComponentEnable("LatencyTimeSeries", LOG_LEVEL_WARN);
     LogComponentEnable("LatencyServerApp", LOG_LEVEL_WARN);
     LogComponentEnable("RequestResponseHeader", LOG_LEVEL_WARN);
 
     // Simulation Setup Information
     NS_LOG_INFO("--- NS-3 Load Balancer Simulation (Latency Measurement) ---");
-    NS_LOG_INFO("Configuration: " << numClients << " Clients, " << numServers << " Servers, LB Algo: " << lbAlgorithm);
+    NS_LOG_INFO("Configuration: " << numClients << " Clients, " << numServers << " Servers, LB Algo: " << lbAlgorithm
+                  << " (" << lbMode << ")");
     NS_LOG_INFO("Server Weights: " << FormatVectorContents(serverWeights));
-    NS_LOG_INFO("Server Delays (ms): " << FormatVectorContents(serverDelaysMs));
+    NS_LOG_INFO("Server Delays (ms): " << FormatVectorContents(serverDelaySpecs));
+    if (serverModel == "ProcessorSharing") {
+        NS_LOG_INFO("Server Cores: " << serverWorkers << " per server, processor sharing with "
+                      << (serverQueueLimit == 0 ? std::string("unbounded") : std::to_string(serverQueueLimit))
+                      << " extra requests");
+    } else if (serverWorkers > 0) {
+        NS_LOG_INFO("Server Workers: " << serverWorkers << " per server, " << serverQueueDiscipline << " queue of "
+                      << (serverQueueLimit == 0 ? std::string("unbounded") : std::to_string(serverQueueLimit)) << " length");
+    }
+    if (serverAdmission != "None") {
+        NS_LOG_INFO("Server Admission: " << serverAdmission << " ("
+                      << (serverAdmission == "QueueLength" ? std::to_string(serverAdmissionQueue) + " waiting"
+                                                           : FormatDouble(serverAdmissionTargetMs) + " ms target")
+                      << "), LB feeds rejections as " << lbRejection << ", " << lbRetries << " retries");
+    }
+    if (clientDeadlineMs > 0.0) {
+        NS_LOG_INFO("Deadlines: " << FormatDouble(clientDeadlineMs) << " ms per request, enforced by servers"
+                      << (!sidecar && lbDeadlineAware ? " and the LB" : ""));
+    }
+    if (serverCache != "None") {
+        NS_LOG_INFO("Server Cache: " << serverCache << ", " << serverCacheSize << " keys per server, hits take "
+                      << FormatDouble(serverCacheHitMs) << " ms");
+    }
+    if (!tierSizes.empty()) {
+        std::ostringstream graph;
+        graph << numServers;
+        for (size_t t = 0; t < tierSizes.size(); ++t) {
+            graph << " -> " << tierSizes[t] << " (" << FormatDelaySpec(tierDelaySpecs[t]) << ")";
+        }
+        NS_LOG_INFO("Service Graph: " << (tierSizes.size() + 1) << " tiers of " << graph.str() << " servers, "
+                      << tierCalls << " " << tierMode << " call(s) per request, picked by " << tierAlgorithm);
+    }
+    if (!degradation.IsEmpty()) {
+        NS_LOG_INFO("Server Degradation: " << degradation.GetEventCount() << " scheduled events");
+    }
     NS_LOG_INFO("Client Config: " << (clientRequestCount == 0 ? "Continuous" : std::to_string(clientRequestCount)) << " req/client, "
                   << clientRequestInterval.GetSeconds() << "s interval, "
-                  << clientRequestSizeBytes << " byte payload");
-    NS_LOG_INFO("Load Balancer VIP: " << lbVipAddressStr << ":" << LB_PORT); 
+                  << clientRequestSizeBytes << " byte payload, '" << clientArrivalSpec << "' arrivals, '"
+                  << clientKeySpec << "' keys");
+    NS_LOG_INFO("Message Sizes: requests '" << (clientRequestSizeSpec.empty() ? std::to_string(clientRequestSizeBytes) : clientRequestSizeSpec)
+                  << "', responses '" << clientResponseSizeSpec << "' (bytes)");
+    if (clientConnections > 1) {
+        NS_LOG_INFO("Client Connections: " << clientConnections << " per client, " << clientConnSpreading << " spreading");
+    }
+    if (!traceFile.empty()) {
+        NS_LOG_INFO("Trace Replay: '" << traceFile << "' split into " << numClients << " shards, "
+                      << (clientRequestCount == 0 ? std::string("replayed in full")
+                                                  : "at most " + std::to_string(clientRequestCount)
+                                                        + " records per shard (reqCount=0 replays all)"));
+    }
+    if (clientFanOut > 1) {
+        NS_LOG_INFO("Fan-Out: " << clientFanOut << " sub-requests per logical request, completed by "
+                      << (clientFanOutQuorum == 0 ? clientFanOut : clientFanOutQuorum) << " responses");
+    }
+    if (clientConcurrency > 0) {
+        NS_LOG_INFO("Client Mode: closed loop, " << clientConcurrency << " outstanding req/client, think time "
+                      << clientThinkTime << " (arrival process and interval unused)");
+    }
+    if (sidecar) {
+        NS_LOG_INFO("Load Balancing: client-side, one picker per client, clients connect to servers directly");
+    } else {
+        NS_LOG_INFO("Load Balancer VIP: " << lbVipAddressStr << ":" << LB_PORT); 
+    }
     NS_LOG_INFO("Simulation Stop Time: " << simStopTimeS << "s");
 
 
@@ -278,40 +583,73 @@ int MainSimulation(int argc, char* argv[])
     NodeContainer clientNodes;
     Ptr<Node> lbNode;
     NodeContainer serverNodes;
+    std::vector<NodeContainer> tierNodes;
     InternetStackHelper internetStack;
-    CreateTopology(numClients, numServers, clientNodes, lbNode, serverNodes, internetStack); 
+    if (sidecar) {
+        CreateFlatTopology(numClients, numServers, clientNodes, serverNodes, internetStack, tierSizes, tierNodes);
+    } else {
+        CreateTopology(numClients, numServers, clientNodes, lbNode, serverNodes, internetStack, tierSizes, tierNodes); 
+    }
 
     // Load Balancer Application Setup
     ObjectFactory lbFactory;
-    if (lbAlgorithm == "WRR") {
-        lbFactory.SetTypeId(WeightedRoundRobinLoadBalancer::GetTypeId());
-    } else if (lbAlgorithm == "LR") {
-        lbFactory.SetTypeId(LeastRequestLoadBalancer::GetTypeId());
-    } else if (lbAlgorithm == "Random") {
-        lbFactory.SetTypeId(RandomLoadBalancer::GetTypeId());
-    } else if (lbAlgorithm == "RingHash") {
-        lbFactory.SetTypeId(RingHashLoadBalancer::GetTypeId());
-    } else if (lbAlgorithm == "Maglev") {
-        lbFactory.SetTypeId(MaglevLoadBalancer::GetTypeId());
-    } else if (lbAlgorithm == "PeakEWMA") {
-        lbFactory.SetTypeId(PeakEwmaLoadBalancer::GetTypeId());
-    } else {
+    if (!SetLoadBalancerType(lbFactory, lbAlgorithm)) {
         NS_FATAL_ERROR("Invalid load balancing algorithm: " << lbAlgorithm << ". Supported: WRR, LR, Random, RingHash, Maglev, PeakEWMA.");
     }
     lbFactory.Set("Port", UintegerValue(LB_PORT)); 
+    lbFactory.Set("RejectionFeedback", StringValue(lbRejection));
+    lbFactory.Set("MaxRetries", UintegerValue(lbRetries));
+    lbFactory.Set("RequestTimeout", TimeValue(MilliSeconds(lbTimeoutMs)));
+    lbFactory.Set("DeadlineAware", BooleanValue(lbDeadlineAware));
 
-    Ptr<LoadBalancerApp> lbApp = lbFactory.Create<LoadBalancerApp>();
-    NS_ASSERT_MSG(lbApp, "Failed to create LoadBalancerApp instance.");
-    lbNode->AddApplication(lbApp);
-    lbApp->SetStartTime(Seconds(lbAppStartTimeS));
-    lbApp->SetStopTime(Seconds(simStopTimeS));
+    // In sidecar mode the same factory builds one picker per client instead.
+    Ptr<LoadBalancerApp> lbApp;
+    if (!sidecar) {
+        lbApp = lbFactory.Create<LoadBalancerApp>();
+        NS_ASSERT_MSG(lbApp, "Failed to create LoadBalancerApp instance.");
+        lbNode->AddApplication(lbApp);
+        lbApp->SetStartTime(Seconds(lbAppStartTimeS));
+        lbApp->SetStopTime(Seconds(simStopTimeS));
+        AssignStreamBlock(lbApp, RNG_STREAM_BASE_LB, 0);
+    }
 
     // Backend Server Applications Setup
     NS_LOG_INFO("Setting up " << numServers << " Backend Servers (LatencyServerApp)...");
     ApplicationContainer serverApps;
+    std::vector<Ptr<LoadBalancerApp>> routers; // The central LB or every sidecar picker.
+    if (lbApp) {
+        routers.push_back(lbApp);
+    }
+    std::vector<std::pair<InetSocketAddress, uint32_t>> backends;
     ObjectFactory serverFactory;
     serverFactory.SetTypeId(LatencyServerApp::GetTypeId());
     serverFactory.Set("Port", UintegerValue(SERVER_PORT)); 
+    serverFactory.Set("Workers", UintegerValue(serverWorkers));
+    serverFactory.Set("MaxQueueLength", UintegerValue(serverQueueLimit));
+    serverFactory.Set("QueueDiscipline", StringValue(serverQueueDiscipline));
+    serverFactory.Set("ServiceModel", StringValue(serverModel));
+    serverFactory.Set("AdmissionPolicy", StringValue(serverAdmission));
+    serverFactory.Set("AdmissionQueueLength", UintegerValue(serverAdmissionQueue));
+    serverFactory.Set("AdmissionLatencyTarget", TimeValue(MilliSeconds(serverAdmissionTargetMs)));
+    serverFactory.Set("CachePolicy", StringValue(serverCache));
+    serverFactory.Set("CacheCapacity", UintegerValue(serverCacheSize));
+    serverFactory.Set("CacheHitServiceTime", TimeValue(MilliSeconds(serverCacheHitMs)));
+    serverFactory.Set("DownstreamCalls", UintegerValue(tierCalls));
+    serverFactory.Set("DownstreamMode", StringValue(tierMode));
+
+    // Mid-tier servers balance their calls over the next tier with embedded pickers.
+    ObjectFactory tierFactory;
+    if (!SetLoadBalancerType(tierFactory, tierAlgorithm)) {
+        NS_FATAL_ERROR("Invalid tierAlgorithm: " << tierAlgorithm << ". Supported: WRR, LR, Random, RingHash, Maglev, PeakEWMA.");
+    }
+    tierFactory.Set("RejectionFeedback", StringValue(lbRejection));
+    auto makeTierPicker = [&tierFactory, &tierNodes](size_t tier) {
+        Ptr<LoadBalancerApp> picker = tierFactory.Create<LoadBalancerApp>();
+        for (uint32_t j = 0; j < tierNodes[tier].GetN(); ++j) {
+            picker->AddBackend(InetSocketAddress(GetIpv4Address(tierNodes[tier].Get(j), 1), SERVER_PORT), kDefaultWeight);
+        }
+        return picker;
+    };
 
     for (uint32_t i = 0; i < numServers; ++i)
     {
@@ -321,19 +659,49 @@ int MainSimulation(int argc, char* argv[])
 
         Ptr<LatencyServerApp> latencyApp = DynamicCast<LatencyServerApp>(app);
         NS_ASSERT_MSG(latencyApp, "Failed to cast Application to LatencyServerApp for server " << i);
-        latencyApp->SetProcessingDelay(MilliSeconds(serverDelaysMs[i]));
+        latencyApp->SetServiceTimeDistribution(CreateServiceTimeDistribution(serverDelaySpecs[i]));
+        if (!tierNodes.empty()) {
+            latencyApp->SetDownstream(makeTierPicker(0));
+        }
+        degradation.Install(latencyApp, i);
         
         serverNode->AddApplication(latencyApp);
         latencyApp->SetStartTime(Seconds(serverAppStartTimeS));
         latencyApp->SetStopTime(Seconds(simStopTimeS));
+        AssignStreamBlock(latencyApp, RNG_STREAM_BASE_SERVERS, i);
         serverApps.Add(latencyApp);
 
         InetSocketAddress backendAddr(GetIpv4Address(serverNode, 1), SERVER_PORT); 
-        lbApp->AddBackend(backendAddr, serverWeights[i]);
+        backends.emplace_back(backendAddr, serverWeights[i]);
+        if (lbApp) {
+            lbApp->AddBackend(backendAddr, serverWeights[i]);
+        }
 
         NS_LOG_INFO("  Server " << i << " (Node " << serverNode->GetId()
                       << ", " << backendAddr.GetIpv4() << ":" << backendAddr.GetPort()
-                      << ") installed. Weight: " << serverWeights[i] << ", Delay: " << serverDelaysMs[i] << "ms");
+                      << ") installed. Weight: " << serverWeights[i] << ", Delay: " << FormatDelaySpec(serverDelaySpecs[i]));
+    }
+
+    // Downstream Tier Setup: tier t + 2 is called by tier t + 1; the last tier answers directly.
+    std::vector<ApplicationContainer> tierApps(tierNodes.size());
+    uint32_t tierServerIndex = numServers; // RNG stream blocks continue after the front tier's.
+    for (size_t t = 0; t < tierNodes.size(); ++t)
+    {
+        for (uint32_t j = 0; j < tierNodes[t].GetN(); ++j)
+        {
+            Ptr<LatencyServerApp> tierApp = serverFactory.Create<LatencyServerApp>();
+            tierApp->SetServiceTimeDistribution(CreateServiceTimeDistribution(tierDelaySpecs[t]));
+            if (t + 1 < tierNodes.size()) {
+                tierApp->SetDownstream(makeTierPicker(t + 1));
+            }
+            tierNodes[t].Get(j)->AddApplication(tierApp);
+            tierApp->SetStartTime(Seconds(serverAppStartTimeS));
+            tierApp->SetStopTime(Seconds(simStopTimeS));
+            AssignStreamBlock(tierApp, RNG_STREAM_BASE_SERVERS, tierServerIndex++);
+            tierApps[t].Add(tierApp);
+        }
+        NS_LOG_INFO("  Tier " << (t + 2) << ": " << tierNodes[t].GetN() << " servers installed, Delay: "
+                      << FormatDelaySpec(tierDelaySpecs[t]));
     }
 
     // Client Applications Setup
@@ -346,20 +714,88 @@ int MainSimulation(int argc, char* argv[])
     clientFactory.Set("RequestCount", UintegerValue(clientRequestCount));
     clientFactory.Set("RequestInterval", TimeValue(clientRequestInterval));
     clientFactory.Set("RequestSize", UintegerValue(clientRequestSizeBytes));
+    clientFactory.Set("Concurrency", UintegerValue(clientConcurrency));
+    clientFactory.Set("FanOut", UintegerValue(clientFanOut));
+    clientFactory.Set("FanOutQuorum", UintegerValue(clientFanOutQuorum));
+    clientFactory.Set("ThinkTime", StringValue(clientThinkTime));
+    clientFactory.Set("HistogramPrecision", UintegerValue(histogramPrecision));
+    clientFactory.Set("HistogramHighestLatency", TimeValue(MilliSeconds(histogramHighestMs)));
+    clientFactory.Set("TimeSeriesWindow", TimeValue(MilliSeconds(timeSeriesWindowMs)));
+    clientFactory.Set("Connections", UintegerValue(clientConnections));
+    clientFactory.Set("ConnectionSpreading", StringValue(clientConnSpreading));
+    clientFactory.Set("Timeout", TimeValue(MilliSeconds(clientTimeoutMs)));
+    clientFactory.Set("LatencySlo", TimeValue(MilliSeconds(clientSloMs)));
+    clientFactory.Set("DeadlineBudget", TimeValue(MilliSeconds(clientDeadlineMs)));
 
     for (uint32_t i = 0; i < numClients; ++i)
     {
         Ptr<Node> clientNode = clientNodes.Get(i);
         Ptr<Application> app = clientFactory.Create<Application>();
         NS_ASSERT_MSG(app, "Failed to create client Application instance.");
+
+        // Each client needs its own arrival process and key generator instances (and RNG streams).
+        // Key generators map ranks to keys identically everywhere, so hot keys are shared.
+        Ptr<LatencyClientApp> latencyClient = DynamicCast<LatencyClientApp>(app);
+        NS_ASSERT_MSG(latencyClient, "Failed to cast Application to LatencyClientApp for client " << i);
+        latencyClient->SetArrivalProcess(CreateArrivalProcess(clientArrivalSpec, clientRequestInterval));
+        latencyClient->SetKeyGenerator(CreateKeyGenerator(clientKeySpec));
+        if (!clientRequestSizeSpec.empty()) {
+            latencyClient->SetRequestSizeDistribution(CreateSizeDistribution(clientRequestSizeSpec));
+        }
+        latencyClient->SetResponseSizeDistribution(CreateSizeDistribution(clientResponseSizeSpec));
+        if (sidecar) {
+            // The picker only ever sees this client's requests; it draws from the client's streams.
+            Ptr<LoadBalancerApp> picker = lbFactory.Create<LoadBalancerApp>();
+            NS_ASSERT_MSG(picker, "Failed to create picker for client " << i);
+            for (const auto& backend : backends) {
+                picker->AddBackend(backend.first, backend.second);
+            }
+            latencyClient->SetPicker(picker);
+            routers.push_back(picker);
+        }
+        AssignStreamBlock(latencyClient, RNG_STREAM_BASE_CLIENTS, i);
+        if (!traceFile.empty()) {
+            latencyClient->SetTrace(traceFile, i, numClients);
+        }
         
         clientNode->AddApplication(app);
         app->SetStartTime(Seconds(clientAppStartTimeS + (static_cast<double>(i) * kDefaultClientStartTimeStaggerS)));
         app->SetStopTime(Seconds(simStopTimeS));
         clientApps.Add(app);
 
-        NS_LOG_INFO("  Client " << i << " (Node " << clientNode->GetId()
-                      << ") installed, targeting " << lbVipAddressStr << ":" << LB_PORT);
+        NS_LOG_INFO("  Client " << i << " (Node " << clientNode->GetId() << ") installed, targeting "
+                      << (sidecar ? std::to_string(backends.size()) + " servers directly"
+                                  : lbVipAddressStr + ":" + std::to_string(LB_PORT)));
+    }
+
+    // Fault observation: snapshot the routing to each failed server when it fails and recovers.
+    const std::vector<DegradationScenario::Fault> faults = degradation.GetFaults(numServers);
+    std::vector<FaultObservation> faultObservations(faults.size());
+    auto routedTo = [&routers](const InetSocketAddress& backend) {
+        uint64_t routed = 0;
+        for (Ptr<LoadBalancerApp> router : routers) {
+            routed += router->GetRoutedCount(backend);
+        }
+        return routed;
+    };
+    for (size_t f = 0; f < faults.size(); ++f) {
+        if (faults[f].start >= Seconds(simStopTimeS)) {
+            continue; // Reported as not reached.
+        }
+        const InetSocketAddress backend = backends[faults[f].server].first;
+        FaultObservation& observation = faultObservations[f];
+        const Time end = faults[f].duration.IsStrictlyPositive() ? std::min(faults[f].start + faults[f].duration, Seconds(simStopTimeS))
+                                                                 : Seconds(simStopTimeS);
+        Simulator::Schedule(faults[f].start, [&observation, &routedTo, backend]() {
+            observation.routedBefore = routedTo(backend);
+        });
+        Simulator::Schedule(end, [&observation, &routedTo, &routers, backend]() {
+            observation.routedDuring = routedTo(backend) - observation.routedBefore;
+            for (Ptr<LoadBalancerApp> router : routers) {
+                observation.lastRouted = std::max(observation.lastRouted, router->GetLastRoutedTime(backend));
+            }
+            observation.ended = true;
+        });
     }
 
     // Routing Configuration
@@ -373,65 +809,221 @@ int MainSimulation(int argc, char* argv[])
     NS_LOG_INFO("--- Simulation Finished ---");
 
     // Results Collection and Analysis: Latency
-    std::vector<Time> allLatencies;
-    uint64_t totalResponses = 0;
+    // Same range and precision as the client histograms, so merging clamps nothing.
+    const Time histogramHighest = MilliSeconds(histogramHighestMs);
+    LatencyHistogram allLatencies(histogramHighest, histogramPrecision);
+    LatencyHistogram allCorrectedLatencies(histogramHighest, histogramPrecision);
+    LatencyHistogram allLogicalLatencies(histogramHighest, histogramPrecision);
+    LatencyHistogram allLogicalCorrectedLatencies(histogramHighest, histogramPrecision);
+    std::unique_ptr<LatencyTimeSeries> allTimeSeries;
+    if (timeSeriesWindowMs > 0.0) {
+        // Same window and range as the clients' series, so merged windows clamp nothing.
+        allTimeSeries = std::make_unique<LatencyTimeSeries>(MilliSeconds(timeSeriesWindowMs), histogramHighest);
+    }
+    double totalAchievedRps = 0.0;
+    double totalGoodput = 0.0;
+    double totalSendThroughput = 0.0;
+    double totalReceiveThroughput = 0.0;
+    uint64_t totalAbandoned = 0;
+    uint64_t totalSendFailures = 0;
+    uint64_t totalSent = 0;
+    uint64_t totalTimedOut = 0;
+    uint64_t totalLate = 0;
+    uint64_t totalRejected = 0;
+    uint64_t totalDeadlineExceeded = 0;
+    uint64_t totalPastDeadline = 0;
+    uint64_t totalLogicalFailed = 0;
     for (uint32_t i = 0; i < clientApps.GetN(); ++i)
     {
         Ptr<LatencyClientApp> client = DynamicCast<LatencyClientApp>(clientApps.Get(i));
         if (client)
         {
-            const auto& latencies = client->GetLatencies();
-            allLatencies.insert(allLatencies.end(), latencies.begin(), latencies.end());
-            totalResponses += latencies.size();
+            allLatencies.Merge(client->GetLatencyHistogram());
+            allCorrectedLatencies.Merge(client->GetCorrectedLatencyHistogram());
+            allLogicalLatencies.Merge(client->GetLogicalLatencyHistogram());
+            allLogicalCorrectedLatencies.Merge(client->GetLogicalCorrectedLatencyHistogram());
+            totalLogicalFailed += client->GetLogicalRequestsFailed();
+            if (allTimeSeries && client->GetLatencyTimeSeries()) {
+                allTimeSeries->Merge(*client->GetLatencyTimeSeries());
+            }
+            totalAchievedRps += client->GetAchievedRps();
+            totalAbandoned += client->GetRequestsAbandoned();
+            totalSendFailures += client->GetSendFailures();
+            totalGoodput += client->GetGoodput();
+            totalSendThroughput += client->GetSendThroughput();
+            totalReceiveThroughput += client->GetReceiveThroughput();
+            totalSent += client->GetRequestsSent();
+            totalTimedOut += client->GetRequestsTimedOut();
+            totalLate += client->GetLateResponses();
+            totalRejected += client->GetRequestsRejected();
+            totalDeadlineExceeded += client->GetRequestsDeadlineExceeded();
+            totalPastDeadline += client->GetResponsesPastDeadline();
         }
     }
     
-    uint64_t expectedTotalRequestsFromClients = (clientRequestCount > 0) ? (static_cast<uint64_t>(numClients) * clientRequestCount) : 0;
+    uint64_t expectedTotalRequestsFromClients = (clientRequestCount > 0) ? (static_cast<uint64_t>(numClients) * clientRequestCount * clientFanOut) : 0;
 
 
+    const uint64_t totalResponses = allLatencies.GetCount();
     NS_LOG_INFO("\n--- Latency Results (" << totalResponses << " responses recorded) ---");
-    if (!allLatencies.empty())
+    if (totalResponses > 0)
     {
-        std::sort(allLatencies.begin(), allLatencies.end());
-
-        const Time minLatency = allLatencies.front();
-        const Time maxLatency = allLatencies.back();
-        const Time p50Latency = CalculatePercentile(allLatencies, 0.50);
-        const Time p75Latency = CalculatePercentile(allLatencies, 0.75);
-        const Time p90Latency = CalculatePercentile(allLatencies, 0.90);
-        const Time p95Latency = CalculatePercentile(allLatencies, 0.95);
-        const Time p99Latency = CalculatePercentile(allLatencies, 0.99);
-
-        const double totalLatencyMsVal = std::accumulate(allLatencies.begin(), allLatencies.end(), 0.0,
-            [](double sum, const Time& t){ return sum + t.GetMilliSeconds(); });
-        
-        const double avgLatencyMs = totalLatencyMsVal / static_cast<double>(allLatencies.size());
-
-        const double varianceAccum = std::accumulate(allLatencies.begin(), allLatencies.end(), 0.0,
-            [&](double acc, const Time& t){ return acc + std::pow(t.GetMilliSeconds() - avgLatencyMs, 2); });
-        
-        const double variance = varianceAccum / static_cast<double>(allLatencies.size());
-        const double stdDevLatencyMs = std::sqrt(variance);
-
-        NS_LOG_INFO("Min Latency:    " << FormatTimeMs(minLatency) << " ms");
-        NS_LOG_INFO("Avg Latency:    " << FormatDouble(avgLatencyMs) << " ms");
-        NS_LOG_INFO("P50 Latency:    " << FormatTimeMs(p50Latency) << " ms");
-        NS_LOG_INFO("P75 Latency:    " << FormatTimeMs(p75Latency) << " ms");
-        NS_LOG_INFO("P90 Latency:    " << FormatTimeMs(p90Latency) << " ms");
-        NS_LOG_INFO("P95 Latency:    " << FormatTimeMs(p95Latency) << " ms");
-        NS_LOG_INFO("P99 Latency:    " << FormatTimeMs(p99Latency) << " ms");
-        NS_LOG_INFO("Max Latency:    " << FormatTimeMs(maxLatency) << " ms");
-        NS_LOG_INFO("Std Dev:        " << FormatDouble(stdDevLatencyMs) << " ms");
+        NS_LOG_INFO("Corrected (from intended send time; SLO basis):");
+        LogLatencySummary(allCorrectedLatencies);
+        NS_LOG_INFO("Uncorrected (from actual send time):");
+        LogLatencySummary(allLatencies);
+        NS_LOG_INFO("Achieved RPS:   " << FormatDouble(totalAchievedRps, 2) << " req/s (sum over clients)");
+        NS_LOG_INFO("Throughput:     " << FormatDouble(totalSendThroughput / 1e6, 3) << " MB/s sent, "
+                      << FormatDouble(totalReceiveThroughput / 1e6, 3) << " MB/s received (sum over clients, headers included)");
+        if (totalAbandoned > 0) {
+            NS_LOG_INFO("Abandoned:      " << totalAbandoned << " requests (connection lost before response)");
+        }
+        if (totalSendFailures > 0) {
+            NS_LOG_INFO("Send Failures:  " << totalSendFailures << " requests failed to enter the socket");
+        }
     }
     else
     {
         NS_LOG_INFO("No latency data collected (0 responses received).");
     }
+    if (clientTimeoutMs > 0.0 || clientSloMs > 0.0)
+    {
+        const double timeoutRatePct = (totalSent > 0) ? 100.0 * static_cast<double>(totalTimedOut) / static_cast<double>(totalSent) : 0.0;
+        NS_LOG_INFO("Goodput:        " << FormatDouble(totalGoodput, 2) << " req/s within "
+                      << (clientSloMs > 0.0 ? FormatDouble(clientSloMs) + " ms SLO" : std::string("timeout"))
+                      << " (sum over clients)");
+        NS_LOG_INFO("Timeouts:       " << totalTimedOut << " of " << totalSent << " requests ("
+                      << FormatDouble(timeoutRatePct, 2) << "%), " << totalLate << " answered late");
+    }
+    if (serverAdmission != "None")
+    {
+        const double rejectRatePct = (totalSent > 0) ? 100.0 * static_cast<double>(totalRejected) / static_cast<double>(totalSent) : 0.0;
+        NS_LOG_INFO("Rejections:     " << totalRejected << " of " << totalSent << " requests ("
+                      << FormatDouble(rejectRatePct, 2) << "%) reached clients as rejected");
+        if (lbApp) {
+            NS_LOG_INFO("LB Rejections:  " << lbApp->GetRejectionCount() << " received from backends, "
+                          << lbApp->GetRetryCount() << " retried");
+        }
+    }
+    if (clientDeadlineMs > 0.0)
+    {
+        uint64_t serverDeadlineMisses = 0;
+        for (uint32_t i = 0; i < serverApps.GetN(); ++i) {
+            serverDeadlineMisses += DynamicCast<LatencyServerApp>(serverApps.Get(i))->GetDeadlineMissCount();
+        }
+        for (const ApplicationContainer& apps : tierApps) {
+            for (uint32_t i = 0; i < apps.GetN(); ++i) {
+                serverDeadlineMisses += DynamicCast<LatencyServerApp>(apps.Get(i))->GetDeadlineMissCount();
+            }
+        }
+        const double missRatePct = (totalSent > 0) ? 100.0 * static_cast<double>(totalDeadlineExceeded + totalPastDeadline) / static_cast<double>(totalSent) : 0.0;
+        NS_LOG_INFO("Deadlines:      " << totalDeadlineExceeded << " of " << totalSent << " requests failed fast, "
+                      << totalPastDeadline << " served too late (" << FormatDouble(missRatePct, 2) << "% missed)");
+        NS_LOG_INFO("Deadline Work:  " << serverDeadlineMisses << " expired requests skipped by servers"
+                      << (lbApp ? ", " + std::to_string(lbApp->GetDeadlineFailCount()) + " failed fast by the LB" : std::string()));
+    }
+    if (serverCache != "None")
+    {
+        uint64_t cacheHits = 0;
+        uint64_t cacheMisses = 0;
+        for (uint32_t i = 0; i < serverApps.GetN(); ++i) {
+            Ptr<LatencyServerApp> serverApp = DynamicCast<LatencyServerApp>(serverApps.Get(i));
+            if (serverApp) {
+                cacheHits += serverApp->GetCacheHits();
+                cacheMisses += serverApp->GetCacheMisses();
+            }
+        }
+        const uint64_t cacheAccesses = cacheHits + cacheMisses;
+        NS_LOG_INFO("Cache Hit Ratio: " << FormatDouble(cacheAccesses > 0 ? 100.0 * static_cast<double>(cacheHits) / static_cast<double>(cacheAccesses) : 0.0, 2)
+                      << "% (" << cacheHits << " hits, " << cacheMisses << " misses over all servers)");
+    }
+    if (clientFanOut > 1)
+    {
+        NS_LOG_INFO("\n--- Fan-Out Results (" << allLogicalCorrectedLatencies.GetCount() << " logical requests completed, "
+                      << totalLogicalFailed << " failed) ---");
+        if (allLogicalCorrectedLatencies.GetCount() > 0 && totalResponses > 0)
+        {
+            NS_LOG_INFO("Logical, corrected (from intended send time):");
+            LogLatencySummary(allLogicalCorrectedLatencies);
+            NS_LOG_INFO("Logical, uncorrected (from actual send time):");
+            LogLatencySummary(allLogicalLatencies);
+            // Tail amplification: how much slower the logical request is than one of its sub-requests.
+            for (double quantile : {0.50, 0.99}) {
+                const double subMs = allCorrectedLatencies.GetPercentile(quantile).GetSeconds() * 1e3;
+                const double logicalMs = allLogicalCorrectedLatencies.GetPercentile(quantile).GetSeconds() * 1e3;
+                NS_LOG_INFO("Amplification P" << FormatDouble(quantile * 100, 0) << ": "
+                              << FormatDouble(subMs > 0.0 ? logicalMs / subMs : 0.0, 2) << "x ("
+                              << FormatDouble(logicalMs) << " ms logical vs " << FormatDouble(subMs) << " ms per sub-request)");
+            }
+        }
+    }
     NS_LOG_INFO("--------------------------------------------------");
 
+    if (allTimeSeries)
+    {
+        const Time convergeAfter = Seconds(convergeAfterS >= 0.0 ? convergeAfterS : clientAppStartTimeS);
+        Time convergence;
+        if (allTimeSeries->GetConvergenceTime(convergeAfter, convergeQuantile, convergeTolerance, convergence)) {
+            NS_LOG_INFO("Convergence:    " << FormatTimeMs(convergence, 0) << " ms after " << convergeAfter.GetSeconds()
+                          << "s until windowed P" << FormatDouble(convergeQuantile * 100, 1) << " stays within "
+                          << FormatDouble(convergeTolerance * 100, 0) << "% of its steady state");
+        } else {
+            NS_LOG_INFO("Convergence:    no responses after " << convergeAfter.GetSeconds() << "s");
+        }
+        if (!timeSeriesFile.empty()) {
+            WriteTimeSeriesCsv(*allTimeSeries, timeSeriesFile);
+        }
+    }
+
+    // Results Collection and Analysis: Server Failures
+    if (!faults.empty())
+    {
+        NS_LOG_INFO("\n--- Fault Injection Results (" << lbAlgorithm << ", " << lbMode << ") ---");
+        for (size_t f = 0; f < faults.size(); ++f) {
+            const DegradationScenario::Fault& fault = faults[f];
+            const FaultObservation& observation = faultObservations[f];
+            std::ostringstream line;
+            line << "Server " << fault.server << " " << fault.kind << " at " << fault.start.GetSeconds() << "s for "
+                 << (fault.duration.IsStrictlyPositive() ? FormatDouble(fault.duration.GetSeconds(), 3) + "s" : std::string("good"))
+                 << ": ";
+            if (!observation.ended) {
+                line << "not reached before the end of the simulation";
+            } else if (observation.routedDuring == 0) {
+                line << "no requests routed to it while failed";
+            } else {
+                // Once the balancers notice, they stop routing to the server: the last request
+                // routed to it bounds the time to detect. Close to the failure's length = never noticed.
+                line << observation.routedDuring << " requests routed to it while failed, time to detect "
+                     << FormatTimeMs(observation.lastRouted - fault.start, 1) << " ms";
+            }
+            NS_LOG_INFO(line.str());
+        }
+        uint64_t serverLost = 0;
+        for (uint32_t i = 0; i < serverApps.GetN(); ++i) {
+            Ptr<LatencyServerApp> serverApp = DynamicCast<LatencyServerApp>(serverApps.Get(i));
+            if (serverApp) {
+                serverLost += serverApp->GetRequestsLost();
+            }
+        }
+        uint64_t lbLost = 0;
+        uint64_t lbRetried = 0;
+        uint64_t lbTimedOut = 0;
+        for (Ptr<LoadBalancerApp> router : routers) {
+            lbLost += router->GetLostRequestCount();
+            lbRetried += router->GetRetryCount();
+            lbTimedOut += router->GetTimedOutCount();
+        }
+        NS_LOG_INFO("Requests lost:  " << serverLost << " by failed servers (crashed or hung), "
+                      << (sidecar ? std::string("") : std::to_string(lbLost) + " on failed LB backend connections or LB timeouts ("
+                                                      + std::to_string(lbTimedOut) + " timed out, "
+                                                      + std::to_string(lbRetried) + " retried), ")
+                      << totalAbandoned << " abandoned and " << totalTimedOut << " timed out at the clients");
+    }
+
     // Results Collection and Analysis: Server Request Distribution
     NS_LOG_INFO("\n--- Backend Server Request Distribution ---");
     uint64_t totalRequestsProcessedByServers = 0;
+    uint64_t maxRequestsOnOneServer = 0;
     for (uint32_t i = 0; i < serverApps.GetN(); ++i)
     {
         Ptr<LatencyServerApp> serverApp = DynamicCast<LatencyServerApp>(serverApps.Get(i));
@@ -449,9 +1041,29 @@ int MainSimulation(int argc, char* argv[])
                  }
             }
             NS_LOG_INFO("Server " << i << " (" << serverAddr.GetIpv4() << ":" << serverAddr.GetPort()
-                      << ", W:" << serverWeights[i] << ", D:" << serverDelaysMs[i] << "ms): "
+                      << ", W:" << serverWeights[i] << ", D:" << FormatDelaySpec(serverDelaySpecs[i]) << "): "
                       << count << " requests");
+            if (serverApp->GetPauseCount() > 0) {
+                NS_LOG_INFO("    Paused " << serverApp->GetPauseCount() << " times for "
+                              << FormatDouble(serverApp->GetPausedTime().GetSeconds() * 1e3) << " ms in total");
+            }
+            if (serverWorkers > 0) {
+                NS_LOG_INFO("    Utilization " << FormatDouble(serverApp->GetUtilization() * 100, 1)
+                              << "%, queue mean " << FormatDouble(serverApp->GetMeanQueueLength(), 2)
+                              << " / peak " << serverApp->GetPeakQueueLength()
+                              << ", mean wait " << FormatDouble(serverApp->GetMeanQueueingDelay().GetSeconds() * 1e3) << " ms, "
+                              << serverApp->GetQueueFullRejections() << " rejected at a full queue");
+            }
+            if (serverAdmission != "None") {
+                NS_LOG_INFO("    Rejected " << serverApp->GetRequestsRejected() << " requests by admission control");
+            }
+            if (serverCache != "None") {
+                NS_LOG_INFO("    Cache hit ratio " << FormatDouble(serverApp->GetCacheHitRatio() * 100, 1) << "% ("
+                              << serverApp->GetCacheHits() << " hits, " << serverApp->GetCacheMisses() << " misses), "
+                              << serverApp->GetCacheSize() << " of " << serverCacheSize << " keys cached");
+            }
             totalRequestsProcessedByServers += count;
+            maxRequestsOnOneServer = std::max(maxRequestsOnOneServer, count);
         }
         else
         {
@@ -459,6 +1071,11 @@ int MainSimulation(int argc, char* argv[])
         }
     }
     NS_LOG_INFO("Total Requests Processed by Servers: " << totalRequestsProcessedByServers);
+    if (totalRequestsProcessedByServers > 0) {
+        // Hot-spotting indicator: 1.0 is a perfectly even spread.
+        const double meanPerServer = static_cast<double>(totalRequestsProcessedByServers) / serverApps.GetN();
+        NS_LOG_INFO("Max/Mean Server Load: " << FormatDouble(static_cast<double>(maxRequestsOnOneServer) / meanPerServer, 2));
+    }
     
     if (expectedTotalRequestsFromClients > 0) { 
         if (totalRequestsProcessedByServers != expectedTotalRequestsFromClients) {
@@ -472,6 +1089,46 @@ int MainSimulation(int argc, char* argv[])
     } else if (clientRequestCount == 0) {
         NS_LOG_INFO("(Client request count was 0 - continuous sending; direct comparison not applicable.)");
     }
+
+    // Results Collection and Analysis: Service Graph
+    if (!tierApps.empty())
+    {
+        NS_LOG_INFO("\n--- Service Graph Results (end-to-end latency is the client latency above) ---");
+        auto calledBy = [](const ApplicationContainer& apps, uint64_t& calls, uint64_t& failures) {
+            calls = 0;
+            failures = 0;
+            for (uint32_t i = 0; i < apps.GetN(); ++i) {
+                Ptr<LatencyServerApp> app = DynamicCast<LatencyServerApp>(apps.Get(i));
+                calls += app->GetDownstreamCallCount();
+                failures += app->GetDownstreamFailures();
+            }
+        };
+        for (size_t t = 0; t < tierApps.size(); ++t)
+        {
+            uint64_t calls = 0;
+            uint64_t failures = 0;
+            calledBy(t == 0 ? serverApps : tierApps[t - 1], calls, failures);
+            uint64_t received = 0;
+            uint64_t maxReceived = 0;
+            double utilization = 0.0;
+            for (uint32_t j = 0; j < tierApps[t].GetN(); ++j) {
+                Ptr<LatencyServerApp> app = DynamicCast<LatencyServerApp>(tierApps[t].Get(j));
+                received += app->GetTotalRequestsReceived();
+                maxReceived = std::max(maxReceived, app->GetTotalRequestsReceived());
+                utilization += app->GetUtilization();
+            }
+            const double meanReceived = static_cast<double>(received) / tierApps[t].GetN();
+            std::ostringstream line;
+            line << "Tier " << (t + 2) << " (" << tierApps[t].GetN() << " servers): " << calls << " calls from tier "
+                 << (t + 1) << ", " << failures << " tier " << (t + 1) << " requests failed by a lost or rejected call; "
+                 << received << " requests received, max/mean load "
+                 << FormatDouble(meanReceived > 0.0 ? static_cast<double>(maxReceived) / meanReceived : 0.0, 2);
+            if (serverWorkers > 0) {
+                line << ", mean utilization " << FormatDouble(utilization / tierApps[t].GetN() * 100, 1) << "%";
+            }
+            NS_LOG_INFO(line.str());
+        }
+    }
     NS_LOG_INFO("-----------------------------------------");
 
     // Cleanup
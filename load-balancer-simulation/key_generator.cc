@@ -0,0 +1,266 @@
+#include "key_generator.h"
+
+#include "utils.h" // For SplitSpec, ParseSpecNumber
+#include "ns3/log.h"
+#include "ns3/double.h"                 // For DoubleValue
+#include "ns3/uinteger.h"               // For UintegerValue
+#include "ns3/random-variable-stream.h" // For UniformRandomVariable
+#include "ns3/core-module.h"            // For CreateObject
+
+#include <algorithm> // For std::clamp
+#include <cmath>     // For std::exp, std::log, std::log1p, std::expm1
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("KeyGenerator");
+
+NS_OBJECT_ENSURE_REGISTERED(KeyGenerator);
+NS_OBJECT_ENSURE_REGISTERED(UniformKeyGenerator);
+NS_OBJECT_ENSURE_REGISTERED(ZipfKeyGenerator);
+
+namespace { // Anonymous namespace for internal linkage helpers
+
+// log1p(x) / x, continued smoothly to x = 0.
+double Log1pOverX(double x)
+{
+    if (std::abs(x) > 1e-8) {
+        return std::log1p(x) / x;
+    }
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+// expm1(x) / x, continued smoothly to x = 0.
+double Expm1OverX(double x)
+{
+    if (std::abs(x) > 1e-8) {
+        return std::expm1(x) / x;
+    }
+    return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+} // namespace
+
+// --- KeyGenerator ---
+
+TypeId KeyGenerator::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::KeyGenerator")
+                            .SetParent<Object>()
+                            .SetGroupName("Applications");
+    return tid;
+}
+
+KeyGenerator::KeyGenerator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+KeyGenerator::~KeyGenerator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t KeyGenerator::KeyForRank(uint64_t rank)
+{
+    uint64_t z = rank + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// --- UniformKeyGenerator ---
+
+TypeId UniformKeyGenerator::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::UniformKeyGenerator")
+                            .SetParent<KeyGenerator>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<UniformKeyGenerator>()
+                            .AddAttribute("KeySpace",
+                                          "Number of distinct keys shared by all clients "
+                                          "(0 draws independent random 64-bit keys).",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(&UniformKeyGenerator::m_keySpace),
+                                          MakeUintegerChecker<uint64_t>());
+    return tid;
+}
+
+UniformKeyGenerator::UniformKeyGenerator()
+    : m_keySpace(0),
+      m_draw(CreateObject<UniformRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+UniformKeyGenerator::~UniformKeyGenerator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t UniformKeyGenerator::GetNextKey()
+{
+    // Draw the halves in separate statements so their order is fixed across compilers.
+    const uint32_t maxWord = std::numeric_limits<uint32_t>::max();
+    const uint64_t high = m_draw->GetInteger(0, maxWord);
+    const uint64_t low = m_draw->GetInteger(0, maxWord);
+    const uint64_t bits = (high << 32) | low;
+    if (m_keySpace == 0) {
+        return bits;
+    }
+    return KeyForRank(1 + bits % m_keySpace); // Modulo bias is negligible for realistic key spaces.
+}
+
+int64_t UniformKeyGenerator::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- ZipfKeyGenerator ---
+
+TypeId ZipfKeyGenerator::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ZipfKeyGenerator")
+                            .SetParent<KeyGenerator>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<ZipfKeyGenerator>()
+                            .AddAttribute("KeySpace",
+                                          "Number of distinct keys shared by all clients.",
+                                          UintegerValue(1000000),
+                                          MakeUintegerAccessor(&ZipfKeyGenerator::m_keySpace),
+                                          MakeUintegerChecker<uint64_t>(1))
+                            .AddAttribute("Exponent",
+                                          "Zipf exponent: rank k is drawn with probability proportional "
+                                          "to 1/k^Exponent (0 = uniform, larger = more skewed).",
+                                          DoubleValue(1.0),
+                                          MakeDoubleAccessor(&ZipfKeyGenerator::m_exponent),
+                                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+ZipfKeyGenerator::ZipfKeyGenerator()
+    : m_keySpace(1000000),
+      m_exponent(1.0),
+      m_constantsKeySpace(0),
+      m_constantsExponent(-1.0),
+      m_hIntegralX1(0.0),
+      m_hIntegralKeySpace(0.0),
+      m_squeeze(0.0),
+      m_draw(CreateObject<UniformRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ZipfKeyGenerator::~ZipfKeyGenerator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void ZipfKeyGenerator::UpdateConstants()
+{
+    m_hIntegralX1 = HIntegral(1.5) - 1.0;
+    m_hIntegralKeySpace = HIntegral(static_cast<double>(m_keySpace) + 0.5);
+    m_squeeze = 2.0 - HIntegralInverse(HIntegral(2.5) - H(2.0));
+    m_constantsKeySpace = m_keySpace;
+    m_constantsExponent = m_exponent;
+    NS_LOG_DEBUG("ZipfKeyGenerator: " << m_keySpace << " keys, exponent " << m_exponent);
+}
+
+double ZipfKeyGenerator::H(double x) const
+{
+    return std::exp(-m_exponent * std::log(x));
+}
+
+double ZipfKeyGenerator::HIntegral(double x) const
+{
+    const double logX = std::log(x);
+    return Expm1OverX((1.0 - m_exponent) * logX) * logX;
+}
+
+double ZipfKeyGenerator::HIntegralInverse(double x) const
+{
+    double t = x * (1.0 - m_exponent);
+    if (t < -1.0) {
+        t = -1.0; // Guard against rounding just outside the domain.
+    }
+    return std::exp(Log1pOverX(t) * x);
+}
+
+uint64_t ZipfKeyGenerator::GetNextRank()
+{
+    if (m_constantsKeySpace != m_keySpace || m_constantsExponent != m_exponent) {
+        UpdateConstants();
+    }
+    const double maxRank = static_cast<double>(m_keySpace);
+    while (true) {
+        // Invert the integral of the hat function at a uniform point...
+        const double u = m_hIntegralKeySpace + m_draw->GetValue() * (m_hIntegralX1 - m_hIntegralKeySpace);
+        const double x = HIntegralInverse(u);
+        const double k = std::clamp(std::floor(x + 0.5), 1.0, maxRank);
+        // ...and accept if it falls under the true (step) density.
+        if (k - x <= m_squeeze || u >= HIntegral(k + 0.5) - H(k)) {
+            return static_cast<uint64_t>(k);
+        }
+    }
+}
+
+uint64_t ZipfKeyGenerator::GetNextKey()
+{
+    return KeyForRank(GetNextRank());
+}
+
+int64_t ZipfKeyGenerator::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- Factory ---
+
+Ptr<KeyGenerator> CreateKeyGenerator(const std::string& spec)
+{
+    NS_LOG_FUNCTION(spec);
+    std::vector<std::string> fields = SplitSpec(spec);
+    const std::string kind = fields.empty() ? "uniform" : fields[0];
+
+    // Parses fields[index] as a number, aborting with a helpful message on failure.
+    auto numberAt = [&](size_t index, const char* what) {
+        double value = 0.0;
+        if (index >= fields.size() || !ParseSpecNumber(fields[index], value)) {
+            NS_FATAL_ERROR("Invalid key spec '" << spec << "': expected a number for " << what << ".");
+        }
+        return value;
+    };
+    auto keySpaceAt = [&](size_t index) {
+        const double keys = numberAt(index, "the key space size");
+        if (keys < 1.0 || keys != std::floor(keys)) {
+            NS_FATAL_ERROR("Invalid key spec '" << spec << "': the key space must be a positive integer.");
+        }
+        return static_cast<uint64_t>(keys);
+    };
+
+    Ptr<KeyGenerator> generator;
+    if (kind == "uniform") {
+        generator = CreateObject<UniformKeyGenerator>();
+        if (fields.size() > 1) {
+            generator->SetAttribute("KeySpace", UintegerValue(keySpaceAt(1)));
+        }
+    } else if (kind == "zipf") {
+        generator = CreateObject<ZipfKeyGenerator>();
+        generator->SetAttribute("KeySpace", UintegerValue(keySpaceAt(1)));
+        if (fields.size() > 2) {
+            generator->SetAttribute("Exponent", DoubleValue(numberAt(2, "the Zipf exponent")));
+        }
+    } else {
+        NS_FATAL_ERROR("Unknown key generator '" << kind << "' in spec '" << spec
+                       << "'. Supported: uniform, zipf.");
+    }
+    return generator;
+}
+
+} // namespace ns3
@@ -0,0 +1,162 @@
+#ifndef KEY_GENERATOR_H
+#define KEY_GENERATOR_H
+
+// NS-3 Includes
+#include "ns3/object.h"                 // Base class
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h" // For Ptr<UniformRandomVariable>
+
+// Standard Library Includes
+#include <cstdint> // For int64_t, uint64_t
+#include <string>
+
+namespace ns3 {
+
+/**
+ * @brief Abstract generator of request L7 identifiers (keys) for clients.
+ *
+ * A KeyGenerator decides *which* key a request carries, which is what the hash-based
+ * balancers (RingHash, Maglev) route on. Generators over a finite key space draw a rank
+ * and map it to a key with a fixed mixing function, so the same rank yields the same key
+ * in every client and every run: hot keys are shared by all clients. All randomness comes
+ * from ns-3 RandomVariableStream objects (see AssignStreams()).
+ */
+class KeyGenerator : public Object
+{
+  public:
+    /**
+     * @brief Gets the TypeId for this class.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    KeyGenerator();
+    virtual ~KeyGenerator() override;
+
+    /**
+     * @brief Draws the key of the next request.
+     * @return The 64-bit L7 identifier.
+     */
+    virtual uint64_t GetNextKey() = 0;
+
+    /**
+     * @brief Assigns fixed random variable stream numbers to the random variables used.
+     * @param stream First stream index to use.
+     * @return The number of stream indices assigned.
+     */
+    virtual int64_t AssignStreams(int64_t stream) = 0;
+
+    /**
+     * @brief Maps a key rank to its key (splitmix64 finalizer).
+     * The mapping is a bijection, so distinct ranks never collide, and it scatters
+     * neighbouring ranks across the whole 64-bit space (and thus across hash rings).
+     * @param rank The rank (1 = most popular for skewed generators).
+     * @return The key.
+     */
+    static uint64_t KeyForRank(uint64_t rank);
+};
+
+/**
+ * @brief Uniformly popular keys.
+ *
+ * With KeySpace = 0 (the default) every request gets an independent random 64-bit key,
+ * so keys practically never repeat. With KeySpace = N, keys are drawn uniformly from N
+ * fixed keys shared by all clients.
+ */
+class UniformKeyGenerator : public KeyGenerator
+{
+  public:
+    static TypeId GetTypeId();
+    UniformKeyGenerator();
+    virtual ~UniformKeyGenerator() override;
+
+    virtual uint64_t GetNextKey() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    uint64_t m_keySpace;                  //!< Number of distinct keys, 0 for the full 64-bit space (attribute).
+    Ptr<UniformRandomVariable> m_draw;    //!< Source of ranks / key bits.
+};
+
+/**
+ * @brief Zipf-distributed key popularity: the key of rank k is requested with
+ * probability proportional to 1 / k^Exponent.
+ *
+ * Sampling uses rejection-inversion (Hörmann & Derflinger, 1996): O(1) expected time and
+ * O(1) memory for any key space size, with no per-key tables. Exponent 0 is uniform;
+ * around 1 is typical of web and cache workloads; larger values concentrate the load on
+ * fewer hot keys. Ranks beyond 2^53 lose precision in the double arithmetic.
+ */
+class ZipfKeyGenerator : public KeyGenerator
+{
+  public:
+    static TypeId GetTypeId();
+    ZipfKeyGenerator();
+    virtual ~ZipfKeyGenerator() override;
+
+    virtual uint64_t GetNextKey() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+    /**
+     * @brief Draws a rank in [1, KeySpace].
+     * @return The rank (1 is the most popular).
+     */
+    uint64_t GetNextRank();
+
+  private:
+    /**
+     * @brief Precomputes the sampler constants after an attribute change.
+     */
+    void UpdateConstants();
+
+    /**
+     * @brief Unnormalized density h(x) = x^-Exponent.
+     * @param x The point (> 0).
+     * @return h(x).
+     */
+    double H(double x) const;
+
+    /**
+     * @brief Integral H(x) of h from 1 to x (log form for stability near Exponent = 1).
+     * @param x The point (> 0).
+     * @return H(x).
+     */
+    double HIntegral(double x) const;
+
+    /**
+     * @brief Inverse of HIntegral().
+     * @param x A value in the range of HIntegral().
+     * @return The point whose integral is @p x.
+     */
+    double HIntegralInverse(double x) const;
+
+    uint64_t m_keySpace;             //!< Number of distinct keys (attribute).
+    double m_exponent;               //!< Zipf exponent (attribute).
+
+    uint64_t m_constantsKeySpace;    //!< Key space the constants were computed for.
+    double m_constantsExponent;      //!< Exponent the constants were computed for.
+    double m_hIntegralX1;            //!< HIntegral(1.5) - 1.
+    double m_hIntegralKeySpace;      //!< HIntegral(KeySpace + 0.5).
+    double m_squeeze;                //!< Acceptance shortcut: 2 - HIntegralInverse(HIntegral(2.5) - h(2)).
+
+    Ptr<UniformRandomVariable> m_draw; //!< Source of uniform variates.
+};
+
+/**
+ * @brief Builds a KeyGenerator from a compact command-line spec.
+ *
+ * Supported specs (fields separated by ':'):
+ * - `uniform`                 Independent random 64-bit keys (the original behavior).
+ * - `uniform:keys`            Uniform over a fixed set of @c keys keys.
+ * - `zipf:keys[:exponent]`    Zipf over @c keys keys (exponent defaults to 1.0).
+ *
+ * Terminates the simulation with NS_FATAL_ERROR on an unknown or malformed spec.
+ *
+ * @param spec The spec string.
+ * @return The configured key generator.
+ */
+Ptr<KeyGenerator> CreateKeyGenerator(const std::string& spec);
+
+} // namespace ns3
+
+#endif // KEY_GENERATOR_H
@@ -10,14 +10,16 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
+#include "ns3/enum.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/core-module.h"    // For Ptr, ObjectFactory, TypeId, Callbacks, App basics
 #include "ns3/buffer.h"
 
 #include <string>
 #include <vector>
-#include <map>
-#include <random>
+#include <algorithm> // For std::max
 #include <limits>
 #include <cstdint> // Included via latency_client_app.h but good practice here too
 
@@ -47,6 +49,12 @@ LatencyClientApp::GetTypeId()
                           UintegerValue(0),
                           MakeUintegerAccessor(&LatencyClientApp::m_peerPort),
                           MakeUintegerChecker<uint16_t>())
+            .AddAttribute("Picker",
+                          "Backend picker for client-side load balancing. If set, the client "
+                          "connects to the picker's backends directly instead of to the remote address.",
+                          PointerValue(),
+                          MakePointerAccessor(&LatencyClientApp::m_picker),
+                          MakePointerChecker<LoadBalancerApp>())
             .AddAttribute("RequestCount",
                           "Number of requests to send (0 for continuous until stop time).",
                           UintegerValue(100),
@@ -57,6 +65,115 @@ LatencyClientApp::GetTypeId()
                           TimeValue(Seconds(1.0)),
                           MakeTimeAccessor(&LatencyClientApp::m_requestInterval),
                           MakeTimeChecker())
+            .AddAttribute("ArrivalProcess",
+                          "Generator of inter-arrival times between requests. "
+                          "If unset, requests are sent every RequestInterval.",
+                          PointerValue(),
+                          MakePointerAccessor(&LatencyClientApp::m_arrivalProcess),
+                          MakePointerChecker<ArrivalProcess>())
+            .AddAttribute("KeyGenerator",
+                          "Generator of request L7 identifiers. "
+                          "If unset, every request gets an independent random 64-bit key.",
+                          PointerValue(),
+                          MakePointerAccessor(&LatencyClientApp::m_keyGenerator),
+                          MakePointerChecker<KeyGenerator>())
+            .AddAttribute("RequestSizeDistribution",
+                          "Generator of request payload sizes. If unset, every request carries RequestSize bytes.",
+                          PointerValue(),
+                          MakePointerAccessor(&LatencyClientApp::m_requestSizes),
+                          MakePointerChecker<SizeDistribution>())
+            .AddAttribute("ResponseSizeDistribution",
+                          "Generator of the response payload sizes requested from the server. "
+                          "If unset, responses carry no payload.",
+                          PointerValue(),
+                          MakePointerAccessor(&LatencyClientApp::m_responseSizes),
+                          MakePointerChecker<SizeDistribution>())
+            .AddAttribute("FanOut",
+                          "Sub-requests per logical (scatter-gather) request; 1 disables fan-out.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&LatencyClientApp::m_fanOut),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("FanOutQuorum",
+                          "Sub-responses that complete a logical request (0 waits for all of them).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LatencyClientApp::m_fanOutQuorum),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Concurrency",
+                          "Closed-loop mode: number of requests kept outstanding. "
+                          "0 selects open-loop mode driven by ArrivalProcess/RequestInterval.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LatencyClientApp::m_concurrency),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ThinkTime",
+                          "Closed-loop mode: random variable giving the delay (seconds) between "
+                          "receiving a response and issuing the next request in its slot.",
+                          StringValue("ns3::ConstantRandomVariable[Constant=0.0]"),
+                          MakePointerAccessor(&LatencyClientApp::m_thinkTime),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("TraceFile",
+                          "Binary request trace to replay (empty to synthesize requests).",
+                          StringValue(""),
+                          MakeStringAccessor(&LatencyClientApp::m_traceFile),
+                          MakeStringChecker())
+            .AddAttribute("TraceShardIndex",
+                          "Shard of the trace replayed by this client.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LatencyClientApp::m_traceShardIndex),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("TraceShardCount",
+                          "Number of shards the trace is split into (records are dealt round-robin).",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&LatencyClientApp::m_traceShardCount),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("HistogramPrecision",
+                          "Significant decimal digits preserved by the latency histogram (1-5).",
+                          UintegerValue(3),
+                          MakeUintegerAccessor(&LatencyClientApp::m_histogramPrecision),
+                          MakeUintegerChecker<uint32_t>(1, 5))
+            .AddAttribute("HistogramHighestLatency",
+                          "Largest latency tracked at full precision by the latency histogram.",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&LatencyClientApp::m_histogramHighestLatency),
+                          MakeTimeChecker())
+            .AddAttribute("TimeSeriesWindow",
+                          "Width of the windows of the latency/throughput time series (0 disables it).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&LatencyClientApp::m_timeSeriesWindow),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("Connections",
+                          "Number of parallel TCP connections to the remote peer.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&LatencyClientApp::m_connectionCount),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ConnectionSpreading",
+                          "How requests are spread over the connections.",
+                          EnumValue(LatencyClientApp::ROUND_ROBIN),
+                          MakeEnumAccessor<ConnectionSpreading>(&LatencyClientApp::m_spreading),
+                          MakeEnumChecker(LatencyClientApp::ROUND_ROBIN, "RoundRobin",
+                                          LatencyClientApp::LEAST_OUTSTANDING, "LeastOutstanding"))
+            .AddAttribute("ReconnectDelay",
+                          "Delay before re-establishing a connection that closed or failed.",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&LatencyClientApp::m_reconnectDelay),
+                          MakeTimeChecker())
+            .AddAttribute("Timeout",
+                          "Time after which an unanswered request is given up and counted as "
+                          "timed out (0 disables timeouts).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&LatencyClientApp::m_timeout),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("LatencySlo",
+                          "Responses at or below this latency count toward goodput "
+                          "(0 counts every response received before its timeout).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&LatencyClientApp::m_latencySlo),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("DeadlineBudget",
+                          "Time budget of each request from its send time, carried in its header as an "
+                          "absolute deadline that the load balancer and servers enforce (0 = no deadline).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&LatencyClientApp::m_deadlineBudget),
+                          MakeTimeChecker(Seconds(0)))
             .AddAttribute("RequestSize",
                           "Size of the request payload (bytes).",
                           UintegerValue(100),
@@ -66,18 +183,55 @@ LatencyClientApp::GetTypeId()
 }
 
 LatencyClientApp::LatencyClientApp()
-    : m_socket(nullptr),
+    : m_connectionCount(1),
+      m_spreading(ROUND_ROBIN),
+      m_reconnectDelay(MilliSeconds(100)),
+      m_nextConnection(0),
+      m_picker(nullptr),
+      m_closing(false),
       m_peerPort(0), // Will be set by attribute or SetRemote
       m_requestSize(0), // Will be set by attribute
       m_requestCount(0), // Will be set by attribute
       m_requestInterval(Seconds(0)), // Will be set by attribute
+      m_arrivalProcess(nullptr),
+      m_concurrency(0),
+      m_thinkTime(nullptr),
+      m_keyGenerator(nullptr),
+      m_requestSizes(nullptr),
+      m_responseSizes(nullptr),
+      m_fanOut(1),
+      m_fanOutQuorum(0),
+      m_traceShardIndex(0),
+      m_traceShardCount(1),
+      m_traceReader(nullptr),
+      m_traceRecord(),
+      m_haveTraceRecord(false),
+      m_traceExhausted(false),
       m_seqCounter(0),
       m_requestsSent(0),
       m_responsesReceived(0),
+      m_requestsAbandoned(0),
+      m_sendFailures(0),
+      m_requestsTimedOut(0),
+      m_requestsRejected(0),
+      m_lateResponses(0),
+      m_requestsDeadlineExceeded(0),
+      m_responsesPastDeadline(0),
+      m_responsesWithinSlo(0),
+      m_bytesSent(0),
+      m_bytesReceived(0),
+      m_logicalCounter(0),
+      m_logicalCompleted(0),
+      m_logicalFailed(0),
+      m_idleSlots(0),
+      m_openLoopStarted(false),
       m_running(false),
-      m_connected(false),
-      m_rng(std::random_device{}() + static_cast<uint64_t>(Simulator::GetContext())),
-      m_dist(0, std::numeric_limits<uint64_t>::max())
+      m_timeout(Seconds(0)),
+      m_latencySlo(Seconds(0)),
+      m_deadlineBudget(Seconds(0)),
+      m_histogramPrecision(3),
+      m_histogramHighestLatency(Seconds(60)),
+      m_timeSeriesWindow(Seconds(0))
 {
     NS_LOG_FUNCTION(this);
     // m_peerIpv4Address is default constructed by Ipv4Address()
@@ -86,7 +240,7 @@ LatencyClientApp::LatencyClientApp()
 LatencyClientApp::~LatencyClientApp()
 {
     NS_LOG_FUNCTION(this);
-    m_socket = nullptr;
+    m_connections.clear();
 }
 
 void
@@ -126,23 +280,262 @@ LatencyClientApp::SetRequestSize(uint32_t size)
     m_requestSize = size;
 }
 
-const std::vector<Time>&
-LatencyClientApp::GetLatencies() const
+void
+LatencyClientApp::SetTrace(const std::string& path, uint32_t shardIndex, uint32_t shardCount)
+{
+    NS_LOG_FUNCTION(this << path << shardIndex << shardCount);
+    m_traceFile = path;
+    m_traceShardIndex = shardIndex;
+    m_traceShardCount = shardCount;
+}
+
+void
+LatencyClientApp::SetConcurrency(uint32_t concurrency)
+{
+    NS_LOG_FUNCTION(this << concurrency);
+    m_concurrency = concurrency;
+}
+
+void
+LatencyClientApp::SetPicker(Ptr<LoadBalancerApp> picker)
+{
+    NS_LOG_FUNCTION(this << picker);
+    m_picker = picker;
+}
+
+void
+LatencyClientApp::SetArrivalProcess(Ptr<ArrivalProcess> process)
+{
+    NS_LOG_FUNCTION(this << process);
+    m_arrivalProcess = process;
+}
+
+void
+LatencyClientApp::SetKeyGenerator(Ptr<KeyGenerator> generator)
+{
+    NS_LOG_FUNCTION(this << generator);
+    m_keyGenerator = generator;
+}
+
+void
+LatencyClientApp::EnsureKeyGenerator()
+{
+    if (!m_keyGenerator) {
+        m_keyGenerator = CreateObject<UniformKeyGenerator>();
+    }
+}
+
+void
+LatencyClientApp::SetRequestSizeDistribution(Ptr<SizeDistribution> sizes)
 {
-    return m_latencies;
+    NS_LOG_FUNCTION(this << sizes);
+    m_requestSizes = sizes;
+}
+
+void
+LatencyClientApp::SetResponseSizeDistribution(Ptr<SizeDistribution> sizes)
+{
+    NS_LOG_FUNCTION(this << sizes);
+    m_responseSizes = sizes;
+}
+
+int64_t
+LatencyClientApp::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    EnsureKeyGenerator();
+    int64_t used = m_keyGenerator->AssignStreams(stream);
+    if (m_thinkTime) {
+        m_thinkTime->SetStream(stream + used);
+        used++;
+    }
+    if (m_arrivalProcess) {
+        used += m_arrivalProcess->AssignStreams(stream + used);
+    }
+    if (m_requestSizes) {
+        used += m_requestSizes->AssignStreams(stream + used);
+    }
+    if (m_responseSizes) {
+        used += m_responseSizes->AssignStreams(stream + used);
+    }
+    if (m_picker) {
+        used += m_picker->AssignStreams(stream + used);
+    }
+    return used;
+}
+
+const LatencyHistogram&
+LatencyClientApp::GetLatencyHistogram() const
+{
+    return m_latencyHistogram;
+}
+
+const LatencyHistogram&
+LatencyClientApp::GetCorrectedLatencyHistogram() const
+{
+    return m_correctedHistogram;
+}
+
+const LatencyHistogram&
+LatencyClientApp::GetLogicalLatencyHistogram() const
+{
+    return m_logicalHistogram;
+}
+
+const LatencyHistogram&
+LatencyClientApp::GetLogicalCorrectedLatencyHistogram() const
+{
+    return m_logicalCorrectedHistogram;
+}
+
+uint32_t
+LatencyClientApp::GetLogicalRequestsCompleted() const
+{
+    return m_logicalCompleted;
+}
+
+uint32_t
+LatencyClientApp::GetLogicalRequestsFailed() const
+{
+    return m_logicalFailed;
+}
+
+const LatencyTimeSeries*
+LatencyClientApp::GetLatencyTimeSeries() const
+{
+    return m_timeSeries.get();
+}
+
+uint32_t
+LatencyClientApp::GetResponsesReceived() const
+{
+    return m_responsesReceived;
+}
+
+uint32_t
+LatencyClientApp::GetRequestsAbandoned() const
+{
+    return m_requestsAbandoned;
+}
+
+uint32_t
+LatencyClientApp::GetSendFailures() const
+{
+    return m_sendFailures;
+}
+
+uint32_t
+LatencyClientApp::GetRequestsSent() const
+{
+    return m_requestsSent;
+}
+
+uint32_t
+LatencyClientApp::GetRequestsTimedOut() const
+{
+    return m_requestsTimedOut;
+}
+
+uint32_t
+LatencyClientApp::GetRequestsRejected() const
+{
+    return m_requestsRejected;
+}
+
+uint32_t
+LatencyClientApp::GetLateResponses() const
+{
+    return m_lateResponses;
+}
+
+uint32_t
+LatencyClientApp::GetRequestsDeadlineExceeded() const
+{
+    return m_requestsDeadlineExceeded;
+}
+
+uint32_t
+LatencyClientApp::GetResponsesPastDeadline() const
+{
+    return m_responsesPastDeadline;
+}
+
+uint32_t
+LatencyClientApp::GetResponsesWithinSlo() const
+{
+    return m_responsesWithinSlo;
+}
+
+double
+LatencyClientApp::GetAchievedRps() const
+{
+    const double activeS = (m_lastResponseTime - m_firstSendTime).GetSeconds();
+    if (m_responsesReceived == 0 || activeS <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(m_responsesReceived) / activeS;
+}
+
+uint64_t
+LatencyClientApp::GetBytesSent() const
+{
+    return m_bytesSent;
+}
+
+uint64_t
+LatencyClientApp::GetBytesReceived() const
+{
+    return m_bytesReceived;
+}
+
+double
+LatencyClientApp::GetReceiveThroughput() const
+{
+    const double activeS = (m_lastResponseTime - m_firstSendTime).GetSeconds();
+    if (m_bytesReceived == 0 || activeS <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(m_bytesReceived) / activeS;
+}
+
+double
+LatencyClientApp::GetSendThroughput() const
+{
+    const double activeS = (m_lastResponseTime - m_firstSendTime).GetSeconds();
+    if (m_bytesSent == 0 || activeS <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(m_bytesSent) / activeS;
+}
+
+double
+LatencyClientApp::GetGoodput() const
+{
+    const double activeS = (m_lastResponseTime - m_firstSendTime).GetSeconds();
+    if (m_responsesWithinSlo == 0 || activeS <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(m_responsesWithinSlo) / activeS;
 }
 
 void
 LatencyClientApp::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    if (m_socket) {
-        m_socket->Close();
-        m_socket = nullptr;
-    }
-    m_connected = false;
     m_running = false;
+    CloseConnections();
+    m_connections.clear();
     Simulator::Cancel(m_sendEvent);
+    Simulator::Cancel(m_closeEvent);
+    Simulator::Cancel(m_timeoutEvent);
+    m_deadlines.clear();
+    m_arrivalProcess = nullptr;
+    m_thinkTime = nullptr;
+    m_keyGenerator = nullptr;
+    m_requestSizes = nullptr;
+    m_responseSizes = nullptr;
+    m_picker = nullptr;
+    m_traceReader.reset();
     Application::DoDispose();
 }
 
@@ -153,26 +546,90 @@ LatencyClientApp::StartApplication()
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s LatencyClientApp on Node " << GetNode()->GetId() << " starting.");
 
     m_running = true;
+    m_closing = false;
     m_requestsSent = 0;
     m_responsesReceived = 0;
+    m_requestsAbandoned = 0;
+    m_sendFailures = 0;
+    m_requestsTimedOut = 0;
+    m_requestsRejected = 0;
+    m_lateResponses = 0;
+    m_requestsDeadlineExceeded = 0;
+    m_responsesPastDeadline = 0;
+    m_responsesWithinSlo = 0;
+    m_bytesSent = 0;
+    m_bytesReceived = 0;
+    m_logicalCounter = 0;
+    m_logicalCompleted = 0;
+    m_logicalFailed = 0;
     m_seqCounter = 0;
-    m_latencies.clear();
-    m_sentTimes.clear();
-    m_rxBuffer.clear();
+    m_idleSlots = m_concurrency;
+    m_openLoopStarted = false;
+    m_latencyHistogram = LatencyHistogram(m_histogramHighestLatency, m_histogramPrecision);
+    m_correctedHistogram = LatencyHistogram(m_histogramHighestLatency, m_histogramPrecision);
+    m_logicalHistogram = LatencyHistogram(m_histogramHighestLatency, m_histogramPrecision);
+    m_logicalCorrectedHistogram = LatencyHistogram(m_histogramHighestLatency, m_histogramPrecision);
+    m_timeSeries.reset();
+    if (m_timeSeriesWindow.IsStrictlyPositive()) {
+        m_timeSeries = std::make_unique<LatencyTimeSeries>(m_timeSeriesWindow, m_histogramHighestLatency);
+    }
+    m_sentTimes.Clear();
+    m_logicalRequests.Clear();
+    m_deadlines.clear();
+    m_firstSendTime = Seconds(0);
+    m_lastResponseTime = Seconds(0);
+
+    if (!m_arrivalProcess) {
+        Ptr<ConstantArrivalProcess> periodic = CreateObject<ConstantArrivalProcess>();
+        periodic->SetAttribute("Interval", TimeValue(m_requestInterval));
+        m_arrivalProcess = periodic;
+    }
+    m_arrivalProcess->Reset();
+    EnsureKeyGenerator();
+
+    m_traceReader.reset();
+    m_haveTraceRecord = false;
+    m_traceExhausted = false;
+    if (!m_traceFile.empty()) {
+        m_traceReader = std::make_unique<TraceReader>();
+        if (!m_traceReader->Open(m_traceFile, m_traceShardIndex, m_traceShardCount)) {
+            NS_FATAL_ERROR("Client (Node " << GetNode()->GetId() << ") cannot replay trace '" << m_traceFile << "'");
+        }
+    }
+    if (m_fanOut > 1 && m_traceReader) {
+        NS_FATAL_ERROR("Client (Node " << GetNode()->GetId() << "): FanOut cannot be combined with trace replay.");
+    }
+    if (m_fanOutQuorum > m_fanOut) {
+        NS_FATAL_ERROR("Client (Node " << GetNode()->GetId() << "): FanOutQuorum " << m_fanOutQuorum
+                       << " exceeds FanOut " << m_fanOut << ".");
+    }
 
-    if (m_peerIpv4Address == Ipv4Address() || m_peerIpv4Address == Ipv4Address::GetAny() || m_peerPort == 0) {
+    m_peers.clear();
+    if (m_picker) {
+        for (const BackendInfo& backend : m_picker->GetBackends()) {
+            m_peers.push_back(backend.address);
+        }
+        if (m_peers.empty()) {
+            NS_FATAL_ERROR("Client (Node " << GetNode()->GetId() << ") has a picker without backends.");
+        }
+    } else if (m_peerIpv4Address == Ipv4Address() || m_peerIpv4Address == Ipv4Address::GetAny() || m_peerPort == 0) {
         NS_LOG_ERROR("Client (Node " << GetNode()->GetId() << ") has invalid remote IP/port. Stopping. Addr: "
                       << m_peerIpv4Address << " Port: " << m_peerPort);
         m_running = false;
         return;
+    } else {
+        m_peers.emplace_back(m_peerIpv4Address, m_peerPort);
     }
 
-    if (!m_socket)
+    // Slots [p * Connections, (p + 1) * Connections) belong to peer p.
+    m_connections.assign(m_connectionCount * m_peers.size(), Connection());
+    m_nextConnection = 0;
+    m_peerCursors.assign(m_peers.size(), 0);
+    for (uint32_t i = 0; i < m_connections.size(); ++i)
     {
-        SetupSocket();
+        m_connections[i].peer = i / m_connectionCount;
+        OpenConnection(i);
     }
-
-    Connect();
 }
 
 void
@@ -188,73 +645,178 @@ LatencyClientApp::StopApplication()
         NS_LOG_DEBUG("Cancelling pending send event during StopApplication.");
         Simulator::Cancel(m_sendEvent);
     }
+    Simulator::Cancel(m_timeoutEvent);
 
-    if (m_socket) // Check if socket exists before trying to close
-    {
-        NS_LOG_DEBUG("Closing client socket during StopApplication (if connected or exists).");
-        m_socket->Close();
-        // m_connected will be set to false by HandleClose or HandleError callbacks
-    }
-
+    NS_LOG_DEBUG("Closing client connections during StopApplication.");
+    CloseConnections();
 
     NS_LOG_INFO("Client (Node " << GetNode()->GetId() << ") Summary: Requests Sent=" << m_requestsSent
                   << ", Responses Received=" << m_responsesReceived
-                  << ", Latencies Recorded=" << m_latencies.size());
+                  << ", Requests Abandoned=" << m_requestsAbandoned
+                  << ", Send Failures=" << m_sendFailures
+                  << ", Timed Out=" << m_requestsTimedOut
+                  << ", Rejected=" << m_requestsRejected
+                  << ", Late Responses=" << m_lateResponses
+                  << ", Deadline Exceeded=" << m_requestsDeadlineExceeded
+                  << ", Latencies Recorded=" << m_latencyHistogram.GetCount()
+                  << ", Achieved RPS=" << GetAchievedRps());
 }
 
 void
-LatencyClientApp::SetupSocket()
+LatencyClientApp::OpenConnection(uint32_t index)
 {
-    NS_LOG_FUNCTION(this);
-    if (m_socket == nullptr) {
-        m_socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
-        if (!m_socket) {
-            NS_FATAL_ERROR("Failed to create client socket on Node " << GetNode()->GetId());
-            // NS_FATAL_ERROR will terminate, so return is not strictly needed but good form.
-            return;
+    NS_LOG_FUNCTION(this << index);
+    if (!m_running || m_closing) {
+        return;
+    }
+
+    Ptr<Socket> socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
+    if (!socket) {
+        NS_FATAL_ERROR("Failed to create client socket on Node " << GetNode()->GetId());
+        // NS_FATAL_ERROR will terminate, so return is not strictly needed but good form.
+        return;
+    }
+
+    socket->SetConnectCallback(MakeCallback(&LatencyClientApp::ConnectionSucceeded, this),
+                               MakeCallback(&LatencyClientApp::ConnectionFailed, this));
+    socket->SetCloseCallbacks(MakeCallback(&LatencyClientApp::HandleClose, this),
+                              MakeCallback(&LatencyClientApp::HandleError, this));
+    socket->SetRecvCallback(MakeCallback(&LatencyClientApp::HandleRead, this));
+    socket->SetSendCallback(MakeCallback(&LatencyClientApp::HandleSend, this));
+
+    Connection& conn = m_connections[index];
+    conn.socket = socket;
+    conn.connected = false;
+    conn.outstanding = 0;
+    conn.rxBuffer.clear();
+    conn.txQueue.Clear();
+
+    const InetSocketAddress& remoteAddress = m_peers[conn.peer];
+    NS_LOG_INFO("Client (Node " << GetNode()->GetId() << ") connection " << index
+                  << " attempting to connect to " << remoteAddress);
+    socket->Connect(remoteAddress);
+}
+
+int32_t
+LatencyClientApp::FindConnection(Ptr<Socket> socket) const
+{
+    for (uint32_t i = 0; i < m_connections.size(); ++i) {
+        if (m_connections[i].socket == socket) {
+            return static_cast<int32_t>(i);
         }
+    }
+    return -1;
+}
 
-        m_socket->SetConnectCallback(MakeCallback(&LatencyClientApp::ConnectionSucceeded, this),
-                                     MakeCallback(&LatencyClientApp::ConnectionFailed, this));
-        m_socket->SetCloseCallbacks(MakeCallback(&LatencyClientApp::HandleClose, this),
-                                    MakeCallback(&LatencyClientApp::HandleError, this));
-        m_socket->SetRecvCallback(MakeCallback(&LatencyClientApp::HandleRead, this));
-        m_socket->SetSendCallback(MakeCallback(&LatencyClientApp::HandleSend, this));
+int32_t
+LatencyClientApp::FindPeer(const InetSocketAddress& address) const
+{
+    for (uint32_t i = 0; i < m_peers.size(); ++i) {
+        if (m_peers[i] == address) {
+            return static_cast<int32_t>(i);
+        }
     }
+    return -1;
 }
 
+int32_t
+LatencyClientApp::PickConnection(uint64_t l7Identifier)
+{
+    if (m_picker) {
+        InetSocketAddress chosenBackend(Ipv4Address::GetAny(), 0);
+        if (m_picker->PickBackend(l7Identifier, chosenBackend)) {
+            const int32_t peer = FindPeer(chosenBackend);
+            if (peer >= 0) {
+                const int32_t index = PickConnectionIn(peer * m_connectionCount, m_connectionCount, m_peerCursors[peer]);
+                if (index >= 0) {
+                    return index;
+                }
+            }
+        }
+        NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): Picked backend " << chosenBackend
+                       << " has no established connection; using another backend.");
+    }
+    return PickConnectionIn(0, static_cast<uint32_t>(m_connections.size()), m_nextConnection);
+}
 
-void LatencyClientApp::Connect() {
-    NS_LOG_FUNCTION(this);
-    if (!m_socket) {
-        NS_LOG_ERROR("Connect called on Node " << GetNode()->GetId() << " but socket is null. Attempting setup.");
-        SetupSocket(); // Try to set it up if null
-        if(!m_socket) { // If still null after setup attempt
-             NS_LOG_ERROR("Socket setup failed in Connect() for Node " << GetNode()->GetId() << ". Cannot connect.");
-             return;
+int32_t
+LatencyClientApp::PickConnectionIn(uint32_t first, uint32_t count, uint32_t& cursor) const
+{
+    int32_t chosen = -1;
+    // Scanning from the round-robin cursor also spreads least-outstanding ties.
+    for (uint32_t k = 0; k < count; ++k) {
+        const uint32_t i = first + (cursor + k) % count;
+        const Connection& conn = m_connections[i];
+        if (!conn.connected) {
+            continue;
+        }
+        if (m_spreading == ROUND_ROBIN) {
+            chosen = static_cast<int32_t>(i);
+            break;
+        }
+        if (chosen < 0 || conn.outstanding < m_connections[chosen].outstanding) {
+            chosen = static_cast<int32_t>(i);
         }
     }
-    if (m_connected) { // Or if a connection attempt is already in progress
-        NS_LOG_WARN("Connect called on Node " << GetNode()->GetId() << " but already connected or connecting.");
-        return;
+    if (chosen >= 0) {
+        cursor = (static_cast<uint32_t>(chosen) - first + 1) % count;
+    }
+    return chosen;
+}
+
+void
+LatencyClientApp::ReportFinished(uint32_t connection)
+{
+    if (m_picker) {
+        m_picker->ReportRequestFinished(m_peers[m_connections[connection].peer]);
     }
+}
 
-    InetSocketAddress remoteAddress(m_peerIpv4Address, m_peerPort);
-    NS_LOG_INFO("Client (Node " << GetNode()->GetId() << ") attempting to connect to " << remoteAddress);
-    m_socket->Connect(remoteAddress);
+bool
+LatencyClientApp::AnyConnected() const
+{
+    return std::any_of(m_connections.begin(), m_connections.end(),
+                       [](const Connection& conn) { return conn.connected; });
 }
 
 void
 LatencyClientApp::ConnectionSucceeded(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
-    InetSocketAddress remoteAddress(m_peerIpv4Address, m_peerPort);
+    const int32_t index = FindConnection(socket);
+    if (index < 0) {
+        return;
+    }
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Client (Node " << GetNode()->GetId()
-                  << ") connection SUCCEEDED to " << remoteAddress);
-    m_connected = true;
+                  << ") connection " << index << " SUCCEEDED to " << m_peers[m_connections[index].peer]);
+    m_connections[index].connected = true;
+
+    if (!m_running) {
+        return;
+    }
 
-    if (m_running) {
-        Simulator::ScheduleNow(&LatencyClientApp::SendRequestPacket, this);
+    if (m_concurrency > 0) {
+        // Closed loop: issue every slot that has been waiting for a connection.
+        const uint32_t slots = m_idleSlots;
+        m_idleSlots = 0;
+        for (uint32_t i = 0; i < slots; ++i) {
+            Simulator::ScheduleNow(&LatencyClientApp::SendRequestPacket, this);
+        }
+    } else if (!m_openLoopStarted) {
+        m_openLoopStarted = true;
+        m_traceBase = Simulator::Now();
+        m_nextIntendedSend = Simulator::Now();
+        if (m_traceReader) {
+            // Open-loop replay: the first request goes out at its recorded offset.
+            ScheduleNextRequest();
+        } else {
+            m_sendEvent = Simulator::ScheduleNow(&LatencyClientApp::SendRequestPacket, this);
+        }
+    } else if (!m_sendEvent.IsPending()) {
+        // All connections had been lost. The schedule kept running meanwhile: send the
+        // pending request now, and the ones whose slots passed follow back to back.
+        m_sendEvent = Simulator::Schedule(std::max(m_nextIntendedSend - Simulator::Now(), Seconds(0)),
+                                          &LatencyClientApp::SendRequestPacket, this);
     }
 }
 
@@ -262,10 +824,14 @@ void
 LatencyClientApp::ConnectionFailed(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
-    InetSocketAddress remoteAddress(m_peerIpv4Address, m_peerPort);
+    const int32_t index = FindConnection(socket);
+    if (index < 0) {
+        return;
+    }
     NS_LOG_ERROR(Simulator::Now().GetSeconds() << "s Client (Node " << GetNode()->GetId()
-                   << ") connection FAILED to " << remoteAddress << ". Errno: " << socket->GetErrno()); // Corrected
-    m_connected = false;
+                   << ") connection FAILED to " << m_peers[m_connections[index].peer]
+                   << ". Errno: " << socket->GetErrno());
+    HandleConnectionLoss(index);
 }
 
 void
@@ -273,10 +839,9 @@ LatencyClientApp::HandleClose(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Client (Node " << GetNode()->GetId() << ") socket closed (normal).");
-    m_connected = false;
-    if (m_sendEvent.IsPending())
-    {
-        Simulator::Cancel(m_sendEvent);
+    const int32_t index = FindConnection(socket);
+    if (index >= 0) {
+        HandleConnectionLoss(index);
     }
 }
 
@@ -286,17 +851,105 @@ LatencyClientApp::HandleError(Ptr<Socket> socket)
     NS_LOG_FUNCTION(this << socket);
     NS_LOG_WARN(Simulator::Now().GetSeconds() << "s Client (Node " << GetNode()->GetId()
                   << ") socket error. Errno: " << socket->GetErrno()); // Corrected
-    m_connected = false;
-    if (m_sendEvent.IsPending())
-    {
-        Simulator::Cancel(m_sendEvent);
-    }
-    if (m_socket && m_socket->GetErrno() != Socket::ERROR_SHUTDOWN && m_socket->GetErrno() != Socket::ERROR_NOTCONN) {
+    if (socket->GetErrno() != Socket::ERROR_SHUTDOWN && socket->GetErrno() != Socket::ERROR_NOTCONN) {
         // Avoid re-closing if already shut down or not connected,
         // as Close() might have its own side effects or state checks.
         // Check GetErrno specifically to decide if Close is appropriate.
         // If error implies connection is terminally gone, Close() is mostly for resource cleanup.
-        m_socket->Close();
+        socket->Close();
+    }
+    const int32_t index = FindConnection(socket);
+    if (index >= 0) {
+        HandleConnectionLoss(index);
+    }
+}
+
+void
+LatencyClientApp::HandleConnectionLoss(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    Connection& conn = m_connections[index];
+    conn.connected = false;
+    conn.socket = nullptr; // Late callbacks from the old socket no longer match this slot.
+    conn.rxBuffer.clear();
+    conn.txQueue.Clear();
+
+    // Requests still outstanding on this connection can no longer be answered.
+    std::vector<std::pair<uint64_t, uint64_t>> abandoned; // <seq, group>
+    if (conn.outstanding > 0) {
+        m_sentTimes.ForEachLive([&abandoned, index](uint64_t seq, InFlightRequest& request) {
+            if (request.connection == index) {
+                abandoned.emplace_back(seq, request.group);
+            }
+        });
+    }
+    conn.outstanding = 0;
+    uint32_t freedSlots = 0;
+    for (const auto& [seq, group] : abandoned) {
+        m_sentTimes.MarkTombstone(seq);
+        if (m_picker) {
+            m_picker->ReportBackendFailure(m_peers[conn.peer]);
+        }
+        ReportFinished(index);
+        if (ResolveRequest(group, false)) {
+            freedSlots++;
+        }
+    }
+    m_requestsAbandoned += abandoned.size();
+    if (!abandoned.empty()) {
+        NS_LOG_WARN("Client (Node " << GetNode()->GetId() << "): connection " << index << " lost with "
+                      << abandoned.size() << " requests outstanding.");
+    }
+
+    if (!AnyConnected() && m_sendEvent.IsPending())
+    {
+        Simulator::Cancel(m_sendEvent);
+    }
+
+    if (!m_running || m_closing) {
+        return;
+    }
+
+    NS_LOG_INFO("Client (Node " << GetNode()->GetId() << "): reconnecting connection " << index
+                  << " in " << m_reconnectDelay.GetSeconds() << "s.");
+    conn.reconnectEvent = Simulator::Schedule(m_reconnectDelay, &LatencyClientApp::OpenConnection, this, index);
+
+    if (m_concurrency > 0) {
+        // Reissue the lost slots, on another connection if one is up.
+        for (uint32_t i = 0; i < freedSlots; ++i) {
+            ScheduleClosedLoopRequest();
+        }
+        if (freedSlots == 0 && !abandoned.empty() && RequestBudgetExhausted()) {
+            ScheduleClosedLoopRequest(); // Lets the loop close once the last straggler is gone.
+        }
+    }
+}
+
+void
+LatencyClientApp::ScheduleCloseConnections()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_closing || m_closeEvent.IsPending()) {
+        return;
+    }
+    // Give the last requests a chance to be answered or to time out.
+    Time closeDelay = std::max(Seconds(0.5), m_timeout);
+    NS_LOG_INFO("Client (Node " << GetNode()->GetId() << "): All " << m_requestsSent
+                  << " requests sent. Scheduling connection close in " << closeDelay.GetSeconds() << "s.");
+    m_closeEvent = Simulator::Schedule(closeDelay, &LatencyClientApp::CloseConnections, this);
+}
+
+void
+LatencyClientApp::CloseConnections()
+{
+    NS_LOG_FUNCTION(this);
+    m_closing = true;
+    for (Connection& conn : m_connections) {
+        Simulator::Cancel(conn.reconnectEvent);
+        if (conn.socket) {
+            conn.socket->Close();
+            // conn state is reset by the HandleClose or HandleError callbacks.
+        }
     }
 }
 
@@ -306,15 +959,28 @@ LatencyClientApp::HandleSend(Ptr<Socket> socket, uint32_t availableBytes)
     NS_LOG_FUNCTION(this << socket << availableBytes);
     NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << ") HandleSend: "
                    << availableBytes << " bytes available in send buffer.");
+    const int32_t index = FindConnection(socket);
+    if (index < 0 || !m_connections[index].txQueue.HasPending()) {
+        return;
+    }
+    if (!m_connections[index].txQueue.Flush(socket)) {
+        NS_LOG_WARN("Client (Node " << GetNode()->GetId() << "): Error sending queued request bytes on connection "
+                      << index << ". Errno: " << socket->GetErrno());
+    }
 }
 
 void
 LatencyClientApp::HandleRead(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
+    const int32_t index = FindConnection(socket);
+    if (index < 0) {
+        NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << ") HandleRead on a stale socket; ignoring.");
+        return;
+    }
+    std::string& rxBuffer = m_connections[index].rxBuffer;
     Ptr<Packet> packet;
     Address from;
-    const uint32_t headerSize = RequestResponseHeader().GetSerializedSize();
 
     while ((packet = socket->RecvFrom(from)))
     {
@@ -327,15 +993,19 @@ LatencyClientApp::HandleRead(Ptr<Socket> socket)
 
         std::string received_chunk(packet->GetSize(), '\0');
         packet->CopyData(reinterpret_cast<uint8_t*>(received_chunk.data()), packet->GetSize());
-        m_rxBuffer.append(received_chunk);
+        rxBuffer.append(received_chunk);
 
         NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << ") HandleRead: Received "
-                       << packet->GetSize() << " bytes. Buffer size: " << m_rxBuffer.size());
+                       << packet->GetSize() << " bytes. Buffer size: " << rxBuffer.size());
 
-        while (m_rxBuffer.size() >= headerSize)
+        while (rxBuffer.size() >= RequestResponseHeader::PREFIX_SIZE)
         {
+            const uint32_t headerSize = RequestResponseHeader::PeekSerializedSize(reinterpret_cast<const uint8_t*>(rxBuffer.data()));
+            if (rxBuffer.size() < headerSize) {
+                break; // Header extensions still incomplete.
+            }
             Ptr<Packet> headerPeekPacket = Create<Packet>(
-                reinterpret_cast<const uint8_t*>(m_rxBuffer.data()),
+                reinterpret_cast<const uint8_t*>(rxBuffer.data()),
                 headerSize);
 
             RequestResponseHeader respHeader;
@@ -348,38 +1018,102 @@ LatencyClientApp::HandleRead(Ptr<Socket> socket)
             uint32_t expectedResponsePayloadSize = respHeader.GetPayloadSize();
             uint32_t expectedTotalSize = headerSize + expectedResponsePayloadSize;
 
-            if (m_rxBuffer.size() >= expectedTotalSize)
+            if (rxBuffer.size() >= expectedTotalSize)
             {
                 NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << ") HandleRead: Processing complete response. Seq="
                                << respHeader.GetSeq() << ", Expected total size=" << expectedTotalSize);
 
-                auto it = m_sentTimes.find(respHeader.GetSeq());
-                if (it != m_sentTimes.end())
+                const InFlightRequest* request = m_sentTimes.Find(respHeader.GetSeq());
+                if (request && respHeader.GetStatus() != RequestResponseHeader::STATUS_OK)
                 {
-                    Time sendTime = it->second;
-                    Time latency = Simulator::Now() - sendTime;
-                    m_latencies.push_back(latency);
-                    m_sentTimes.erase(it);
+                    // Shed, or failed for its deadline: a failure, but a fast one, so it is not a latency sample.
+                    const bool expired = (respHeader.GetStatus() == RequestResponseHeader::STATUS_DEADLINE_EXCEEDED);
+                    Time latency = Simulator::Now() - request->sendTime;
+                    Connection& conn = m_connections[request->connection];
+                    if (conn.outstanding > 0) {
+                        conn.outstanding--;
+                    }
+                    if (m_picker && expired) {
+                        m_picker->ReportBackendDeadlineMiss(m_peers[conn.peer], latency);
+                    } else if (m_picker) {
+                        m_picker->ReportBackendRejection(m_peers[conn.peer], latency);
+                    }
+                    ReportFinished(request->connection);
+                    const bool slotFreed = ResolveRequest(request->group, false);
+                    m_sentTimes.Erase(respHeader.GetSeq());
+                    if (expired) {
+                        m_requestsDeadlineExceeded++;
+                    } else {
+                        m_requestsRejected++;
+                    }
+                    NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Client (Node " << GetNode()->GetId()
+                                  << "): Request Seq=" << respHeader.GetSeq()
+                                  << (expired ? " failed its deadline after " : " rejected after ")
+                                  << latency.GetMilliSeconds() << "ms");
+                    if (m_concurrency > 0 && (slotFreed || RequestBudgetExhausted())) {
+                        ScheduleClosedLoopRequest();
+                    }
+                }
+                else if (request)
+                {
+                    Time latency = Simulator::Now() - request->sendTime;
+                    Time correctedLatency = Simulator::Now() - request->intendedTime;
+                    m_latencyHistogram.Record(latency);
+                    m_correctedHistogram.Record(correctedLatency);
+                    if (m_timeSeries) {
+                        m_timeSeries->Record(Simulator::Now(), correctedLatency, expectedTotalSize);
+                    }
+                    Connection& conn = m_connections[request->connection];
+                    if (conn.outstanding > 0) {
+                        conn.outstanding--;
+                    }
+                    if (m_picker) {
+                        m_picker->ReportBackendLatency(m_peers[conn.peer], latency);
+                    }
+                    ReportFinished(request->connection);
+                    const bool slotFreed = ResolveRequest(request->group, true);
+                    m_sentTimes.Erase(respHeader.GetSeq());
                     m_responsesReceived++;
+                    if (m_latencySlo.IsZero() || correctedLatency <= m_latencySlo) {
+                        m_responsesWithinSlo++;
+                    }
+                    if (!m_deadlineBudget.IsZero() && latency > m_deadlineBudget) {
+                        m_responsesPastDeadline++;
+                    }
+                    m_lastResponseTime = Simulator::Now();
                     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Client (Node " << GetNode()->GetId()
                                   << "): Received response Seq=" << respHeader.GetSeq()
                                   << ", Latency=" << latency.GetMilliSeconds() << "ms");
+                    // Once all requests are sent, a fan-out straggler may be the last response
+                    // awaited; the closed loop then closes the connections.
+                    if (m_concurrency > 0 && (slotFreed || RequestBudgetExhausted())) {
+                        ScheduleClosedLoopRequest();
+                    }
+                }
+                else if (m_sentTimes.FindTombstone(respHeader.GetSeq()))
+                {
+                    // The request already timed out; its answer is a miss, not a latency sample.
+                    m_sentTimes.Erase(respHeader.GetSeq());
+                    m_lateResponses++;
+                    NS_LOG_DEBUG("Client (Node " << GetNode()->GetId()
+                                   << "): Late response for timed-out Seq=" << respHeader.GetSeq());
                 }
                 else
                 {
                     NS_LOG_WARN("Client (Node " << GetNode()->GetId()
-                                  << "): Received response for unknown/duplicate/timed-out Seq=" << respHeader.GetSeq());
+                                  << "): Received response for unknown/duplicate Seq=" << respHeader.GetSeq());
                 }
 
-                m_rxBuffer.erase(0, expectedTotalSize);
+                m_bytesReceived += expectedTotalSize;
+                rxBuffer.erase(0, expectedTotalSize);
                 NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << ") HandleRead: Consumed "
-                               << expectedTotalSize << " bytes. Buffer remaining: " << m_rxBuffer.size());
+                               << expectedTotalSize << " bytes. Buffer remaining: " << rxBuffer.size());
             }
             else
             {
                 NS_LOG_DEBUG("Client (Node " << GetNode()->GetId()
                                << ") HandleRead: Incomplete response in buffer. Need " << expectedTotalSize
-                               << ", have " << m_rxBuffer.size() << ". Waiting for more data.");
+                               << ", have " << rxBuffer.size() << ". Waiting for more data.");
                 break;
             }
         }
@@ -403,24 +1137,106 @@ LatencyClientApp::ScheduleNextRequest()
         NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): Not scheduling next request, m_running is false.");
         return;
     }
-    if (!m_connected) {
+    if (!AnyConnected()) {
         NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): Not scheduling next request, not connected.");
         return;
     }
 
-    if (m_requestCount == 0 || m_requestsSent < m_requestCount)
+    bool budgetLeft = !RequestBudgetExhausted();
+    if (budgetLeft && m_traceReader && !m_haveTraceRecord)
+    {
+        m_haveTraceRecord = m_traceReader->Next(m_traceRecord);
+        m_traceExhausted = !m_haveTraceRecord;
+        budgetLeft = m_haveTraceRecord;
+    }
+
+    if (budgetLeft)
     {
+        // Advance along the schedule, not from now, so a late send does not delay the rest.
+        m_nextIntendedSend = m_traceReader ? m_traceBase + m_traceRecord.sendOffset
+                                           : m_nextIntendedSend + m_arrivalProcess->GetNextInterArrival();
+        Time gap = std::max(m_nextIntendedSend - Simulator::Now(), Seconds(0));
         NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): Scheduling next request send in "
-                       << m_requestInterval.GetSeconds() << "s");
-        m_sendEvent = Simulator::Schedule(m_requestInterval, &LatencyClientApp::SendRequestPacket, this);
+                       << gap.GetSeconds() << "s");
+        m_sendEvent = Simulator::Schedule(gap, &LatencyClientApp::SendRequestPacket, this);
+    }
+    else
+    {
+        ScheduleCloseConnections();
+    }
+}
+
+void
+LatencyClientApp::ScheduleClosedLoopRequest()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_running) {
+        return;
+    }
+
+    if (RequestBudgetExhausted() || m_traceExhausted)
+    {
+        // Keep the connections until the last outstanding response has arrived.
+        if (m_sentTimes.IsEmpty()) {
+            ScheduleCloseConnections();
+        }
+        return;
+    }
+
+    Time think = Seconds(m_thinkTime->GetValue());
+    if (think.IsStrictlyPositive()) {
+        Simulator::Schedule(think, &LatencyClientApp::SendRequestPacket, this);
+    } else {
+        SendRequestPacket();
     }
-    else if (m_requestCount > 0 && m_requestsSent >= m_requestCount)
+}
+
+void
+LatencyClientApp::ExpireRequests()
+{
+    NS_LOG_FUNCTION(this);
+    const Time now = Simulator::Now();
+    uint32_t expired = 0;
+    uint32_t freedSlots = 0;
+    while (!m_deadlines.empty() && m_deadlines.front().deadline <= now)
     {
-        Time closeDelay = Seconds(0.5);
-        NS_LOG_INFO("Client (Node " << GetNode()->GetId() << "): All " << m_requestsSent
-                      << " requests sent. Scheduling socket close in " << closeDelay.GetSeconds() << "s.");
-        if (m_socket && m_connected) {
-             Simulator::Schedule(closeDelay, &Socket::Close, m_socket);
+        const uint64_t seq = m_deadlines.front().seq;
+        m_deadlines.pop_front();
+        const InFlightRequest* request = m_sentTimes.Find(seq);
+        if (!request) {
+            continue; // Answered or abandoned before its deadline.
+        }
+        Connection& conn = m_connections[request->connection];
+        if (conn.outstanding > 0) {
+            conn.outstanding--;
+        }
+        if (m_picker) {
+            // Silence is how a hung backend fails, so the picker must hear of it.
+            m_picker->ReportBackendFailure(m_peers[conn.peer]);
+        }
+        ReportFinished(request->connection);
+        if (ResolveRequest(request->group, false)) {
+            freedSlots++;
+        }
+        m_sentTimes.MarkTombstone(seq);
+        expired++;
+    }
+    m_requestsTimedOut += expired;
+    if (expired > 0) {
+        NS_LOG_INFO(now.GetSeconds() << "s Client (Node " << GetNode()->GetId() << "): " << expired
+                      << " requests timed out after " << m_timeout.GetMilliSeconds() << "ms.");
+    }
+
+    if (!m_deadlines.empty()) {
+        m_timeoutEvent = Simulator::Schedule(m_deadlines.front().deadline - now, &LatencyClientApp::ExpireRequests, this);
+    }
+
+    if (m_concurrency > 0) {
+        for (uint32_t i = 0; i < freedSlots; ++i) {
+            ScheduleClosedLoopRequest();
+        }
+        if (freedSlots == 0 && expired > 0 && RequestBudgetExhausted()) {
+            ScheduleClosedLoopRequest(); // Lets the loop close once the last straggler is gone.
         }
     }
 }
@@ -434,52 +1250,184 @@ LatencyClientApp::SendRequestPacket()
         NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): SendRequestPacket called but app not running.");
         return;
     }
-    if (!m_connected) {
-        NS_LOG_WARN("Client (Node " << GetNode()->GetId() << "): SendRequestPacket called but not connected.");
+    if (RequestBudgetExhausted()) {
+        NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): Request count reached ("
+                       << m_requestCount << " requests). Not sending more.");
         return;
     }
-    NS_ASSERT_MSG(m_socket != nullptr, "SendRequestPacket called with null socket");
 
-    if (m_requestCount > 0 && m_requestsSent >= m_requestCount) {
-        NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): Request count reached ("
-                       << m_requestsSent << "/" << m_requestCount << "). Not sending more.");
+    if (!AnyConnected()) {
+        if (m_concurrency > 0) {
+            // Park the slot; it is reissued when a connection comes up.
+            m_idleSlots++;
+            NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): No connection available, parking closed-loop slot.");
+        } else {
+            // Keep the request pending; it is sent (late) once a connection comes up.
+            NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): No connection available, deferring open-loop request.");
+        }
         return;
     }
 
+    uint32_t requestSize = m_requestSize;
+    uint64_t l7Identifier = 0;
+    Time serviceTimeHint = Seconds(0);
+    if (m_traceReader)
+    {
+        if (!m_haveTraceRecord && !m_traceReader->Next(m_traceRecord)) {
+            if (!m_traceExhausted) {
+                NS_LOG_INFO("Client (Node " << GetNode()->GetId() << "): Trace shard exhausted after "
+                              << m_requestsSent << " requests.");
+                m_traceExhausted = true;
+                if (m_concurrency > 0) {
+                    ScheduleClosedLoopRequest();
+                }
+            }
+            return;
+        }
+        m_haveTraceRecord = false;
+        requestSize = m_traceRecord.requestSize;
+        l7Identifier = m_traceRecord.l7Identifier;
+        serviceTimeHint = m_traceRecord.serviceTimeHint;
+    }
+
+    if (m_requestsSent == 0) {
+        m_firstSendTime = Simulator::Now();
+    }
+    const Time intendedTime = (m_concurrency == 0) ? std::min(m_nextIntendedSend, Simulator::Now()) : Simulator::Now();
+
+    uint64_t group = 0;
+    if (m_fanOut > 1) {
+        const uint32_t quorum = (m_fanOutQuorum == 0) ? m_fanOut : m_fanOutQuorum;
+        group = ++m_logicalCounter;
+        m_logicalRequests.Insert(group, LogicalRequest{Simulator::Now(), intendedTime, quorum, m_fanOut - quorum, m_fanOut});
+    }
+
+    for (uint32_t i = 0; i < m_fanOut; ++i)
+    {
+        // Synthesized sub-requests each get their own key, so they spread over backends.
+        if (!m_traceReader) {
+            l7Identifier = m_keyGenerator->GetNextKey();
+            if (m_requestSizes) {
+                requestSize = m_requestSizes->GetNextSize();
+            }
+        }
+        const uint32_t responseSize = m_responseSizes ? m_responseSizes->GetNextSize() : 0;
+        SendSingleRequest(requestSize, responseSize, l7Identifier, serviceTimeHint, intendedTime, group);
+    }
+
+    // Open-loop arrivals do not depend on whether this send went through.
+    if (m_concurrency == 0) {
+        ScheduleNextRequest();
+    }
+}
+
+bool
+LatencyClientApp::SendSingleRequest(uint32_t requestSize,
+                                    uint32_t responseSize,
+                                    uint64_t l7Identifier,
+                                    Time serviceTimeHint,
+                                    Time intendedTime,
+                                    uint64_t group)
+{
+    NS_LOG_FUNCTION(this << requestSize << responseSize << l7Identifier << group);
+
+    // The picker may route on the L7 identifier, so the connection is chosen once it is known.
+    const int32_t connIndex = PickConnection(l7Identifier);
+    NS_ASSERT_MSG(connIndex >= 0, "SendSingleRequest found no connection although one is established");
+    Connection& conn = m_connections[connIndex];
+    NS_ASSERT_MSG(conn.socket != nullptr, "SendSingleRequest picked a connection with a null socket");
+
     m_requestsSent++;
     m_seqCounter++;
 
     RequestResponseHeader reqHeader;
     reqHeader.SetSeq(m_seqCounter);
     reqHeader.SetTimestamp(Simulator::Now());
-    reqHeader.SetPayloadSize(m_requestSize);
-    reqHeader.SetL7Identifier(m_dist(m_rng));
+    reqHeader.SetPayloadSize(requestSize);
+    reqHeader.SetL7Identifier(l7Identifier);
+    reqHeader.SetServiceTimeHint(serviceTimeHint);
+    reqHeader.SetResponseSize(responseSize);
+    if (!m_deadlineBudget.IsZero()) {
+        reqHeader.SetDeadline(Simulator::Now() + m_deadlineBudget);
+    }
 
-    Ptr<Packet> packet = Create<Packet>(m_requestSize);
+    Ptr<Packet> packet = Create<Packet>(requestSize);
     packet->AddHeader(reqHeader);
 
-    m_sentTimes[m_seqCounter] = reqHeader.GetTimestamp();
+    m_sentTimes.Insert(m_seqCounter,
+                       InFlightRequest{reqHeader.GetTimestamp(), intendedTime, static_cast<uint32_t>(connIndex), group});
+    conn.outstanding++;
+    if (m_picker) {
+        m_picker->ReportRequestSent(m_peers[conn.peer]);
+    }
+    if (m_timeout.IsStrictlyPositive()) {
+        m_deadlines.push_back(PendingDeadline{Simulator::Now() + m_timeout, m_seqCounter});
+        if (!m_timeoutEvent.IsPending()) {
+            m_timeoutEvent = Simulator::Schedule(m_timeout, &LatencyClientApp::ExpireRequests, this);
+        }
+    }
 
-    InetSocketAddress remoteAddress(m_peerIpv4Address, m_peerPort);
+    const InetSocketAddress& remoteAddress = m_peers[conn.peer];
     NS_LOG_INFO(reqHeader.GetTimestamp().GetSeconds() << "s Client (Node " << GetNode()->GetId()
                   << "): Sending Req Seq=" << reqHeader.GetSeq()
                   << ", Size=" << packet->GetSize()
                   << ", L7Id=" << reqHeader.GetL7Identifier()
-                  << " to " << remoteAddress);
+                  << " to " << remoteAddress << " on connection " << connIndex);
 
-    int bytesActuallySent = m_socket->Send(packet);
-
-    if (bytesActuallySent < 0) {
+    m_bytesSent += packet->GetSize();
+    if (!conn.txQueue.Send(conn.socket, packet)) {
+        // Still tracked as outstanding: the connection loss or the timeout resolves it.
+        m_sendFailures++;
         NS_LOG_ERROR("Client (Node " << GetNode()->GetId() << "): Error sending packet Seq="
-                       << reqHeader.GetSeq() << ". Errno: " << m_socket->GetErrno()); // Corrected
-    } else {
-        if (static_cast<uint32_t>(bytesActuallySent) < packet->GetSize()) {
-            NS_LOG_WARN("Client (Node " << GetNode()->GetId() << "): Could not send full packet Seq="
-                          << reqHeader.GetSeq() << " immediately. Sent " << bytesActuallySent
-                          << "/" << packet->GetSize() << ". TCP will manage." );
+                       << reqHeader.GetSeq() << ". Errno: " << conn.socket->GetErrno()); // Corrected
+        return false;
+    }
+    if (conn.txQueue.HasPending()) {
+        NS_LOG_DEBUG("Client (Node " << GetNode()->GetId() << "): Request Seq=" << reqHeader.GetSeq()
+                       << " partly queued; " << conn.txQueue.GetPendingBytes()
+                       << " bytes wait for send-buffer space.");
+    }
+    return true;
+}
+
+bool
+LatencyClientApp::RequestBudgetExhausted() const
+{
+    // Every logical request is sent as m_fanOut requests at once.
+    return m_requestCount > 0 && m_requestsSent >= static_cast<uint64_t>(m_requestCount) * m_fanOut;
+}
+
+bool
+LatencyClientApp::ResolveRequest(uint64_t group, bool answered)
+{
+    if (group == 0) {
+        return true;
+    }
+    LogicalRequest* logical = m_logicalRequests.Find(group);
+    if (!logical) {
+        return false;
+    }
+    bool slotFreed = false;
+    if (!logical->done) {
+        if (answered && --logical->awaiting == 0) {
+            const Time now = Simulator::Now();
+            m_logicalHistogram.Record(now - logical->sendTime);
+            m_logicalCorrectedHistogram.Record(now - logical->intendedTime);
+            m_logicalCompleted++;
+            logical->done = true;
+            slotFreed = true;
+        } else if (!answered && logical->spareFailures == 0) {
+            m_logicalFailed++;
+            logical->done = true;
+            slotFreed = true;
+        } else if (!answered) {
+            logical->spareFailures--;
         }
-        ScheduleNextRequest();
     }
+    if (--logical->unresolved == 0) {
+        m_logicalRequests.Erase(group);
+    }
+    return slotFreed;
 }
 
 } // namespace ns3
\ No newline at end of file
@@ -8,16 +8,26 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/nstime.h" // For ns3::Time
 #include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h" // For Ptr<RandomVariableStream> (think time)
 
 // Standard Library Includes
-#include <map>
-#include <random> // For std::mt19937_64, std::uniform_int_distribution
+#include <deque>  // For std::deque (deadline queue)
+#include <memory> // For std::unique_ptr
 #include <string>
 #include <vector>
 #include <cstdint> // For uint16_t, uint32_t, uint64_t
 
 // Project-Specific Includes
+#include "arrival_process.h"         // Open-loop inter-arrival time generators
+#include "key_generator.h"           // L7 identifier (key) popularity models
+#include "latency_histogram.h"       // Fixed-memory latency recording
+#include "latency_time_series.h"     // Windowed latency/throughput recording
+#include "load_balancer.h"           // Backend picker for client-side load balancing
 #include "request_response_header.h" // Custom request/response header
+#include "sequence_ring.h"           // In-flight request bookkeeping
+#include "size_distribution.h"       // Request/response payload size models
+#include "socket_tx_queue.h"         // Send queue for messages larger than the socket buffer
+#include "trace_reader.h"            // Recorded workload replay
 
 namespace ns3 {
 
@@ -30,7 +40,65 @@ class Socket;
  * This application sends requests containing a sequence number and timestamp,
  * encapsulated within a RequestResponseHeader. It listens for responses,
  * matches them using the sequence number, calculates the round-trip latency,
- * and stores these latencies for analysis.
+ * and records these latencies in a fixed-memory histogram for analysis.
+ *
+ * Two load models are supported:
+ * - Open loop (Concurrency = 0, the default): requests are issued according to an
+ *   ArrivalProcess, regardless of how many are still awaiting a response.
+ * - Closed loop (Concurrency = C > 0): the client keeps C requests outstanding. Each
+ *   response frees a slot, which is refilled after a ThinkTime draw (immediately by default).
+ *
+ * L7 identifiers come from a KeyGenerator (independent random 64-bit keys by default).
+ * Request payload sizes come from RequestSizeDistribution (RequestSize bytes by default),
+ * and each request asks the server for a response payload drawn from
+ * ResponseSizeDistribution (empty by default). Messages larger than the socket's send
+ * buffer are queued and written as buffer space frees up.
+ *
+ * If a TraceFile is configured, request sizes, L7 identifiers and service-time hints come
+ * from the client's shard of the recorded trace. In open-loop mode the recorded send
+ * offsets also drive timing (relative to connection establishment); the client stops
+ * once its shard is exhausted.
+ *
+ * Requests are spread over Connections parallel TCP connections, either round-robin or
+ * to the connection with the fewest outstanding requests. A connection that closes or
+ * fails is re-established after ReconnectDelay; requests still outstanding on it are
+ * counted as abandoned (in closed-loop mode their slots are reissued).
+ *
+ * With a non-zero Timeout, a request that is still unanswered Timeout after it was sent
+ * is given up: it is counted as timed out (a closed-loop slot is reissued), and a response
+ * arriving for it afterwards is counted as late rather than recorded as a latency. All
+ * requests share the same timeout, so deadlines expire in send order and are kept in a
+ * FIFO served by a single timer event. Responses at or below LatencySlo count toward goodput.
+ *
+ * Each request also carries its intended send time. In open-loop mode that is its slot on
+ * the arrival schedule, which keeps advancing while no connection is up; the missed
+ * requests are sent as soon as a connection is available again. Latency is recorded
+ * twice: from the actual send time (uncorrected) and from the intended send time
+ * (corrected for coordinated omission). The SLO applies to the corrected latency. In
+ * closed-loop mode both are the same.
+ *
+ * With a non-zero DeadlineBudget, each request carries the absolute deadline send time +
+ * DeadlineBudget. The load balancer and servers answer a request they can no longer serve
+ * in time with STATUS_DEADLINE_EXCEEDED; such answers are failures, counted apart from
+ * rejections. Responses served but arriving after the deadline are counted as well.
+ *
+ * With a non-zero TimeSeriesWindow, corrected latencies and response bytes are also
+ * recorded per window of simulation time (see LatencyTimeSeries) to expose transients.
+ *
+ * With FanOut = k > 1, each request is a scatter-gather (logical) request: k sub-requests,
+ * each with its own L7 identifier and sizes, are sent at once and the logical request
+ * completes when FanOutQuorum of them (all by default) have been answered. It fails once
+ * too many sub-requests have timed out or been abandoned to reach the quorum. Sub-requests
+ * are recorded in the regular histograms; logical requests, measured to the quorum-th
+ * response, in separate ones. RequestCount and Concurrency count logical requests. Fan-out
+ * is not supported while replaying a trace.
+ *
+ * With a Picker (a LoadBalancerApp that is not installed on any node), the client balances
+ * its own load, like a sidecar proxy or a gRPC client-side balancer: it opens Connections
+ * connections to each of the picker's backends instead of to the remote address, asks the
+ * picker for a backend per request and reports that request's lifecycle back to it. Each
+ * picker therefore only sees its own client's traffic. If the chosen backend has no
+ * established connection, the request goes to any backend that has one.
  */
 class LatencyClientApp : public Application
 {
@@ -41,6 +109,15 @@ class LatencyClientApp : public Application
      */
     static TypeId GetTypeId();
 
+    /**
+     * @brief How requests are distributed over the client's connections.
+     */
+    enum ConnectionSpreading
+    {
+        ROUND_ROBIN,      //!< Cycle through connected connections.
+        LEAST_OUTSTANDING //!< Pick the connection with the fewest requests awaiting a response.
+    };
+
     LatencyClientApp();
     virtual ~LatencyClientApp() override;
 
@@ -66,10 +143,64 @@ class LatencyClientApp : public Application
 
     /**
      * @brief Sets the time interval between sending consecutive requests.
+     * Only used when no ArrivalProcess has been configured.
      * @param interval The time interval.
      */
     void SetRequestInterval(Time interval);
 
+    /**
+     * @brief Sets the process that generates inter-arrival times between requests.
+     * Overrides the fixed RequestInterval.
+     * @param process The arrival process to use.
+     */
+    void SetArrivalProcess(Ptr<ArrivalProcess> process);
+
+    /**
+     * @brief Sets the generator of request L7 identifiers.
+     * @param generator The key generator to use (ignored while replaying a trace).
+     */
+    void SetKeyGenerator(Ptr<KeyGenerator> generator);
+
+    /**
+     * @brief Sets the generator of request payload sizes.
+     * @param sizes The size distribution to use (ignored while replaying a trace).
+     */
+    void SetRequestSizeDistribution(Ptr<SizeDistribution> sizes);
+
+    /**
+     * @brief Sets the generator of the response payload sizes requested from the server.
+     * @param sizes The size distribution to use.
+     */
+    void SetResponseSizeDistribution(Ptr<SizeDistribution> sizes);
+
+    /**
+     * @brief Replays a shard of a recorded trace instead of synthesizing requests.
+     * @param path Path of the binary trace file (see TraceReader for the format).
+     * @param shardIndex Shard of the trace replayed by this client.
+     * @param shardCount Number of shards (normally the number of clients).
+     */
+    void SetTrace(const std::string& path, uint32_t shardIndex, uint32_t shardCount);
+
+    /**
+     * @brief Enables closed-loop operation with the given number of outstanding requests.
+     * @param concurrency Requests kept in flight (0 selects open-loop operation).
+     */
+    void SetConcurrency(uint32_t concurrency);
+
+    /**
+     * @brief Enables client-side load balancing with the given backend picker.
+     * The picker's backends must be configured before the client starts.
+     * @param picker A load balancer that is not installed on any node (nullptr disables it).
+     */
+    void SetPicker(Ptr<LoadBalancerApp> picker);
+
+    /**
+     * @brief Assigns fixed random variable stream numbers to the random variables used by this client.
+     * @param stream First stream index to use.
+     * @return The number of stream indices assigned.
+     */
+    virtual int64_t AssignStreams(int64_t stream) override;
+
     /**
      * @brief Sets the size of the payload for each request packet.
      * @param size The payload size in bytes.
@@ -77,10 +208,152 @@ class LatencyClientApp : public Application
     void SetRequestSize(uint32_t size);
 
     /**
-     * @brief Retrieves the recorded latencies.
-     * @return A constant reference to a vector of Time objects representing latencies.
+     * @brief Retrieves the histogram of recorded latencies.
+     * @return A constant reference to the client's latency histogram.
+     */
+    const LatencyHistogram& GetLatencyHistogram() const;
+
+    /**
+     * @brief Retrieves the histogram of latencies measured from each request's intended
+     * send time (corrected for coordinated omission).
+     * @return A constant reference to the client's corrected latency histogram.
      */
-    const std::vector<Time>& GetLatencies() const;
+    const LatencyHistogram& GetCorrectedLatencyHistogram() const;
+
+    /**
+     * @brief Retrieves the histogram of logical (fan-out) request latencies, measured from
+     * the actual send time to the quorum-th sub-response.
+     * @return A constant reference to the histogram (empty unless FanOut > 1).
+     */
+    const LatencyHistogram& GetLogicalLatencyHistogram() const;
+
+    /**
+     * @brief Retrieves the histogram of logical (fan-out) request latencies measured from
+     * the intended send time (corrected for coordinated omission).
+     * @return A constant reference to the histogram (empty unless FanOut > 1).
+     */
+    const LatencyHistogram& GetLogicalCorrectedLatencyHistogram() const;
+
+    /**
+     * @brief Gets the number of logical (fan-out) requests that reached their quorum.
+     * @return The completed logical request count (0 unless FanOut > 1).
+     */
+    uint32_t GetLogicalRequestsCompleted() const;
+
+    /**
+     * @brief Gets the number of logical (fan-out) requests that could no longer reach their
+     * quorum because sub-requests timed out or were abandoned.
+     * @return The failed logical request count (0 unless FanOut > 1).
+     */
+    uint32_t GetLogicalRequestsFailed() const;
+
+    /**
+     * @brief Retrieves the windowed latency/throughput series of corrected latencies.
+     * @return The series, or nullptr if TimeSeriesWindow is 0.
+     */
+    const LatencyTimeSeries* GetLatencyTimeSeries() const;
+
+    /**
+     * @brief Gets the number of responses matched to a request so far.
+     * @return The response count.
+     */
+    uint32_t GetResponsesReceived() const;
+
+    /**
+     * @brief Gets the number of requests lost because their connection closed or failed
+     * before the response arrived.
+     * @return The abandoned request count.
+     */
+    uint32_t GetRequestsAbandoned() const;
+
+    /**
+     * @brief Gets the number of requests whose socket send failed. They stay outstanding
+     * until their connection is lost or they time out, and the client keeps sending.
+     * @return The failed send count.
+     */
+    uint32_t GetSendFailures() const;
+
+    /**
+     * @brief Gets the number of requests sent so far.
+     * @return The request count.
+     */
+    uint32_t GetRequestsSent() const;
+
+    /**
+     * @brief Gets the number of requests given up because no response arrived within Timeout.
+     * @return The timed-out request count.
+     */
+    uint32_t GetRequestsTimedOut() const;
+
+    /**
+     * @brief Gets the number of requests answered with a rejection (status STATUS_REJECTED).
+     * Rejections are failures: they are not counted as responses or recorded as latencies.
+     * @return The rejected request count.
+     */
+    uint32_t GetRequestsRejected() const;
+
+    /**
+     * @brief Gets the number of responses that arrived after their request had timed out.
+     * @return The late response count.
+     */
+    uint32_t GetLateResponses() const;
+
+    /**
+     * @brief Gets the number of requests failed fast because their deadline could not be met
+     * (status STATUS_DEADLINE_EXCEEDED). Like rejections, they are not recorded as latencies.
+     * @return The deadline-exceeded request count.
+     */
+    uint32_t GetRequestsDeadlineExceeded() const;
+
+    /**
+     * @brief Gets the number of responses served but received after the request's deadline.
+     * @return The count of responses past their deadline.
+     */
+    uint32_t GetResponsesPastDeadline() const;
+
+    /**
+     * @brief Gets the number of responses received within the latency SLO.
+     * @return The count of in-SLO responses.
+     */
+    uint32_t GetResponsesWithinSlo() const;
+
+    /**
+     * @brief Gets the achieved request rate: responses received per second between the
+     * first request sent and the last response received.
+     * @return The achieved throughput in requests/second (0 if fewer than one response).
+     */
+    double GetAchievedRps() const;
+
+    /**
+     * @brief Gets the goodput: responses within the latency SLO per second, over the same
+     * window as GetAchievedRps().
+     * @return The goodput in requests/second.
+     */
+    double GetGoodput() const;
+
+    /**
+     * @brief Gets the bytes of all requests sent, headers included.
+     * @return The request byte count.
+     */
+    uint64_t GetBytesSent() const;
+
+    /**
+     * @brief Gets the bytes of all complete responses received, headers included.
+     * @return The response byte count.
+     */
+    uint64_t GetBytesReceived() const;
+
+    /**
+     * @brief Gets the request bytes sent per second, over the same window as GetAchievedRps().
+     * @return The send throughput in bytes/second.
+     */
+    double GetSendThroughput() const;
+
+    /**
+     * @brief Gets the response bytes received per second, over the same window as GetAchievedRps().
+     * @return The receive throughput in bytes/second.
+     */
+    double GetReceiveThroughput() const;
 
   protected:
     /**
@@ -100,14 +373,73 @@ class LatencyClientApp : public Application
     virtual void StopApplication() override;
 
     /**
-     * @brief Creates and configures the underlying TCP socket for communication.
+     * @brief Creates a fresh TCP socket for a connection slot and starts connecting it
+     * to the slot's peer.
+     * @param index The connection slot.
+     */
+    void OpenConnection(uint32_t index);
+
+    /**
+     * @brief Finds the connection slot owning a socket.
+     * @param socket The socket.
+     * @return The slot index, or -1 if the socket is stale or unknown.
+     */
+    int32_t FindConnection(Ptr<Socket> socket) const;
+
+    /**
+     * @brief Chooses the connection for the next request: the picker's backend (if a
+     * Picker is set), then a connection to it according to m_spreading.
+     * @param l7Identifier The request's L7 identifier (for the picker).
+     * @return The slot index, or -1 if no connection is currently established.
      */
-    void SetupSocket();
+    int32_t PickConnection(uint64_t l7Identifier);
 
     /**
-     * @brief Initiates a TCP connection to the configured remote server.
+     * @brief Chooses an established connection among a contiguous range of slots according
+     * to m_spreading.
+     * @param first First slot of the range.
+     * @param count Number of slots in the range.
+     * @param cursor Round-robin cursor of the range (relative to @p first); advanced past the choice.
+     * @return The slot index, or -1 if no connection in the range is established.
      */
-    void Connect();
+    int32_t PickConnectionIn(uint32_t first, uint32_t count, uint32_t& cursor) const;
+
+    /**
+     * @brief Finds the index of a backend in m_peers.
+     * @param address The backend address.
+     * @return The peer index, or -1 if the address is not a peer.
+     */
+    int32_t FindPeer(const InetSocketAddress& address) const;
+
+    /**
+     * @brief Tells the picker (if any) that a request on a connection has finished.
+     * @param connection The connection slot the request was sent on.
+     */
+    void ReportFinished(uint32_t connection);
+
+    /**
+     * @brief Checks whether at least one connection is established.
+     * @return True if a request could be sent now.
+     */
+    bool AnyConnected() const;
+
+    /**
+     * @brief Handles a connection that closed, failed or errored: abandons its outstanding
+     * requests and schedules a reconnection unless the client is shutting down.
+     * @param index The connection slot.
+     */
+    void HandleConnectionLoss(uint32_t index);
+
+    /**
+     * @brief Closes all connections after a short grace period once no more requests
+     * will be sent. Idempotent.
+     */
+    void ScheduleCloseConnections();
+
+    /**
+     * @brief Closes all connections without reconnecting.
+     */
+    void CloseConnections();
 
     /**
      * @brief Callback invoked when the TCP connection attempt succeeds.
@@ -154,33 +486,180 @@ class LatencyClientApp : public Application
     void ScheduleNextRequest();
 
     /**
-     * @brief Constructs and sends a single request packet to the server.
+     * @brief Sends the next request: a single request, or all sub-requests of a logical
+     * request when fanning out.
      */
     void SendRequestPacket();
 
+    /**
+     * @brief Constructs and sends one request packet on a connection chosen for it.
+     * At least one connection must be established.
+     * @param requestSize Request payload size (bytes).
+     * @param responseSize Response payload size asked of the server (bytes).
+     * @param l7Identifier The request's L7 identifier.
+     * @param serviceTimeHint Service time hint for the server (0 = none).
+     * @param intendedTime When the schedule wanted the request sent.
+     * @param group Logical request the request belongs to (0 = none).
+     * @return False if the socket reported an error, true otherwise.
+     */
+    bool SendSingleRequest(uint32_t requestSize, uint32_t responseSize, uint64_t l7Identifier,
+                           Time serviceTimeHint, Time intendedTime, uint64_t group);
+
+    /**
+     * @brief Checks whether all RequestCount (logical) requests have been sent.
+     * @return True if the request budget is used up.
+     */
+    bool RequestBudgetExhausted() const;
+
+    /**
+     * @brief Accounts for a request that has been answered, timed out or abandoned, and
+     * resolves its logical request once the outcome is known.
+     * @param group Logical request of the request (0 = none).
+     * @param answered True if a response arrived in time.
+     * @return True if this frees a closed-loop slot: always for a request without a group,
+     * otherwise only when its logical request completes or fails.
+     */
+    bool ResolveRequest(uint64_t group, bool answered);
+
+    /**
+     * @brief Closed-loop counterpart of ScheduleNextRequest(): refills a freed slot after a
+     * think time, or closes the connection once all requests have been answered.
+     */
+    void ScheduleClosedLoopRequest();
+
+    /**
+     * @brief Timer handler: gives up every request whose deadline has passed, then re-arms
+     * the timer for the next pending deadline.
+     */
+    void ExpireRequests();
+
+    /**
+     * @brief Creates the default (uniform 64-bit) key generator if none is configured.
+     */
+    void EnsureKeyGenerator();
+
+    /**
+     * @brief State of one TCP connection to the remote peer.
+     */
+    struct Connection
+    {
+        Ptr<Socket> socket;        //!< The connection's socket (nullptr while waiting to reconnect).
+        uint32_t peer = 0;         //!< Index of the connection's peer in m_peers.
+        bool connected = false;    //!< True once the connection is established.
+        uint32_t outstanding = 0;  //!< Requests sent on this connection still awaiting a response.
+        std::string rxBuffer;      //!< Buffer for assembling incoming TCP stream data into messages.
+        SocketTxQueue txQueue;     //!< Request bytes waiting for send-buffer space.
+        EventId reconnectEvent;    //!< Pending reconnection attempt.
+    };
+
+    /**
+     * @brief Bookkeeping for one request awaiting its response.
+     */
+    struct InFlightRequest
+    {
+        Time sendTime;             //!< When the request was sent.
+        Time intendedTime;         //!< When the schedule wanted the request sent (<= sendTime).
+        uint32_t connection = 0;   //!< Connection slot the request was sent on.
+        uint64_t group = 0;        //!< Logical request the request belongs to (0 = none).
+    };
+
+    /**
+     * @brief Bookkeeping for one logical (fan-out) request.
+     */
+    struct LogicalRequest
+    {
+        Time sendTime;             //!< When the sub-requests were sent.
+        Time intendedTime;         //!< When the schedule wanted them sent (<= sendTime).
+        uint32_t awaiting = 0;     //!< Responses still needed to reach the quorum.
+        uint32_t spareFailures = 0; //!< Sub-requests that may still fail without failing the request.
+        uint32_t unresolved = 0;   //!< Sub-requests neither answered, timed out nor abandoned yet.
+        bool done = false;         //!< True once the request has completed or failed.
+    };
+
+    /**
+     * @brief Entry of the deadline FIFO.
+     */
+    struct PendingDeadline
+    {
+        Time deadline;             //!< When the request times out.
+        uint64_t seq = 0;          //!< Sequence number of the request.
+    };
+
     // Member Variables
-    Ptr<Socket> m_socket;            //!< The TCP socket used for communication.
+    std::vector<Connection> m_connections; //!< Parallel connections to the peer.
+    uint32_t m_connectionCount;      //!< Number of parallel connections to open (attribute).
+    ConnectionSpreading m_spreading; //!< Policy for spreading requests over connections (attribute).
+    Time m_reconnectDelay;           //!< Delay before re-establishing a lost connection (attribute).
+    uint32_t m_nextConnection;       //!< Round-robin cursor over all slots (also breaks least-outstanding ties).
+    std::vector<InetSocketAddress> m_peers; //!< Remote peers: the remote address, or the picker's backends.
+    std::vector<uint32_t> m_peerCursors;    //!< Round-robin cursor within each peer's slots.
+    Ptr<LoadBalancerApp> m_picker;   //!< Backend picker for client-side load balancing (attribute; nullptr = off).
+    EventId m_closeEvent;            //!< Pending graceful close of all connections.
+    bool m_closing;                  //!< True once the client has started closing its connections for good.
     Ipv4Address m_peerIpv4Address;   //!< IPv4 address of the remote server or load balancer.
     uint16_t m_peerPort;             //!< Port number of the remote server or load balancer.
 
     uint32_t m_requestSize;          //!< Size of the application payload in request packets (bytes).
     uint32_t m_requestCount;         //!< Total number of requests to send (0 for continuous).
-    Time m_requestInterval;          //!< Interval between sending requests.
+    Time m_requestInterval;          //!< Interval between sending requests (used when no arrival process is set).
+    Ptr<ArrivalProcess> m_arrivalProcess; //!< Generator of inter-arrival times between requests.
+    uint32_t m_concurrency;          //!< Requests kept outstanding in closed-loop mode (0 = open loop).
+    Ptr<RandomVariableStream> m_thinkTime; //!< Delay (seconds) before refilling a closed-loop slot.
+    Ptr<KeyGenerator> m_keyGenerator;      //!< Generator of request L7 identifiers.
+    Ptr<SizeDistribution> m_requestSizes;  //!< Generator of request payload sizes (unset = RequestSize).
+    Ptr<SizeDistribution> m_responseSizes; //!< Generator of requested response payload sizes (unset = 0).
+    uint32_t m_fanOut;               //!< Sub-requests per logical request (1 = no fan-out) (attribute).
+    uint32_t m_fanOutQuorum;         //!< Sub-responses completing a logical request (0 = all) (attribute).
+
+    std::string m_traceFile;         //!< Trace to replay (empty = synthesize requests).
+    uint32_t m_traceShardIndex;      //!< Shard of the trace replayed by this client.
+    uint32_t m_traceShardCount;      //!< Number of shards the trace is split into.
+    std::unique_ptr<TraceReader> m_traceReader; //!< Open trace, or nullptr when not replaying.
+    TraceRecord m_traceRecord;       //!< Record fetched for the next scheduled send.
+    bool m_haveTraceRecord;          //!< True if m_traceRecord has been fetched but not yet sent.
+    bool m_traceExhausted;           //!< True once this client's trace shard has run out.
+    Time m_traceBase;                //!< Simulation time corresponding to trace offset zero.
+    Time m_nextIntendedSend;         //!< Open-loop schedule slot of the next (pending) request.
     EventId m_sendEvent;             //!< Event ID for the next scheduled request send operation.
 
     uint64_t m_seqCounter;           //!< Sequence number counter for outgoing requests.
     uint32_t m_requestsSent;         //!< Count of requests sent by this client.
     uint32_t m_responsesReceived;    //!< Count of valid responses received by this client.
+    uint32_t m_requestsAbandoned;    //!< Requests whose connection was lost before they were answered.
+    uint32_t m_sendFailures;         //!< Requests whose socket send failed.
+    uint32_t m_requestsTimedOut;     //!< Requests given up after Timeout without a response.
+    uint32_t m_requestsRejected;     //!< Requests answered with a rejection.
+    uint32_t m_lateResponses;        //!< Responses that arrived after their request timed out.
+    uint32_t m_requestsDeadlineExceeded; //!< Requests answered with STATUS_DEADLINE_EXCEEDED.
+    uint32_t m_responsesPastDeadline; //!< Responses served but received after the deadline.
+    uint32_t m_responsesWithinSlo;   //!< Responses with latency at or below m_latencySlo.
+    uint64_t m_bytesSent;            //!< Request bytes (header + payload) handed to the connections.
+    uint64_t m_bytesReceived;        //!< Response bytes (header + payload) of complete responses.
+    uint64_t m_logicalCounter;       //!< Identifier of the latest logical request.
+    uint32_t m_logicalCompleted;     //!< Logical requests that reached their quorum.
+    uint32_t m_logicalFailed;        //!< Logical requests that could no longer reach their quorum.
+    uint32_t m_idleSlots;            //!< Closed-loop slots waiting for a connection to become available.
+    bool m_openLoopStarted;          //!< True once the open-loop send sequence has been started.
 
     bool m_running;                  //!< True if the application is currently active and running.
-    bool m_connected;                //!< True if the TCP socket is currently connected to the peer.
-
-    std::map<uint64_t, Time> m_sentTimes; //!< Stores send timestamps keyed by sequence number for latency calculation.
-    std::vector<Time> m_latencies;        //!< Stores calculated round-trip times for received responses.
-    std::string m_rxBuffer;               //!< Buffer for assembling incoming TCP stream data into messages.
 
-    std::mt19937_64 m_rng;           //!< Mersenne Twister random number generator engine.
-    std::uniform_int_distribution<uint64_t> m_dist; //!< Uniform distribution for generating 64-bit L7 identifiers.
+    SequenceRing<InFlightRequest> m_sentTimes; //!< In-flight requests, indexed by sequence number.
+    SequenceRing<LogicalRequest> m_logicalRequests; //!< Unresolved logical requests, indexed by identifier.
+    Time m_timeout;                  //!< Time after which an unanswered request is given up (0 = never).
+    Time m_latencySlo;               //!< Latency objective for goodput (0 = any response before the timeout).
+    Time m_deadlineBudget;           //!< Deadline of each request after its send time (0 = none).
+    std::deque<PendingDeadline> m_deadlines; //!< Deadlines in send order (answered entries are skipped lazily).
+    EventId m_timeoutEvent;          //!< Timer for the earliest pending deadline.
+    Time m_firstSendTime;            //!< Time the first request was sent (for achieved RPS).
+    Time m_lastResponseTime;         //!< Time the most recent response was received (for achieved RPS).
+    LatencyHistogram m_latencyHistogram;  //!< Round-trip times of received responses.
+    LatencyHistogram m_correctedHistogram; //!< Response times measured from the intended send time.
+    LatencyHistogram m_logicalHistogram;   //!< Logical request latencies from the actual send time.
+    LatencyHistogram m_logicalCorrectedHistogram; //!< Logical request latencies from the intended send time.
+    uint32_t m_histogramPrecision;        //!< Significant decimal digits kept by the latency histogram.
+    Time m_histogramHighestLatency;       //!< Largest latency tracked precisely by the histogram.
+    Time m_timeSeriesWindow;              //!< Width of the time-series windows (0 = no time series).
+    std::unique_ptr<LatencyTimeSeries> m_timeSeries; //!< Per-window corrected latencies and bytes.
 };
 
 } // namespace ns3
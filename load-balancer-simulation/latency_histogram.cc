@@ -0,0 +1,189 @@
+#include "latency_histogram.h"
+
+#include "ns3/log.h"
+
+#include <algorithm> // For std::min, std::max, std::clamp
+#include <bit>       // For std::bit_width
+#include <cmath>     // For std::ceil, std::log2, std::sqrt
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("LatencyHistogram");
+
+LatencyHistogram::LatencyHistogram(Time highestTrackable, uint32_t significantDigits)
+    : m_totalCount(0),
+      m_minNs(std::numeric_limits<int64_t>::max()),
+      m_maxNs(0),
+      m_sumNs(0.0),
+      m_sumSquaresNs(0.0)
+{
+    if (significantDigits < 1 || significantDigits > 5) {
+        NS_FATAL_ERROR("LatencyHistogram precision must be 1-5 significant digits, got " << significantDigits);
+    }
+
+    // Enough linear sub-buckets per power of two to resolve 1 part in 10^digits.
+    const double largestWithSingleUnitResolution = 2.0 * std::pow(10.0, significantDigits);
+    const int32_t subBucketCountMagnitude = static_cast<int32_t>(std::ceil(std::log2(largestWithSingleUnitResolution)));
+    m_subBucketHalfCountMagnitude = std::max(subBucketCountMagnitude, 1) - 1;
+    m_subBucketHalfCount = int64_t{1} << m_subBucketHalfCountMagnitude;
+    const int64_t subBucketCount = m_subBucketHalfCount * 2;
+    m_subBucketMask = subBucketCount - 1;
+
+    // One bucket per power of two needed to cover highestTrackable.
+    const int64_t highestNs = std::max(highestTrackable.GetNanoSeconds(), subBucketCount);
+    int64_t smallestUntrackable = subBucketCount;
+    size_t bucketCount = 1;
+    while (smallestUntrackable <= highestNs) {
+        if (smallestUntrackable > std::numeric_limits<int64_t>::max() / 2) {
+            bucketCount++;
+            break;
+        }
+        smallestUntrackable <<= 1;
+        bucketCount++;
+    }
+    m_counts.assign((bucketCount + 1) * static_cast<size_t>(m_subBucketHalfCount), 0);
+
+    NS_LOG_DEBUG("LatencyHistogram: " << significantDigits << " digits up to " << highestNs << "ns, "
+                 << bucketCount << " buckets, " << m_counts.size() << " slots");
+}
+
+void
+LatencyHistogram::Record(Time latency)
+{
+    RecordCounts(std::max<int64_t>(latency.GetNanoSeconds(), 0), 1);
+}
+
+void
+LatencyHistogram::RecordCounts(int64_t valueNs, uint64_t count)
+{
+    m_counts[CountsIndexFor(valueNs)] += count;
+    m_totalCount += count;
+    m_minNs = std::min(m_minNs, valueNs);
+    m_maxNs = std::max(m_maxNs, valueNs);
+    const double v = static_cast<double>(valueNs);
+    m_sumNs += v * static_cast<double>(count);
+    m_sumSquaresNs += v * v * static_cast<double>(count);
+}
+
+void
+LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+    if (other.m_totalCount == 0) {
+        return;
+    }
+    for (size_t i = 0; i < other.m_counts.size(); ++i) {
+        if (other.m_counts[i] != 0) {
+            m_counts[CountsIndexFor(other.LowestValueAt(i))] += other.m_counts[i];
+        }
+    }
+    // Summary statistics merge exactly, independently of bucket resolution.
+    m_totalCount += other.m_totalCount;
+    m_minNs = std::min(m_minNs, other.m_minNs);
+    m_maxNs = std::max(m_maxNs, other.m_maxNs);
+    m_sumNs += other.m_sumNs;
+    m_sumSquaresNs += other.m_sumSquaresNs;
+}
+
+void
+LatencyHistogram::Reset()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_totalCount = 0;
+    m_minNs = std::numeric_limits<int64_t>::max();
+    m_maxNs = 0;
+    m_sumNs = 0.0;
+    m_sumSquaresNs = 0.0;
+}
+
+uint64_t
+LatencyHistogram::GetCount() const
+{
+    return m_totalCount;
+}
+
+Time
+LatencyHistogram::GetMin() const
+{
+    return NanoSeconds(m_totalCount == 0 ? 0 : m_minNs);
+}
+
+Time
+LatencyHistogram::GetMax() const
+{
+    return NanoSeconds(m_maxNs);
+}
+
+double
+LatencyHistogram::GetMeanMs() const
+{
+    if (m_totalCount == 0) {
+        return 0.0;
+    }
+    return m_sumNs / static_cast<double>(m_totalCount) / 1e6;
+}
+
+double
+LatencyHistogram::GetStdDevMs() const
+{
+    if (m_totalCount == 0) {
+        return 0.0;
+    }
+    const double n = static_cast<double>(m_totalCount);
+    const double meanNs = m_sumNs / n;
+    const double variance = std::max(m_sumSquaresNs / n - meanNs * meanNs, 0.0);
+    return std::sqrt(variance) / 1e6;
+}
+
+Time
+LatencyHistogram::GetPercentile(double quantile) const
+{
+    if (m_totalCount == 0) {
+        return Seconds(0);
+    }
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    const uint64_t target = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(m_totalCount))));
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < m_counts.size(); ++i) {
+        cumulative += m_counts[i];
+        if (cumulative >= target) {
+            return NanoSeconds(std::clamp(HighestValueAt(i), m_minNs, m_maxNs));
+        }
+    }
+    return NanoSeconds(m_maxNs);
+}
+
+size_t
+LatencyHistogram::CountsIndexFor(int64_t valueNs) const
+{
+    const uint64_t v = static_cast<uint64_t>(valueNs);
+    const int32_t bucketIndex =
+        static_cast<int32_t>(std::bit_width(v | static_cast<uint64_t>(m_subBucketMask))) - (m_subBucketHalfCountMagnitude + 1);
+    const int64_t subBucketIndex = static_cast<int64_t>(v >> bucketIndex);
+    const int64_t index = ((static_cast<int64_t>(bucketIndex) + 1) << m_subBucketHalfCountMagnitude) +
+                          (subBucketIndex - m_subBucketHalfCount);
+    return std::min(static_cast<size_t>(index), m_counts.size() - 1);
+}
+
+int64_t
+LatencyHistogram::LowestValueAt(size_t index) const
+{
+    int32_t bucketIndex = static_cast<int32_t>(index >> m_subBucketHalfCountMagnitude) - 1;
+    int64_t subBucketIndex = static_cast<int64_t>(index & static_cast<size_t>(m_subBucketHalfCount - 1)) + m_subBucketHalfCount;
+    if (bucketIndex < 0) {
+        subBucketIndex -= m_subBucketHalfCount;
+        bucketIndex = 0;
+    }
+    return subBucketIndex << bucketIndex;
+}
+
+int64_t
+LatencyHistogram::HighestValueAt(size_t index) const
+{
+    const int32_t bucketIndex = std::max(static_cast<int32_t>(index >> m_subBucketHalfCountMagnitude) - 1, 0);
+    return LowestValueAt(index) + (int64_t{1} << bucketIndex) - 1;
+}
+
+} // namespace ns3
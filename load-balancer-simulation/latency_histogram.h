@@ -0,0 +1,136 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+// NS-3 Includes
+#include "ns3/nstime.h" // For ns3::Time
+
+// Standard Library Includes
+#include <cstddef> // For size_t
+#include <cstdint> // For int64_t, uint64_t
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @brief Fixed-memory latency histogram with bounded relative error (HDR histogram layout).
+ *
+ * Values are recorded in nanoseconds into log-linear buckets: each power-of-two range is
+ * split into enough linear sub-buckets to keep @c significantDigits decimal digits of
+ * precision, so any reported percentile is within 10^-digits (relative) of the true
+ * value. Memory depends only on the precision and the highest trackable value, never on
+ * the number of samples, and histograms with any configuration can be merged.
+ *
+ * Count, min, max, mean and standard deviation are tracked exactly; percentiles are
+ * answered from the buckets.
+ */
+class LatencyHistogram
+{
+  public:
+    /**
+     * @brief Creates an empty histogram.
+     * @param highestTrackable Largest latency that is tracked precisely; larger samples are
+     * counted in the top bucket (min/max/mean remain exact).
+     * @param significantDigits Decimal digits of precision to preserve (1 to 5).
+     */
+    explicit LatencyHistogram(Time highestTrackable = Seconds(60), uint32_t significantDigits = 3);
+
+    /**
+     * @brief Records one latency sample.
+     * @param latency The sample (negative values are recorded as zero).
+     */
+    void Record(Time latency);
+
+    /**
+     * @brief Adds all samples of another histogram to this one.
+     * The other histogram may use a different precision or range.
+     * @param other The histogram to merge in.
+     */
+    void Merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Removes all samples, keeping the configuration.
+     */
+    void Reset();
+
+    /**
+     * @brief Gets the number of recorded samples.
+     * @return The sample count.
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * @brief Gets the smallest recorded sample (exact).
+     * @return The minimum, or zero if empty.
+     */
+    Time GetMin() const;
+
+    /**
+     * @brief Gets the largest recorded sample (exact).
+     * @return The maximum, or zero if empty.
+     */
+    Time GetMax() const;
+
+    /**
+     * @brief Gets the mean of the recorded samples.
+     * @return The mean in milliseconds, or 0 if empty.
+     */
+    double GetMeanMs() const;
+
+    /**
+     * @brief Gets the population standard deviation of the recorded samples.
+     * @return The standard deviation in milliseconds, or 0 if empty.
+     */
+    double GetStdDevMs() const;
+
+    /**
+     * @brief Gets the value at or below which the given fraction of samples fall.
+     * @param quantile The quantile in [0.0, 1.0] (e.g., 0.99 for P99).
+     * @return The highest value equivalent (within the histogram's precision) to the
+     * quantile sample, clamped to [min, max]; zero if empty.
+     */
+    Time GetPercentile(double quantile) const;
+
+  private:
+    /**
+     * @brief Records a value (in ns) @p count times.
+     * @param valueNs Non-negative value in nanoseconds.
+     * @param count Number of occurrences.
+     */
+    void RecordCounts(int64_t valueNs, uint64_t count);
+
+    /**
+     * @brief Maps a value to its slot in m_counts.
+     * @param valueNs Non-negative value in nanoseconds.
+     * @return The counts index, clamped to the last slot.
+     */
+    size_t CountsIndexFor(int64_t valueNs) const;
+
+    /**
+     * @brief Gets the smallest value that maps to a counts slot.
+     * @param index The counts index.
+     * @return The lowest equivalent value in nanoseconds.
+     */
+    int64_t LowestValueAt(size_t index) const;
+
+    /**
+     * @brief Gets the largest value that maps to a counts slot.
+     * @param index The counts index.
+     * @return The highest equivalent value in nanoseconds.
+     */
+    int64_t HighestValueAt(size_t index) const;
+
+    int32_t m_subBucketHalfCountMagnitude; //!< log2 of half the number of linear sub-buckets.
+    int64_t m_subBucketHalfCount;          //!< Half the number of linear sub-buckets per power of two.
+    int64_t m_subBucketMask;               //!< Mask selecting values that fall in the first bucket.
+    std::vector<uint64_t> m_counts;        //!< Sample counts per slot.
+
+    uint64_t m_totalCount; //!< Number of recorded samples.
+    int64_t m_minNs;       //!< Exact minimum sample (ns).
+    int64_t m_maxNs;       //!< Exact maximum sample (ns).
+    double m_sumNs;        //!< Sum of samples (ns), for the mean.
+    double m_sumSquaresNs; //!< Sum of squared samples (ns^2), for the standard deviation.
+};
+
+} // namespace ns3
+
+#endif // LATENCY_HISTOGRAM_H
@@ -1,8 +1,10 @@
 #include "latency_server_app.h"
 
 #include "request_response_header.h" // Custom header
+#include "load_balancer.h"           // Picker for the downstream tier
 #include "ns3/log.h"
 #include "ns3/ipv4-address.h"
+#include "ns3/ipv4.h"
 #include "ns3/nstime.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/socket.h"
@@ -10,15 +12,19 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/core-module.h"    // For Ptr, ObjectFactory, TypeId, Callbacks, App basics
 #include "ns3/buffer.h"
 
-#include <algorithm> // For std::find
+#include <algorithm> // For std::max, std::find_if
+#include <cmath>     // For std::llround, std::ceil
 #include <string>
 #include <vector>
 #include <map>
-#include <list>
 #include <cstdint>
 #include <sstream> // Required for std::ostringstream
 
@@ -44,14 +50,132 @@ LatencyServerApp::GetTypeId()
                           "Simulated processing delay per request.",
                           TimeValue(MilliSeconds(0)), 
                           MakeTimeAccessor(&LatencyServerApp::m_processingDelay),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("ServiceTime",
+                          "Distribution each request's service time is drawn from; overrides "
+                          "ProcessingDelay when set.",
+                          PointerValue(),
+                          MakePointerAccessor(&LatencyServerApp::m_serviceTime),
+                          MakePointerChecker<ServiceTimeDistribution>())
+            .AddAttribute("Slowdown",
+                          "Factor applied to every request's service time (1 = healthy).",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&LatencyServerApp::m_slowdown),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("HonorServiceTimeHint",
+                          "Use a request's service-time hint (e.g., from a replayed trace) "
+                          "instead of ProcessingDelay when the hint is non-zero.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&LatencyServerApp::m_honorServiceTimeHint),
+                          MakeBooleanChecker())
+            .AddAttribute("Workers",
+                          "Requests served concurrently; further requests wait in the queue (0 = unlimited).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LatencyServerApp::m_workers),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MaxQueueLength",
+                          "Waiting requests beyond which new requests are rejected (0 = unbounded).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&LatencyServerApp::m_maxQueueLength),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("QueueDiscipline",
+                          "Order in which waiting requests are served.",
+                          EnumValue(LatencyServerApp::FIFO),
+                          MakeEnumAccessor<QueueDiscipline>(&LatencyServerApp::m_discipline),
+                          MakeEnumChecker(LatencyServerApp::FIFO, "FIFO",
+                                          LatencyServerApp::LIFO, "LIFO",
+                                          LatencyServerApp::SHORTEST_FIRST, "ShortestFirst"))
+            .AddAttribute("ServiceModel",
+                          "How requests share the Workers: a worker pool with a queue, or processor "
+                          "sharing of Workers cores by all requests in service.",
+                          EnumValue(LatencyServerApp::WORKER_POOL),
+                          MakeEnumAccessor<ServiceModel>(&LatencyServerApp::m_serviceModel),
+                          MakeEnumChecker(LatencyServerApp::WORKER_POOL, "WorkerPool",
+                                          LatencyServerApp::PROCESSOR_SHARING, "ProcessorSharing"))
+            .AddAttribute("AdmissionPolicy",
+                          "When to reject a request at once (status Rejected) instead of serving it.",
+                          EnumValue(LatencyServerApp::ADMIT_ALL),
+                          MakeEnumAccessor<AdmissionPolicy>(&LatencyServerApp::m_admissionPolicy),
+                          MakeEnumChecker(LatencyServerApp::ADMIT_ALL, "None",
+                                          LatencyServerApp::ADMIT_QUEUE_LENGTH, "QueueLength",
+                                          LatencyServerApp::ADMIT_LATENCY, "LatencyTarget"))
+            .AddAttribute("AdmissionQueueLength",
+                          "Waiting requests at which the QueueLength policy rejects new requests.",
+                          UintegerValue(16),
+                          MakeUintegerAccessor(&LatencyServerApp::m_admissionQueueLength),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AdmissionLatencyTarget",
+                          "Predicted latency above which the LatencyTarget policy rejects new requests.",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&LatencyServerApp::m_admissionLatencyTarget),
+                          MakeTimeChecker())
+            .AddAttribute("CachePolicy",
+                          "Eviction policy of the cache of request keys (L7 identifiers); None disables it.",
+                          EnumValue(LatencyServerApp::CACHE_NONE),
+                          MakeEnumAccessor<CachePolicy>(&LatencyServerApp::m_cachePolicy),
+                          MakeEnumChecker(LatencyServerApp::CACHE_NONE, "None",
+                                          LatencyServerApp::CACHE_LRU, "LRU",
+                                          LatencyServerApp::CACHE_ARC, "ARC"))
+            .AddAttribute("CacheCapacity",
+                          "Number of request keys the cache holds.",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&LatencyServerApp::m_cacheCapacity),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("CacheHitServiceTime",
+                          "Service time of a request whose key is cached; misses take the normal service time.",
+                          TimeValue(MilliSeconds(1)),
+                          MakeTimeAccessor(&LatencyServerApp::m_cacheHitServiceTime),
+                          MakeTimeChecker())
+            .AddAttribute("Downstream",
+                          "Picker over the next tier's servers; when set, every request calls the next "
+                          "tier before it is answered.",
+                          PointerValue(),
+                          MakePointerAccessor(&LatencyServerApp::m_downstream),
+                          MakePointerChecker<LoadBalancerApp>())
+            .AddAttribute("DownstreamCalls",
+                          "Calls to the next tier per request.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&LatencyServerApp::m_downstreamCallsPerRequest),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("DownstreamMode",
+                          "Whether the downstream calls of a request are made one after another or all at once.",
+                          EnumValue(LatencyServerApp::DOWNSTREAM_SEQUENTIAL),
+                          MakeEnumAccessor<DownstreamMode>(&LatencyServerApp::m_downstreamMode),
+                          MakeEnumChecker(LatencyServerApp::DOWNSTREAM_SEQUENTIAL, "Sequential",
+                                          LatencyServerApp::DOWNSTREAM_PARALLEL, "Parallel"))
+            .AddAttribute("DownstreamRequestSize",
+                          "Payload bytes of each downstream call.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&LatencyServerApp::m_downstreamRequestSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("DownstreamResponseSize",
+                          "Response payload bytes each downstream call asks for.",
+                          UintegerValue(64),
+                          MakeUintegerAccessor(&LatencyServerApp::m_downstreamResponseSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 LatencyServerApp::LatencyServerApp()
     : m_port(0), 
       m_listeningSocket(nullptr),
-      m_processingDelay(MilliSeconds(0))
+      m_processingDelay(MilliSeconds(0)),
+      m_slowdown(1.0),
+      m_honorServiceTimeHint(true),
+      m_workers(0),
+      m_maxQueueLength(0),
+      m_discipline(FIFO),
+      m_serviceModel(WORKER_POOL),
+      m_admissionPolicy(ADMIT_ALL),
+      m_admissionQueueLength(16),
+      m_admissionLatencyTarget(MilliSeconds(100)),
+      m_cachePolicy(CACHE_NONE),
+      m_cacheCapacity(1000),
+      m_cacheHitServiceTime(MilliSeconds(1)),
+      m_downstreamCallsPerRequest(1),
+      m_downstreamMode(DOWNSTREAM_SEQUENTIAL),
+      m_downstreamRequestSize(64),
+      m_downstreamResponseSize(64)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -69,12 +193,324 @@ LatencyServerApp::SetProcessingDelay(Time delay)
     m_processingDelay = delay;
 }
 
+void
+LatencyServerApp::SetServiceTimeDistribution(Ptr<ServiceTimeDistribution> serviceTime)
+{
+    NS_LOG_FUNCTION(this << serviceTime);
+    m_serviceTime = serviceTime;
+}
+
+void
+LatencyServerApp::ScheduleServiceTimeDistribution(Time at, Ptr<ServiceTimeDistribution> serviceTime)
+{
+    NS_LOG_FUNCTION(this << at << serviceTime);
+    m_scheduledServiceTimes.push_back(serviceTime);
+    Simulator::Schedule(std::max(at - Simulator::Now(), Time(0)),
+                        &LatencyServerApp::SetServiceTimeDistribution, this, serviceTime);
+}
+
+int64_t
+LatencyServerApp::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    int64_t used = m_serviceTime ? m_serviceTime->AssignStreams(stream) : 0;
+    for (Ptr<ServiceTimeDistribution> serviceTime : m_scheduledServiceTimes)
+    {
+        used += serviceTime->AssignStreams(stream + used);
+    }
+    if (m_downstream) {
+        used += m_downstream->AssignStreams(stream + used);
+    }
+    return used;
+}
+
+void
+LatencyServerApp::SetDownstream(Ptr<LoadBalancerApp> picker)
+{
+    NS_LOG_FUNCTION(this << picker);
+    m_downstream = picker;
+}
+
+void
+LatencyServerApp::SetSlowdown(double factor)
+{
+    NS_LOG_FUNCTION(this << factor);
+    m_slowdown = factor;
+    m_rampEnd = Time(0);
+}
+
+void
+LatencyServerApp::RampSlowdown(double factor, Time duration)
+{
+    NS_LOG_FUNCTION(this << factor << duration);
+    if (!duration.IsStrictlyPositive()) {
+        SetSlowdown(factor);
+        return;
+    }
+    m_rampFrom = GetSlowdown();
+    m_rampStart = Simulator::Now();
+    m_rampEnd = m_rampStart + duration;
+    m_slowdown = factor;
+}
+
+double
+LatencyServerApp::GetSlowdown() const
+{
+    const Time now = Simulator::Now();
+    if (now >= m_rampEnd) {
+        return m_slowdown;
+    }
+    const double progress = (now - m_rampStart).GetSeconds() / (m_rampEnd - m_rampStart).GetSeconds();
+    return m_rampFrom + progress * (m_slowdown - m_rampFrom);
+}
+
+void
+LatencyServerApp::Pause(Time duration)
+{
+    NS_LOG_FUNCTION(this << duration);
+    GetWorkClock(); // Folds in a pause that has already ended.
+    const Time now = Simulator::Now();
+    if (m_pausedUntil.IsStrictlyPositive()) {
+        m_pausedUntil = std::max(m_pausedUntil, now + duration);
+    } else {
+        m_pauseStart = now;
+        m_pausedUntil = now + duration;
+    }
+    m_pauses++;
+    NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Paused until " << m_pausedUntil.As(Time::S));
+}
+
+void
+LatencyServerApp::StopAccepting(Time duration)
+{
+    NS_LOG_FUNCTION(this << duration);
+    NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() << ") stops accepting connections"
+                  << (duration.IsStrictlyPositive() ? " for " + std::to_string(duration.GetSeconds()) + "s" : std::string()));
+    StopListening();
+    if (duration.IsStrictlyPositive()) {
+        Simulator::Schedule(duration, &LatencyServerApp::Listen, this);
+    }
+}
+
+void
+LatencyServerApp::Crash(Time restartAfter)
+{
+    NS_LOG_FUNCTION(this << restartAfter);
+    AccumulateLoad();
+    const uint64_t lost = m_queue.size() + m_sharedRequests.size() + m_parents.size()
+                          + (m_serviceModel == PROCESSOR_SHARING ? 0 : m_busyWorkers);
+    m_requestsLost += lost;
+    NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() << ") crashes, closing "
+                  << m_connectionSlots.size() << " connections and losing " << lost << " requests");
+
+    StopListening();
+    CloseConnections(true);
+    CloseDownstream();
+
+    // Requests in service die with the process: their completions belong to the old incarnation.
+    m_incarnation++;
+    m_busyWorkers = 0;
+    m_queue.clear();
+    m_queuedWork = Time(0);
+    m_sharedCompletion.Cancel();
+    m_sharedRequests.clear();
+    m_hungUntil = Time(0);
+    if (m_cache) {
+        m_cache->Clear(); // An in-process cache restarts cold.
+    }
+
+    if (restartAfter.IsStrictlyPositive()) {
+        Simulator::Schedule(restartAfter, &LatencyServerApp::Listen, this);
+    }
+}
+
+void
+LatencyServerApp::Hang(Time duration)
+{
+    NS_LOG_FUNCTION(this << duration);
+    const Time until = duration.IsStrictlyPositive() ? Simulator::Now() + duration : Time::Max();
+    m_hungUntil = std::max(m_hungUntil, until);
+    NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() << ") hangs until "
+                  << (m_hungUntil == Time::Max() ? std::string("the end") : std::to_string(m_hungUntil.GetSeconds()) + "s"));
+}
+
+void
+LatencyServerApp::TakeDown(Time duration)
+{
+    NS_LOG_FUNCTION(this << duration);
+    NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() << ") goes down"
+                  << (duration.IsStrictlyPositive() ? " for " + std::to_string(duration.GetSeconds()) + "s" : std::string()));
+    SetInterfacesUp(false);
+    if (duration.IsStrictlyPositive()) {
+        Simulator::Schedule(duration, &LatencyServerApp::SetInterfacesUp, this, true);
+    }
+}
+
+void
+LatencyServerApp::SetInterfacesUp(bool up)
+{
+    NS_LOG_FUNCTION(this << up);
+    Ptr<Ipv4> ipv4 = GetNode()->GetObject<Ipv4>();
+    if (!ipv4) {
+        NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): No IPv4 stack to take " << (up ? "up" : "down"));
+        return;
+    }
+    for (uint32_t i = 1; i < ipv4->GetNInterfaces(); ++i) // Interface 0 is the loopback.
+    {
+        if (up) {
+            ipv4->SetUp(i);
+        } else {
+            ipv4->SetDown(i);
+        }
+    }
+}
+
+uint64_t
+LatencyServerApp::GetRequestsLost() const
+{
+    return m_requestsLost;
+}
+
+uint32_t
+LatencyServerApp::GetPauseCount() const
+{
+    return m_pauses;
+}
+
+Time
+LatencyServerApp::GetPausedTime() const
+{
+    if (!m_pausedUntil.IsStrictlyPositive()) {
+        return m_pausedTotal;
+    }
+    return m_pausedTotal + std::min(Simulator::Now(), m_pausedUntil) - m_pauseStart;
+}
+
+Time
+LatencyServerApp::GetWorkClock()
+{
+    const Time now = Simulator::Now();
+    if (m_pausedUntil.IsStrictlyPositive() && now >= m_pausedUntil) {
+        m_pausedTotal += m_pausedUntil - m_pauseStart;
+        m_pausedUntil = Time(0);
+    }
+    if (m_pausedUntil.IsStrictlyPositive()) {
+        return m_pauseStart - m_pausedTotal; // Frozen for the rest of the pause.
+    }
+    return now - m_pausedTotal;
+}
+
 uint64_t
 LatencyServerApp::GetTotalRequestsReceived() const
 {
     return m_requestsReceived;
 }
 
+uint64_t
+LatencyServerApp::GetQueueFullRejections() const
+{
+    return m_queueFullRejections;
+}
+
+uint64_t
+LatencyServerApp::GetRequestsRejected() const
+{
+    return m_requestsRejected;
+}
+
+uint64_t
+LatencyServerApp::GetDeadlineMissCount() const
+{
+    return m_deadlineMisses;
+}
+
+uint64_t
+LatencyServerApp::GetCacheHits() const
+{
+    return m_cache ? m_cache->GetHits() : 0;
+}
+
+uint64_t
+LatencyServerApp::GetCacheMisses() const
+{
+    return m_cache ? m_cache->GetMisses() : 0;
+}
+
+double
+LatencyServerApp::GetCacheHitRatio() const
+{
+    return m_cache ? m_cache->GetHitRatio() : 0.0;
+}
+
+size_t
+LatencyServerApp::GetCacheSize() const
+{
+    return m_cache ? m_cache->GetSize() : 0;
+}
+
+uint64_t
+LatencyServerApp::GetDownstreamCallCount() const
+{
+    return m_downstreamCallsSent;
+}
+
+uint64_t
+LatencyServerApp::GetDownstreamFailures() const
+{
+    return m_downstreamFailures;
+}
+
+uint32_t
+LatencyServerApp::GetQueueLength() const
+{
+    return GetWaitingNow();
+}
+
+uint32_t
+LatencyServerApp::GetPeakQueueLength() const
+{
+    return m_peakQueueLength;
+}
+
+double
+LatencyServerApp::GetMeanQueueLength() const
+{
+    const Time end = m_loadEnd.IsStrictlyPositive() ? m_loadEnd : Simulator::Now();
+    const double elapsedS = (end - m_loadStart).GetSeconds();
+    if (elapsedS <= 0.0) {
+        return 0.0;
+    }
+    const double pendingS = std::max((end - m_lastLoadUpdate).GetSeconds(), 0.0);
+    return (m_queueLengthArea + static_cast<double>(GetWaitingNow()) * pendingS) / elapsedS;
+}
+
+double
+LatencyServerApp::GetMeanBusyWorkers() const
+{
+    const Time end = m_loadEnd.IsStrictlyPositive() ? m_loadEnd : Simulator::Now();
+    const double elapsedS = (end - m_loadStart).GetSeconds();
+    if (elapsedS <= 0.0) {
+        return 0.0;
+    }
+    const double pendingS = std::max((end - m_lastLoadUpdate).GetSeconds(), 0.0);
+    return (m_busyWorkersArea + static_cast<double>(GetBusyNow()) * pendingS) / elapsedS;
+}
+
+double
+LatencyServerApp::GetUtilization() const
+{
+    return (m_workers == 0) ? 0.0 : GetMeanBusyWorkers() / m_workers;
+}
+
+Time
+LatencyServerApp::GetMeanQueueingDelay() const
+{
+    if (m_requestsStarted == 0) {
+        return Time(0);
+    }
+    return NanoSeconds(m_queueingDelayTotal.GetNanoSeconds() / static_cast<int64_t>(m_requestsStarted));
+}
+
 void
 LatencyServerApp::DoDispose()
 {
@@ -83,14 +519,17 @@ LatencyServerApp::DoDispose()
         m_listeningSocket->Close();
         m_listeningSocket = nullptr;
     }
-    for (Ptr<Socket> socket : m_socketList)
-    {
-        if (socket) {
-            socket->Close();
-        }
-    }
-    m_socketList.clear();
-    m_rxBuffers.clear();
+    CloseConnections(false);
+    m_connections.clear();
+    m_freeConnections.clear();
+    m_queue.clear();
+    m_queuedWork = Time(0);
+    m_sharedCompletion.Cancel();
+    m_sharedRequests.clear();
+    m_serviceTime = nullptr;
+    m_cache.reset();
+    CloseDownstream();
+    m_downstream = nullptr;
     Application::DoDispose();
 }
 
@@ -100,6 +539,55 @@ LatencyServerApp::StartApplication()
     NS_LOG_FUNCTION(this);
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s LatencyServerApp on Node " << GetNode()->GetId() << " starting.");
 
+    if (m_serviceModel == PROCESSOR_SHARING && m_workers == 0) {
+        NS_FATAL_ERROR("Node " << GetNode()->GetId() << ": ProcessorSharing needs Workers > 0 (the number of cores).");
+    }
+    m_queue.clear();
+    m_queuedWork = Time(0);
+    m_arrivals = 0;
+    m_busyWorkers = 0;
+    m_sharedCompletion.Cancel();
+    m_sharedRequests.clear();
+    m_attainedService = 0.0;
+    m_sharedLastUpdate = GetWorkClock();
+    m_peakQueueLength = 0;
+    m_queueFullRejections = 0;
+    m_requestsRejected = 0;
+    m_deadlineMisses = 0;
+    m_requestsStarted = 0;
+    m_queueingDelayTotal = Time(0);
+    m_loadStart = Simulator::Now();
+    m_lastLoadUpdate = Simulator::Now();
+    m_loadEnd = Time(0);
+    m_queueLengthArea = 0.0;
+    m_busyWorkersArea = 0.0;
+    m_hungUntil = Time(0);
+    m_requestsLost = 0;
+    switch (m_cachePolicy)
+    {
+    case CACHE_LRU:
+        m_cache = std::make_unique<LruRequestCache>(m_cacheCapacity);
+        break;
+    case CACHE_ARC:
+        m_cache = std::make_unique<ArcRequestCache>(m_cacheCapacity);
+        break;
+    case CACHE_NONE:
+    default:
+        m_cache.reset();
+        break;
+    }
+    m_running = true;
+
+    Listen();
+}
+
+void
+LatencyServerApp::Listen()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_running) {
+        return; // A restart scheduled before the application stopped.
+    }
     if (!m_listeningSocket)
     {
         m_listeningSocket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
@@ -135,6 +623,22 @@ LatencyServerApp::StopApplication()
     NS_LOG_FUNCTION(this);
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s LatencyServerApp on Node " << GetNode()->GetId() << " stopping.");
 
+    m_running = false;
+    StopListening();
+
+    CloseConnections(false);
+    CloseDownstream();
+    // Waiting requests can no longer be answered; requests in service finish on their own.
+    AccumulateLoad();
+    m_loadEnd = Simulator::Now();
+    m_queue.clear();
+    m_queuedWork = Time(0);
+}
+
+void
+LatencyServerApp::StopListening()
+{
+    NS_LOG_FUNCTION(this);
     if (m_listeningSocket)
     {
         m_listeningSocket->Close();
@@ -142,15 +646,78 @@ LatencyServerApp::StopApplication()
                                              MakeNullCallback<void, Ptr<Socket>, const Address&>());
         m_listeningSocket = nullptr; 
     }
+}
+
+LatencyServerApp::ConnectionHandle
+LatencyServerApp::AddConnection(Ptr<Socket> socket)
+{
+    uint32_t slot;
+    if (!m_freeConnections.empty()) {
+        slot = m_freeConnections.back();
+        m_freeConnections.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_connections.size());
+        m_connections.emplace_back();
+    }
+    m_connections[slot].socket = socket;
+    m_connectionSlots[PeekPointer(socket)] = slot;
+    return ConnectionHandle{slot, m_connections[slot].generation};
+}
 
-    for (Ptr<Socket> socket : m_socketList)
+bool
+LatencyServerApp::FindConnection(Ptr<Socket> socket, ConnectionHandle& handle) const
+{
+    auto it = m_connectionSlots.find(PeekPointer(socket));
+    if (it == m_connectionSlots.end()) {
+        return false;
+    }
+    handle = ConnectionHandle{it->second, m_connections[it->second].generation};
+    return true;
+}
+
+LatencyServerApp::Connection*
+LatencyServerApp::GetConnection(ConnectionHandle handle)
+{
+    if (handle.slot >= m_connections.size()) {
+        return nullptr;
+    }
+    Connection& connection = m_connections[handle.slot];
+    return (connection.socket && connection.generation == handle.generation) ? &connection : nullptr;
+}
+
+void
+LatencyServerApp::ReleaseConnection(ConnectionHandle handle)
+{
+    Connection* connection = GetConnection(handle);
+    if (!connection) {
+        return;
+    }
+    m_connectionSlots.erase(PeekPointer(connection->socket));
+    connection->socket = nullptr;
+    connection->generation++;
+    std::string().swap(connection->rxBuffer);
+    connection->txQueue = SocketTxQueue();
+    m_freeConnections.push_back(handle.slot);
+}
+
+void
+LatencyServerApp::CloseConnections(bool silent)
+{
+    for (uint32_t slot = 0; slot < m_connections.size(); ++slot)
     {
-        if (socket) {
-            socket->Close();
+        Connection& connection = m_connections[slot];
+        if (!connection.socket) {
+            continue;
+        }
+        Ptr<Socket> socket = connection.socket;
+        ReleaseConnection(ConnectionHandle{slot, connection.generation});
+        if (silent) {
+            socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(), MakeNullCallback<void, Ptr<Socket>>());
+            socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+            socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
         }
+        socket->Close();
     }
-    m_socketList.clear();
-    m_rxBuffers.clear();
 }
 
 void
@@ -161,12 +728,12 @@ LatencyServerApp::HandleAccept(Ptr<Socket> newSocket, const Address& from)
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() 
                   << ") accepted connection from " << inetFrom);
 
-    m_socketList.push_back(newSocket);
-    m_rxBuffers.emplace(newSocket, ""); 
+    AddConnection(newSocket);
 
     newSocket->SetCloseCallbacks(MakeCallback(&LatencyServerApp::HandleClientClose, this),
                                  MakeCallback(&LatencyServerApp::HandleClientError, this));
     newSocket->SetRecvCallback(MakeCallback(&LatencyServerApp::HandleRead, this));
+    newSocket->SetSendCallback(MakeCallback(&LatencyServerApp::HandleSend, this));
 }
 
 void
@@ -186,8 +753,10 @@ LatencyServerApp::HandleClientClose(Ptr<Socket> socket)
     }
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Client " << peerId << " closed connection normally on Node " << GetNode()->GetId());
     
-    m_rxBuffers.erase(socket);
-    m_socketList.remove(socket);
+    ConnectionHandle connection;
+    if (FindConnection(socket, connection)) {
+        ReleaseConnection(connection);
+    }
 }
 
 void
@@ -210,8 +779,10 @@ LatencyServerApp::HandleClientError(Ptr<Socket> socket)
     NS_LOG_WARN(Simulator::Now().GetSeconds() << "s Error on client socket " << peerId 
                   << " on Node " << GetNode()->GetId() << ". Errno: " << err);
     
-    m_rxBuffers.erase(socket);
-    m_socketList.remove(socket);
+    ConnectionHandle connection;
+    if (FindConnection(socket, connection)) {
+        ReleaseConnection(connection);
+    }
 }
 
 
@@ -221,15 +792,15 @@ LatencyServerApp::HandleRead(Ptr<Socket> socket)
     NS_LOG_FUNCTION(this << socket);
     Ptr<Packet> packet;
     Address from; 
-    const uint32_t headerSize = RequestResponseHeader().GetSerializedSize();
 
-    auto bufferIt = m_rxBuffers.find(socket);
-    if (bufferIt == m_rxBuffers.end()) {
+    ConnectionHandle connection;
+    if (!FindConnection(socket, connection)) {
         NS_LOG_ERROR("Server (Node " << GetNode()->GetId() << "): HandleRead called for unknown or closed socket " 
                        << static_cast<void*>(PeekPointer(socket)));
         return;
     }
-    std::string& currentRxBuffer = bufferIt->second;
+    // The slab only grows on accept, never while reading, so the reference stays valid.
+    std::string& currentRxBuffer = m_connections[connection.slot].rxBuffer;
 
     while ((packet = socket->RecvFrom(from))) 
     {
@@ -248,8 +819,12 @@ LatencyServerApp::HandleRead(Ptr<Socket> socket)
                        << " bytes from " << InetSocketAddress::ConvertFrom(from) 
                        << ". Buffer size for this socket: " << currentRxBuffer.size());
 
-        while (currentRxBuffer.size() >= headerSize)
+        while (currentRxBuffer.size() >= RequestResponseHeader::PREFIX_SIZE)
         {
+            const uint32_t headerSize = RequestResponseHeader::PeekSerializedSize(reinterpret_cast<const uint8_t*>(currentRxBuffer.data()));
+            if (currentRxBuffer.size() < headerSize) {
+                break; // Header extensions still incomplete.
+            }
             Ptr<Packet> headerPeekPacket = Create<Packet>(
                 reinterpret_cast<const uint8_t*>(currentRxBuffer.data()),
                 headerSize);
@@ -267,7 +842,7 @@ LatencyServerApp::HandleRead(Ptr<Socket> socket)
             if (currentRxBuffer.size() >= expectedTotalSize) {
                 NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() 
                                << ") HandleRead: Processing complete request. Seq=" << reqHeader.GetSeq());
-                ProcessRequest(socket, reqHeader, expectedPayloadSize);
+                ProcessRequest(connection, reqHeader, expectedPayloadSize);
 
                 currentRxBuffer.erase(0, expectedTotalSize);
                 NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << ") HandleRead: Consumed " 
@@ -294,9 +869,27 @@ LatencyServerApp::HandleRead(Ptr<Socket> socket)
 }
 
 void
-LatencyServerApp::ProcessRequest(Ptr<Socket> socket, RequestResponseHeader header, uint32_t payloadSize)
+LatencyServerApp::HandleSend(Ptr<Socket> socket, uint32_t availableBytes)
+{
+    NS_LOG_FUNCTION(this << socket << availableBytes);
+    ConnectionHandle connection;
+    if (!FindConnection(socket, connection)) {
+        return;
+    }
+    SocketTxQueue& txQueue = m_connections[connection.slot].txQueue;
+    if (!txQueue.HasPending()) {
+        return;
+    }
+    if (!txQueue.Flush(socket)) {
+        NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): Error sending queued response bytes. Errno: "
+                      << socket->GetErrno());
+    }
+}
+
+void
+LatencyServerApp::ProcessRequest(ConnectionHandle connection, RequestResponseHeader header, uint32_t payloadSize)
 {
-    NS_LOG_FUNCTION(this << socket << header.GetSeq() << payloadSize);
+    NS_LOG_FUNCTION(this << connection.slot << header.GetSeq() << payloadSize);
     m_requestsReceived++;
 
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() 
@@ -305,47 +898,593 @@ LatencyServerApp::ProcessRequest(Ptr<Socket> socket, RequestResponseHeader heade
                   << ", PayloadSize=" << payloadSize 
                   << " (Total Server Rx: " << m_requestsReceived << ")");
 
-    if (m_processingDelay > Time(0))
+    if (IsExpired(header))
+    {
+        FailExpiredRequest(connection, header);
+        return;
+    }
+
+    Time serviceTime = m_processingDelay;
+    const bool cacheHit = m_cache && m_cache->Contains(header.GetL7Identifier());
+    if (cacheHit)
+    {
+        serviceTime = m_cacheHitServiceTime;
+    }
+    else if (m_honorServiceTimeHint && header.GetServiceTimeHint().IsStrictlyPositive())
+    {
+        serviceTime = header.GetServiceTimeHint();
+    }
+    else if (m_serviceTime)
+    {
+        serviceTime = m_serviceTime->GetNextServiceTime();
+    }
+    const double slowdown = GetSlowdown();
+    if (slowdown != 1.0)
+    {
+        serviceTime = NanoSeconds(std::llround(serviceTime.GetNanoSeconds() * slowdown));
+    }
+
+    if (!AdmitRequest(serviceTime))
+    {
+        m_requestsRejected++;
+        NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Rejecting Seq=" << header.GetSeq()
+                       << " (" << GetWaitingNow() << " waiting, predicted latency "
+                       << PredictLatency(serviceTime).As(Time::MS) << ")");
+        header.SetStatus(RequestResponseHeader::STATUS_REJECTED);
+        header.SetResponseSize(0);
+        SendResponse(connection, header);
+        return;
+    }
+
+    // With no room left (beyond the cores under processor sharing), the request is answered
+    // rather than dropped, so the sender can release what it tracks for it.
+    const bool full = m_maxQueueLength > 0
+                      && (m_serviceModel == PROCESSOR_SHARING
+                              ? m_sharedRequests.size() >= static_cast<size_t>(m_workers) + m_maxQueueLength
+                              : m_workers > 0 && m_busyWorkers >= m_workers && m_queue.size() >= m_maxQueueLength);
+    if (full)
+    {
+        m_queueFullRejections++;
+        NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Full ("
+                       << (m_serviceModel == PROCESSOR_SHARING ? m_sharedRequests.size() : m_queue.size())
+                       << (m_serviceModel == PROCESSOR_SHARING ? " sharing the cores" : " waiting")
+                       << "), rejecting Seq=" << header.GetSeq());
+        header.SetStatus(RequestResponseHeader::STATUS_REJECTED);
+        header.SetResponseSize(0);
+        SendResponse(connection, header);
+        return;
+    }
+
+    if (m_cache)
+    {
+        // Only requests that will be served touch the cache; a miss inserts its key.
+        m_cache->Access(header.GetL7Identifier());
+        NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Cache " << (cacheHit ? "hit" : "miss")
+                       << " for L7Id=" << header.GetL7Identifier() << ", service time " << serviceTime);
+    }
+
+    if (m_serviceModel == PROCESSOR_SHARING)
+    {
+        StartSharedService(connection, header, serviceTime);
+        return;
+    }
+    if (m_workers == 0 || m_busyWorkers < m_workers)
+    {
+        StartService(connection, header, serviceTime);
+        return;
+    }
+
+    AccumulateLoad();
+    m_arrivals++;
+    int64_t key = static_cast<int64_t>(m_arrivals);
+    if (m_discipline == LIFO) {
+        key = -key;
+    } else if (m_discipline == SHORTEST_FIRST) {
+        key = serviceTime.GetNanoSeconds();
+    }
+    m_queue.emplace(key, QueuedRequest{connection, header, serviceTime, Simulator::Now()});
+    m_queuedWork += serviceTime;
+    m_peakQueueLength = std::max(m_peakQueueLength, static_cast<uint32_t>(m_queue.size()));
+    NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): All " << m_workers << " workers busy, queued Seq="
+                   << header.GetSeq() << " (" << m_queue.size() << " waiting)");
+}
+
+bool
+LatencyServerApp::AdmitRequest(Time serviceTime) const
+{
+    switch (m_admissionPolicy)
+    {
+    case ADMIT_QUEUE_LENGTH:
+        return GetWaitingNow() < m_admissionQueueLength;
+    case ADMIT_LATENCY:
+        return PredictLatency(serviceTime) <= m_admissionLatencyTarget;
+    case ADMIT_ALL:
+    default:
+        return true;
+    }
+}
+
+Time
+LatencyServerApp::PredictLatency(Time serviceTime) const
+{
+    if (m_serviceModel == PROCESSOR_SHARING)
+    {
+        // Shared with everything already in service, assuming the others stay for its whole service.
+        const double sharing = static_cast<double>(m_sharedRequests.size() + 1) / m_workers;
+        return NanoSeconds(std::llround(serviceTime.GetNanoSeconds() * std::max(1.0, sharing)));
+    }
+    if (m_workers == 0 || m_busyWorkers < m_workers) {
+        return serviceTime;
+    }
+    // The waiting work drains across all workers; the requests in service are ignored.
+    return NanoSeconds(m_queuedWork.GetNanoSeconds() / m_workers) + serviceTime;
+}
+
+void
+LatencyServerApp::StartService(ConnectionHandle connection, RequestResponseHeader header, Time serviceTime)
+{
+    NS_LOG_FUNCTION(this << connection.slot << header.GetSeq() << serviceTime);
+    AccumulateLoad();
+    m_busyWorkers++;
+    m_requestsStarted++;
+
+    const Time workDone = GetWorkClock() + serviceTime;
+    if (serviceTime > Time(0))
     {
         NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Scheduling response for Seq=" 
-                       << header.GetSeq() << " after delay " << m_processingDelay);
-        Simulator::Schedule(m_processingDelay, &LatencyServerApp::SendResponse, this, socket, header);
+                       << header.GetSeq() << " after delay " << serviceTime);
+        Simulator::Schedule(serviceTime, &LatencyServerApp::CompleteService, this, connection, header, workDone, m_incarnation);
     }
     else
     {
-        SendResponse(socket, header);
+        CompleteService(connection, header, workDone, m_incarnation);
+    }
+}
+
+void
+LatencyServerApp::CompleteService(ConnectionHandle connection, RequestResponseHeader header, Time workDone, uint32_t incarnation)
+{
+    NS_LOG_FUNCTION(this << connection.slot << header.GetSeq() << workDone << incarnation);
+    if (incarnation != m_incarnation) {
+        return; // Lost in a crash; its worker no longer exists.
+    }
+    // Pauses since the request started push its completion back by the work it still lacks.
+    Time remaining = std::max(workDone - GetWorkClock(), Time(0));
+    if (m_pausedUntil.IsStrictlyPositive()) {
+        remaining += m_pausedUntil - Simulator::Now();
+    }
+    if (remaining.IsStrictlyPositive())
+    {
+        Simulator::Schedule(remaining, &LatencyServerApp::CompleteService, this, connection, header, workDone, incarnation);
+        return;
+    }
+    AccumulateLoad();
+    m_busyWorkers--;
+    FinishRequest(connection, header);
+
+    // Hand the freed worker to the next waiting request whose client is still connected.
+    while (!m_queue.empty() && (m_workers == 0 || m_busyWorkers < m_workers))
+    {
+        auto next = m_queue.begin();
+        QueuedRequest request = next->second;
+        m_queue.erase(next);
+        m_queuedWork -= request.serviceTime;
+        if (!GetConnection(request.connection)) {
+            NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Discarding queued Seq="
+                           << request.header.GetSeq() << ", its connection has closed.");
+            continue;
+        }
+        if (IsExpired(request.header)) {
+            FailExpiredRequest(request.connection, request.header);
+            continue;
+        }
+        m_queueingDelayTotal += Simulator::Now() - request.arrival;
+        StartService(request.connection, request.header, request.serviceTime);
     }
 }
 
 void
-LatencyServerApp::SendResponse(Ptr<Socket> socket, RequestResponseHeader header)
+LatencyServerApp::StartSharedService(ConnectionHandle connection, RequestResponseHeader header, Time serviceTime)
 {
-    NS_LOG_FUNCTION(this << socket << header.GetSeq());
+    NS_LOG_FUNCTION(this << connection.slot << header.GetSeq() << serviceTime);
+    AdvanceSharedService();
+    AccumulateLoad();
+    m_requestsStarted++;
+    m_sharedRequests.emplace(m_attainedService + serviceTime.GetSeconds(), SharedRequest{connection, header});
+    m_peakQueueLength = std::max(m_peakQueueLength, GetWaitingNow());
+    ScheduleSharedCompletion();
+}
+
+void
+LatencyServerApp::CompleteSharedService()
+{
+    NS_LOG_FUNCTION(this);
+    AdvanceSharedService();
+    AccumulateLoad();
+    // Tolerate the rounding of the completion event to whole nanoseconds.
+    constexpr double kToleranceS = 1e-9;
+    while (!m_sharedRequests.empty() && m_sharedRequests.begin()->first <= m_attainedService + kToleranceS)
+    {
+        SharedRequest request = m_sharedRequests.begin()->second;
+        m_sharedRequests.erase(m_sharedRequests.begin());
+        FinishRequest(request.connection, request.header);
+    }
+    ScheduleSharedCompletion();
+}
+
+void
+LatencyServerApp::AdvanceSharedService()
+{
+    const Time now = GetWorkClock();
+    if (!m_sharedRequests.empty()) {
+        const double rate = std::min(1.0, static_cast<double>(m_workers) / m_sharedRequests.size());
+        m_attainedService += (now - m_sharedLastUpdate).GetSeconds() * rate;
+    }
+    m_sharedLastUpdate = now;
+}
 
-    if (std::find(m_socketList.begin(), m_socketList.end(), socket) == m_socketList.end()) {
+void
+LatencyServerApp::ScheduleSharedCompletion()
+{
+    m_sharedCompletion.Cancel();
+    if (m_sharedRequests.empty()) {
+        return;
+    }
+    const double rate = std::min(1.0, static_cast<double>(m_workers) / m_sharedRequests.size());
+    const double remainingS = std::max(m_sharedRequests.begin()->first - m_attainedService, 0.0) / rate;
+    Time delay = NanoSeconds(static_cast<int64_t>(std::ceil(remainingS * 1e9)));
+    if (m_pausedUntil.IsStrictlyPositive()) {
+        delay += m_pausedUntil - Simulator::Now(); // No progress until the pause ends.
+    }
+    m_sharedCompletion = Simulator::Schedule(delay, &LatencyServerApp::CompleteSharedService, this);
+}
+
+uint32_t
+LatencyServerApp::GetBusyNow() const
+{
+    if (m_serviceModel == PROCESSOR_SHARING) {
+        return static_cast<uint32_t>(std::min<size_t>(m_sharedRequests.size(), m_workers));
+    }
+    return m_busyWorkers;
+}
+
+uint32_t
+LatencyServerApp::GetWaitingNow() const
+{
+    if (m_serviceModel == PROCESSOR_SHARING) {
+        return static_cast<uint32_t>(m_sharedRequests.size()) - GetBusyNow();
+    }
+    return static_cast<uint32_t>(m_queue.size());
+}
+
+void
+LatencyServerApp::AccumulateLoad()
+{
+    if (m_loadEnd.IsStrictlyPositive()) {
+        return; // Stopped: the averages cover the server's active period only.
+    }
+    const Time now = Simulator::Now();
+    const double elapsedS = (now - m_lastLoadUpdate).GetSeconds();
+    m_queueLengthArea += static_cast<double>(GetWaitingNow()) * elapsedS;
+    m_busyWorkersArea += static_cast<double>(GetBusyNow()) * elapsedS;
+    m_lastLoadUpdate = now;
+}
+
+void
+LatencyServerApp::FinishRequest(ConnectionHandle connection, RequestResponseHeader header)
+{
+    NS_LOG_FUNCTION(this << connection.slot << header.GetSeq());
+    if (!m_downstream || m_downstreamCallsPerRequest == 0) {
+        SendResponse(connection, header);
+        return;
+    }
+    const uint64_t parent = m_nextParent++;
+    m_parents.emplace(parent, ParentRequest{connection, header, m_downstreamCallsPerRequest, 0});
+    IssueDownstreamCalls(parent);
+}
+
+void
+LatencyServerApp::IssueDownstreamCalls(uint64_t parent)
+{
+    auto it = m_parents.find(parent);
+    if (it == m_parents.end()) {
+        return;
+    }
+    while (it->second.callsLeft > 0 && (m_downstreamMode == DOWNSTREAM_PARALLEL || it->second.outstanding == 0))
+    {
+        it->second.callsLeft--;
+        it->second.outstanding++;
+        if (IsExpired(it->second.header) || !SendDownstreamCall(parent, it->second.header)) {
+            CompleteDownstreamCall(parent, false);
+            return;
+        }
+    }
+}
+
+bool
+LatencyServerApp::SendDownstreamCall(uint64_t parent, const RequestResponseHeader& parentHeader)
+{
+    const uint64_t l7Identifier = parentHeader.GetL7Identifier();
+    NS_LOG_FUNCTION(this << parent << l7Identifier);
+    InetSocketAddress backend(Ipv4Address::GetAny(), 0);
+    if (!m_downstream->PickBackend(l7Identifier, backend)) {
+        NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): No next-tier server available for L7Id=" << l7Identifier);
+        return false;
+    }
+    Ptr<Socket> socket = GetDownstreamSocket(backend);
+    if (!socket) {
+        // Failed like a lost connection: the picker hears of it and the caller fails the request.
+        m_downstream->ReportBackendFailure(backend);
+        return false;
+    }
+
+    RequestResponseHeader callHeader;
+    callHeader.SetSeq(++m_downstreamSeq);
+    callHeader.SetTimestamp(Simulator::Now());
+    callHeader.SetPayloadSize(m_downstreamRequestSize);
+    callHeader.SetL7Identifier(l7Identifier);
+    callHeader.SetResponseSize(m_downstreamResponseSize);
+    callHeader.SetDeadline(parentHeader.GetDeadline());
+    Ptr<Packet> packet = Create<Packet>(m_downstreamRequestSize);
+    packet->AddHeader(callHeader);
+
+    m_downstreamInFlight.emplace(m_downstreamSeq, DownstreamCall{parent, backend, socket, Simulator::Now()});
+    m_downstreamCallsSent++;
+    m_downstream->ReportRequestSent(backend);
+    NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Calling " << backend << " with Seq=" << m_downstreamSeq
+                   << " for request " << parent);
+    // TCP buffers data sent while still connecting, so a new connection can be used at once.
+    if (!m_downstreamConnections.at(backend).txQueue.Send(socket, packet)) {
+        NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): Error sending downstream call to " << backend
+                      << ". Errno: " << socket->GetErrno());
+    }
+    return true;
+}
+
+void
+LatencyServerApp::CompleteDownstreamCall(uint64_t parent, bool ok)
+{
+    auto it = m_parents.find(parent);
+    if (it == m_parents.end()) {
+        return; // Already failed by another of its calls.
+    }
+    ParentRequest& request = it->second;
+    request.outstanding--;
+    if (!ok)
+    {
+        // Fail fast, like a mid tier answering 503 when a dependency fails.
+        const ConnectionHandle connection = request.connection;
+        RequestResponseHeader header = request.header;
+        m_parents.erase(it);
+        if (IsExpired(header)) {
+            FailExpiredRequest(connection, header);
+            return;
+        }
+        m_downstreamFailures++;
+        header.SetStatus(RequestResponseHeader::STATUS_REJECTED);
+        header.SetResponseSize(0);
+        SendResponse(connection, header);
+        return;
+    }
+    if (request.callsLeft == 0 && request.outstanding == 0)
+    {
+        const ConnectionHandle connection = request.connection;
+        const RequestResponseHeader header = request.header;
+        m_parents.erase(it);
+        SendResponse(connection, header);
+        return;
+    }
+    IssueDownstreamCalls(parent);
+}
+
+Ptr<Socket>
+LatencyServerApp::GetDownstreamSocket(const InetSocketAddress& backend)
+{
+    auto it = m_downstreamConnections.find(backend);
+    if (it != m_downstreamConnections.end()) {
+        return it->second.socket;
+    }
+    Ptr<Socket> socket = Socket::CreateSocket(GetNode(), TcpSocketFactory::GetTypeId());
+    if (socket->Bind() == -1 || socket->Connect(backend) == -1) {
+        NS_LOG_WARN(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId()
+                      << "): Failed to open a connection to next-tier server " << backend
+                      << ". Errno: " << socket->GetErrno());
+        socket->Close();
+        return nullptr;
+    }
+    socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(),
+                               MakeCallback(&LatencyServerApp::HandleDownstreamLoss, this));
+    socket->SetCloseCallbacks(MakeCallback(&LatencyServerApp::HandleDownstreamLoss, this),
+                              MakeCallback(&LatencyServerApp::HandleDownstreamLoss, this));
+    socket->SetRecvCallback(MakeCallback(&LatencyServerApp::HandleDownstreamRead, this));
+    socket->SetSendCallback(MakeCallback(&LatencyServerApp::HandleDownstreamSend, this));
+    m_downstreamConnections.emplace(backend, DownstreamConnection{socket, std::string(), SocketTxQueue()});
+    NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId()
+                  << ") connecting to next-tier server " << backend);
+    return socket;
+}
+
+void
+LatencyServerApp::HandleDownstreamRead(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    auto connIt = std::find_if(m_downstreamConnections.begin(), m_downstreamConnections.end(),
+                               [&socket](const auto& entry) { return entry.second.socket == socket; });
+    if (connIt == m_downstreamConnections.end()) {
+        return;
+    }
+    std::string& rxBuffer = connIt->second.rxBuffer;
+    std::vector<std::pair<uint64_t, bool>> completed; // Finished after parsing: answering may close sockets.
+    Ptr<Packet> packet;
+    Address from;
+    while ((packet = socket->RecvFrom(from)) && packet->GetSize() > 0)
+    {
+        std::string chunk(packet->GetSize(), '\0');
+        packet->CopyData(reinterpret_cast<uint8_t*>(chunk.data()), packet->GetSize());
+        rxBuffer.append(chunk);
+        while (rxBuffer.size() >= RequestResponseHeader::PREFIX_SIZE)
+        {
+            const uint32_t headerSize = RequestResponseHeader::PeekSerializedSize(reinterpret_cast<const uint8_t*>(rxBuffer.data()));
+            if (rxBuffer.size() < headerSize) {
+                break; // Header extensions still incomplete.
+            }
+            RequestResponseHeader respHeader;
+            if (Create<Packet>(reinterpret_cast<const uint8_t*>(rxBuffer.data()), headerSize)->PeekHeader(respHeader) != headerSize) {
+                NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): Could not peek complete header from next-tier server "
+                              << connIt->first << ". Possible data corruption.");
+                break;
+            }
+            const uint32_t totalSize = headerSize + respHeader.GetPayloadSize();
+            if (rxBuffer.size() < totalSize) {
+                break;
+            }
+            rxBuffer.erase(0, totalSize);
+
+            auto callIt = m_downstreamInFlight.find(respHeader.GetSeq());
+            if (callIt == m_downstreamInFlight.end()) {
+                continue;
+            }
+            const DownstreamCall call = callIt->second;
+            m_downstreamInFlight.erase(callIt);
+            const Time rtt = Simulator::Now() - call.sendTime;
+            const bool ok = respHeader.GetStatus() == RequestResponseHeader::STATUS_OK;
+            if (ok) {
+                m_downstream->ReportBackendLatency(call.backend, rtt);
+            } else if (respHeader.GetStatus() == RequestResponseHeader::STATUS_DEADLINE_EXCEEDED) {
+                m_downstream->ReportBackendDeadlineMiss(call.backend, rtt);
+            } else {
+                m_downstream->ReportBackendRejection(call.backend, rtt);
+            }
+            m_downstream->ReportRequestFinished(call.backend);
+            completed.emplace_back(call.parent, ok);
+        }
+    }
+    for (const auto& [parent, ok] : completed)
+    {
+        CompleteDownstreamCall(parent, ok);
+    }
+}
+
+void
+LatencyServerApp::HandleDownstreamSend(Ptr<Socket> socket, uint32_t availableBytes)
+{
+    NS_LOG_FUNCTION(this << socket << availableBytes);
+    for (auto& [backend, connection] : m_downstreamConnections)
+    {
+        if (connection.socket == socket && connection.txQueue.HasPending()) {
+            connection.txQueue.Flush(socket);
+        }
+    }
+}
+
+void
+LatencyServerApp::HandleDownstreamLoss(Ptr<Socket> socket)
+{
+    NS_LOG_FUNCTION(this << socket);
+    auto connIt = std::find_if(m_downstreamConnections.begin(), m_downstreamConnections.end(),
+                               [&socket](const auto& entry) { return entry.second.socket == socket; });
+    if (connIt == m_downstreamConnections.end()) {
+        return;
+    }
+    NS_LOG_WARN(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() << "): Connection to next-tier server "
+                  << connIt->first << " lost. Errno: " << socket->GetErrno());
+    // The next call to this server opens a new connection.
+    m_downstreamConnections.erase(connIt);
+
+    std::vector<uint64_t> failed;
+    for (auto it = m_downstreamInFlight.begin(); it != m_downstreamInFlight.end();)
+    {
+        if (it->second.socket != socket) {
+            ++it;
+            continue;
+        }
+        m_downstream->ReportBackendFailure(it->second.backend);
+        m_downstream->ReportRequestFinished(it->second.backend);
+        failed.push_back(it->second.parent);
+        it = m_downstreamInFlight.erase(it);
+    }
+    for (uint64_t parent : failed)
+    {
+        CompleteDownstreamCall(parent, false);
+    }
+}
+
+uint64_t
+LatencyServerApp::CloseDownstream()
+{
+    for (auto& [backend, connection] : m_downstreamConnections)
+    {
+        connection.socket->SetConnectCallback(MakeNullCallback<void, Ptr<Socket>>(), MakeNullCallback<void, Ptr<Socket>>());
+        connection.socket->SetCloseCallbacks(MakeNullCallback<void, Ptr<Socket>>(), MakeNullCallback<void, Ptr<Socket>>());
+        connection.socket->SetRecvCallback(MakeNullCallback<void, Ptr<Socket>>());
+        connection.socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        connection.socket->Close();
+    }
+    m_downstreamConnections.clear();
+    for (const auto& [seq, call] : m_downstreamInFlight)
+    {
+        m_downstream->ReportRequestFinished(call.backend);
+    }
+    m_downstreamInFlight.clear();
+    const uint64_t waiting = m_parents.size();
+    m_parents.clear();
+    return waiting;
+}
+
+void
+LatencyServerApp::SendResponse(ConnectionHandle connection, RequestResponseHeader header)
+{
+    NS_LOG_FUNCTION(this << connection.slot << header.GetSeq());
+
+    Connection* client = GetConnection(connection);
+    if (!client) {
         NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): Cannot send response to Seq=" 
                       << header.GetSeq() << ", socket is no longer valid or active.");
         return;
     }
-    header.SetPayloadSize(0); 
+    if (Simulator::Now() < m_hungUntil) {
+        m_requestsLost++;
+        NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Hung, never answering Seq=" << header.GetSeq());
+        return;
+    }
+    const uint32_t responseSize = header.GetResponseSize();
+    header.SetPayloadSize(responseSize);
 
-    Ptr<Packet> responsePacket = Create<Packet>(0); 
+    Ptr<Packet> responsePacket = Create<Packet>(responseSize);
     responsePacket->AddHeader(header);
 
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s Server (Node " << GetNode()->GetId() 
                   << ") sending response Seq=" << header.GetSeq() 
-                  << ", L7Id=" << header.GetL7Identifier());
+                  << ", L7Id=" << header.GetL7Identifier()
+                  << ", PayloadSize=" << responseSize);
 
-    int bytesSent = socket->Send(responsePacket);
-    if (bytesSent < 0)
+    SocketTxQueue& txQueue = client->txQueue;
+    if (!txQueue.Send(client->socket, responsePacket))
     {
         NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): Error sending response for Seq=" 
-                      << header.GetSeq() << ". Errno: " << socket->GetErrno());
-    } else if (static_cast<uint32_t>(bytesSent) < responsePacket->GetSize()) {
-         NS_LOG_WARN("Server (Node " << GetNode()->GetId() << "): Could not send full response for Seq=" 
-                       << header.GetSeq() << ". Sent " << bytesSent << "/" << responsePacket->GetSize()
-                       << ". TCP will manage.");
+                      << header.GetSeq() << ". Errno: " << client->socket->GetErrno());
+    } else if (txQueue.HasPending()) {
+         NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Response for Seq=" << header.GetSeq()
+                        << " partly queued; " << txQueue.GetPendingBytes() << " bytes wait for send-buffer space.");
     }
 }
 
+bool
+LatencyServerApp::IsExpired(const RequestResponseHeader& header) const
+{
+    const Time deadline = header.GetDeadline();
+    return !deadline.IsZero() && deadline <= Simulator::Now();
+}
+
+void
+LatencyServerApp::FailExpiredRequest(ConnectionHandle connection, RequestResponseHeader header)
+{
+    m_deadlineMisses++;
+    NS_LOG_DEBUG("Server (Node " << GetNode()->GetId() << "): Deadline of Seq=" << header.GetSeq() << " passed "
+                   << (Simulator::Now() - header.GetDeadline()).As(Time::MS) << " ago, skipping it");
+    header.SetStatus(RequestResponseHeader::STATUS_DEADLINE_EXCEEDED);
+    header.SetResponseSize(0);
+    SendResponse(connection, header);
+}
+
 } // namespace ns3
@@ -3,33 +3,87 @@
 
 // NS-3 Includes
 #include "ns3/application.h"
+#include "ns3/event-id.h"
 #include "ns3/inet-socket-address.h" 
 #include "ns3/nstime.h"              
 #include "ns3/ptr.h"
 
 // Standard Library Includes
-#include <list>   
 #include <map>    
+#include <memory> // For std::unique_ptr
 #include <string> 
+#include <unordered_map>
+#include <vector>
 #include <cstdint> 
 
 // Project-Specific Includes
 #include "request_response_header.h" 
+#include "socket_tx_queue.h"         // Send queue for responses larger than the socket buffer
+#include "service_time_distribution.h" // Per-request service times
+#include "request_cache.h"             // Cache model keyed by L7 identifier
 
 namespace ns3 {
 
 // Forward declaration
 class Socket;
 class Address; 
+class LoadBalancerApp;
 
 /**
  * @brief A server application that receives requests and sends responses for latency measurement.
  *
  * This TCP server listens for incoming connections. For each connected client,
  * it reads requests formatted with a RequestResponseHeader, simulates an optional
- * processing delay, and then sends a response back. The response typically echoes
- * the header information from the request, with a payload size of zero.
+ * processing delay (or the request's service-time hint, if present), and then sends a response back. The delay is
+ * constant (ProcessingDelay) unless a ServiceTime distribution is set, which draws one per request. The response echoes
+ * the header information from the request, with the payload size the request asked for (its response size).
  * It tracks the total number of requests received.
+ *
+ * By default every request is served as soon as it arrives, i.e. the server has unlimited
+ * parallelism. With Workers = K > 0, at most K requests are in service at once; the rest
+ * wait in a queue ordered by QueueDiscipline (FIFO, LIFO, or shortest service time first),
+ * so latency grows with load. A request that finds MaxQueueLength requests already waiting
+ * is answered at once with STATUS_REJECTED, so whoever sent it can release it. The server
+ * tracks the time-averaged and peak queue length, worker utilization and queueing delay.
+ *
+ * With ServiceModel = ProcessorSharing the K workers are instead K CPU cores shared equally
+ * by every request in service: with n requests each progresses at rate min(1, K/n), so no
+ * request waits but all slow down together. MaxQueueLength then caps the requests beyond K
+ * that may share the cores; further arrivals are rejected as with a full queue. The
+ * requests beyond K count as the queue in the statistics, and the queueing delay is zero.
+ *
+ * An AdmissionPolicy sheds load before it queues: a request that would wait behind too many
+ * others (QueueLength) or whose predicted latency exceeds a target (LatencyTarget) is
+ * answered at once with a response of status STATUS_REJECTED and no payload, so the client
+ * or load balancer learns of the overload immediately instead of through a timeout.
+ *
+ * With a CachePolicy (LRU or ARC) the server models a cache of CacheCapacity request keys
+ * (L7 identifiers): a request whose key is cached takes CacheHitServiceTime, a miss takes
+ * the normal service time and inserts its key. Key affinity (RingHash, Maglev) then pays
+ * off as a higher hit ratio.
+ *
+ * Given a Downstream picker (a LoadBalancerApp used only to choose backends, as a client
+ * sidecar does), the server is a mid tier: once its own service time has elapsed it makes
+ * DownstreamCalls requests to the next tier, one after another or all at once
+ * (DownstreamMode), and responds only when every call has been answered. The calls carry the
+ * request's L7 identifier and go over the server's own connections, one per downstream
+ * server, and the picker is fed their latencies, rejections and failures. A rejected or
+ * lost call fails the request at once with a rejection. Downstream calls have no timeout
+ * of their own: a hung next tier is only noticed by the client's timeout.
+ *
+ * A request whose header carries a deadline is not worth serving once the deadline has
+ * passed: it is answered at once with STATUS_DEADLINE_EXCEEDED when it arrives expired or
+ * is taken expired from the queue, and a mid tier stops calling the next tier for it. The
+ * deadline is passed on to the downstream calls.
+ *
+ * For time-varying faults (see DegradationScenario) the server can be slowed down by a
+ * factor, stepped or ramped, and paused: during a pause, as in a stop-the-world garbage
+ * collection, no request makes progress and no response is sent.
+ *
+ * It can also fail outright, for fault-injection runs: stop accepting connections, crash
+ * (every connection is closed and all requests in progress are lost, then it restarts),
+ * hang (requests are read and served but never answered), or go down (its network
+ * interfaces stop, so peers only notice through TCP timeouts).
  */
 class LatencyServerApp : public Application
 {
@@ -40,6 +94,54 @@ class LatencyServerApp : public Application
      */
     static TypeId GetTypeId();
 
+    /**
+     * @brief Order in which waiting requests are taken into service.
+     */
+    enum QueueDiscipline
+    {
+        FIFO,          //!< Oldest request first.
+        LIFO,          //!< Newest request first.
+        SHORTEST_FIRST //!< Shortest service time first (ties in arrival order).
+    };
+
+    /**
+     * @brief How requests share the server's capacity.
+     */
+    enum ServiceModel
+    {
+        WORKER_POOL,        //!< K workers serve one request each; the rest wait in the queue.
+        PROCESSOR_SHARING   //!< K cores are shared equally by all requests in service.
+    };
+
+    /**
+     * @brief When the server rejects a request instead of serving it.
+     */
+    enum AdmissionPolicy
+    {
+        ADMIT_ALL,          //!< Serve every request (subject to MaxQueueLength).
+        ADMIT_QUEUE_LENGTH, //!< Reject when AdmissionQueueLength requests are already waiting.
+        ADMIT_LATENCY       //!< Reject when the predicted latency exceeds AdmissionLatencyTarget.
+    };
+
+    /**
+     * @brief Eviction policy of the server's cache model.
+     */
+    enum CachePolicy
+    {
+        CACHE_NONE, //!< No cache: every request takes the normal service time.
+        CACHE_LRU,  //!< Least recently used eviction.
+        CACHE_ARC   //!< Adaptive Replacement Cache.
+    };
+
+    /**
+     * @brief How a mid-tier server issues its downstream calls.
+     */
+    enum DownstreamMode
+    {
+        DOWNSTREAM_SEQUENTIAL, //!< Each call is sent when the previous one is answered.
+        DOWNSTREAM_PARALLEL    //!< All calls are sent at once.
+    };
+
     LatencyServerApp();
     virtual ~LatencyServerApp() override;
 
@@ -49,12 +151,207 @@ class LatencyServerApp : public Application
      */
     void SetProcessingDelay(Time delay);
 
+    /**
+     * @brief Sets the distribution each request's service time is drawn from, overriding
+     * the constant ProcessingDelay.
+     * @param serviceTime The service-time distribution (nullptr restores ProcessingDelay).
+     */
+    void SetServiceTimeDistribution(Ptr<ServiceTimeDistribution> serviceTime);
+
+    /**
+     * @brief Switches to another service-time distribution at a given simulation time.
+     * The distribution's random variables are covered by AssignStreams(), so this must be
+     * called before the server's streams are assigned.
+     * @param at Absolute simulation time of the switch.
+     * @param serviceTime The service-time distribution to use from then on.
+     */
+    void ScheduleServiceTimeDistribution(Time at, Ptr<ServiceTimeDistribution> serviceTime);
+
+    /**
+     * @brief Makes the server a mid tier that calls the next tier before responding.
+     * The picker's random variables are covered by AssignStreams(), so this must be called
+     * before the server's streams are assigned.
+     * @param picker Picker holding the next tier's servers (nullptr makes this a leaf server).
+     */
+    void SetDownstream(Ptr<LoadBalancerApp> picker);
+
+    /**
+     * @brief Multiplies the service time of requests arriving from now on, ending any ramp.
+     * @param factor The slowdown factor (1 = healthy).
+     */
+    void SetSlowdown(double factor);
+
+    /**
+     * @brief Moves the slowdown factor linearly from its current value to @p factor.
+     * @param factor The slowdown factor reached at the end of the ramp.
+     * @param duration How long the ramp takes (zero steps at once).
+     */
+    void RampSlowdown(double factor, Time duration);
+
+    /**
+     * @brief Gets the slowdown factor applied to requests arriving now.
+     * @return The current slowdown factor.
+     */
+    double GetSlowdown() const;
+
+    /**
+     * @brief Stops all request processing for a while. Overlapping pauses merge.
+     * @param duration Length of the pause.
+     */
+    void Pause(Time duration);
+
+    /**
+     * @brief Closes the listening socket, so new connections are refused; existing
+     * connections are still served.
+     * @param duration How long until the server accepts connections again (zero = never).
+     */
+    void StopAccepting(Time duration);
+
+    /**
+     * @brief Simulates a process crash: stops listening, closes every client connection and
+     * loses the requests waiting or in service, then restarts with no state.
+     * @param restartAfter How long until the server listens again (zero = never).
+     */
+    void Crash(Time restartAfter);
+
+    /**
+     * @brief Keeps accepting and serving requests but sends no response for a while; the
+     * responses due in that time are lost.
+     * @param duration How long the server hangs (zero = for good).
+     */
+    void Hang(Time duration);
+
+    /**
+     * @brief Takes the server's network interfaces down, as if the host lost power or was
+     * partitioned away: packets are neither sent nor received.
+     * @param duration How long until the interfaces come back up (zero = never).
+     */
+    void TakeDown(Time duration);
+
+    /**
+     * @brief Gets the number of requests lost to crashes and hangs.
+     * @return The lost request count.
+     */
+    uint64_t GetRequestsLost() const;
+
+    /**
+     * @brief Gets the number of pauses so far.
+     * @return The pause count.
+     */
+    uint32_t GetPauseCount() const;
+
+    /**
+     * @brief Gets the total time the server has spent paused.
+     * @return The paused time up to now.
+     */
+    Time GetPausedTime() const;
+
+    /**
+     * @brief Assigns fixed random variable stream numbers to the random variables used by this server.
+     * @param stream First stream index to use.
+     * @return The number of stream indices assigned.
+     */
+    virtual int64_t AssignStreams(int64_t stream) override;
+
     /**
      * @brief Retrieves the total number of requests processed by this server instance.
      * @return The total count of processed requests.
      */
     uint64_t GetTotalRequestsReceived() const;
 
+    /**
+     * @brief Gets the number of requests rejected because MaxQueueLength requests were
+     * already waiting (or, under processor sharing, sharing the cores beyond Workers).
+     * Admission policy rejections are counted by GetRequestsRejected() instead.
+     * @return The full-queue rejection count.
+     */
+    uint64_t GetQueueFullRejections() const;
+
+    /**
+     * @brief Gets the number of requests rejected by the admission policy.
+     * @return The rejected request count.
+     */
+    uint64_t GetRequestsRejected() const;
+
+    /**
+     * @brief Gets the number of requests answered with STATUS_DEADLINE_EXCEEDED instead of
+     * being (fully) served because their deadline had passed.
+     * @return The deadline miss count.
+     */
+    uint64_t GetDeadlineMissCount() const;
+
+    /**
+     * @brief Gets the number of admitted requests whose key was cached.
+     * @return The cache hit count (0 without a cache).
+     */
+    uint64_t GetCacheHits() const;
+
+    /**
+     * @brief Gets the number of admitted requests whose key was not cached.
+     * @return The cache miss count (0 without a cache).
+     */
+    uint64_t GetCacheMisses() const;
+
+    /**
+     * @brief Gets the fraction of admitted requests that hit the cache.
+     * @return The hit ratio (0 without a cache or before the first request).
+     */
+    double GetCacheHitRatio() const;
+
+    /**
+     * @brief Gets the number of keys currently cached.
+     * @return The cache size (0 without a cache).
+     */
+    size_t GetCacheSize() const;
+
+    /**
+     * @brief Gets the number of calls sent to the next tier.
+     * @return The downstream call count (0 for a leaf server).
+     */
+    uint64_t GetDownstreamCallCount() const;
+
+    /**
+     * @brief Gets the number of requests failed because a downstream call was rejected or lost.
+     * @return The failed request count.
+     */
+    uint64_t GetDownstreamFailures() const;
+
+    /**
+     * @brief Gets the number of requests currently waiting for a worker.
+     * @return The current queue length.
+     */
+    uint32_t GetQueueLength() const;
+
+    /**
+     * @brief Gets the longest queue seen since the server started.
+     * @return The peak queue length.
+     */
+    uint32_t GetPeakQueueLength() const;
+
+    /**
+     * @brief Gets the time-averaged queue length between the server's start and stop (or now).
+     * @return The mean number of waiting requests.
+     */
+    double GetMeanQueueLength() const;
+
+    /**
+     * @brief Gets the time-averaged number of requests in service between the server's start and stop (or now).
+     * @return The mean number of busy workers.
+     */
+    double GetMeanBusyWorkers() const;
+
+    /**
+     * @brief Gets the fraction of worker capacity in use between the server's start and stop (or now).
+     * @return Mean busy workers divided by Workers, or 0 with unlimited workers.
+     */
+    double GetUtilization() const;
+
+    /**
+     * @brief Gets the mean time requests spent waiting for a worker (0 for those served at once).
+     * @return The mean queueing delay of the requests taken into service.
+     */
+    Time GetMeanQueueingDelay() const;
+
   protected:
     /**
      * @brief Called by the simulation core to dispose of the application's resources.
@@ -62,6 +359,28 @@ class LatencyServerApp : public Application
     virtual void DoDispose() override;
 
   private:
+    /**
+     * @brief Refers to one accepted connection. Scheduled work holds a handle rather than the
+     * socket: releasing a slot bumps its generation, so a handle that outlived its connection
+     * is recognized in O(1) and the slot can be reused.
+     */
+    struct ConnectionHandle
+    {
+        uint32_t slot;                   //!< Index in m_connections.
+        uint32_t generation;             //!< Generation of the slot when the handle was issued.
+    };
+
+    /**
+     * @brief One slot of the connection slab.
+     */
+    struct Connection
+    {
+        Ptr<Socket> socket;              //!< The client socket (null while the slot is free).
+        uint32_t generation = 0;         //!< Bumped whenever the slot is released.
+        std::string rxBuffer;            //!< Received bytes not yet parsed into requests (stream reassembly).
+        SocketTxQueue txQueue;           //!< Response bytes waiting for send-buffer space.
+    };
+
     /**
      * @brief Called by the simulation core when the application is scheduled to start.
      * Initializes the listening socket.
@@ -74,6 +393,56 @@ class LatencyServerApp : public Application
      */
     virtual void StopApplication() override;
 
+    /**
+     * @brief Opens the listening socket unless it is already open.
+     */
+    void Listen();
+
+    /**
+     * @brief Closes the listening socket, if open.
+     */
+    void StopListening();
+
+    /**
+     * @brief Sets the administrative state of the node's network interfaces (except loopback).
+     * @param up True to bring them up, false to take them down.
+     */
+    void SetInterfacesUp(bool up);
+
+    /**
+     * @brief Puts an accepted socket into a free slot of the connection slab.
+     * @param socket The accepted socket.
+     * @return The handle of the new connection.
+     */
+    ConnectionHandle AddConnection(Ptr<Socket> socket);
+
+    /**
+     * @brief Finds the connection of a socket.
+     * @param socket A client socket.
+     * @param handle Set to the connection's handle if found.
+     * @return True if the socket is a live connection.
+     */
+    bool FindConnection(Ptr<Socket> socket, ConnectionHandle& handle) const;
+
+    /**
+     * @brief Gets a live connection.
+     * @param handle The connection's handle.
+     * @return The connection, or nullptr if it has been released since the handle was issued.
+     */
+    Connection* GetConnection(ConnectionHandle handle);
+
+    /**
+     * @brief Releases a connection's slot for reuse, invalidating its handles.
+     * @param handle The connection's handle.
+     */
+    void ReleaseConnection(ConnectionHandle handle);
+
+    /**
+     * @brief Closes and releases every connection.
+     * @param silent True to detach the callbacks first, so the closes are not reported back.
+     */
+    void CloseConnections(bool silent);
+
     /**
      * @brief Callback invoked when a new client attempts to connect to the listening socket.
      * @param newSocket The newly accepted socket representing the client connection.
@@ -100,33 +469,324 @@ class LatencyServerApp : public Application
      */
     void HandleRead(Ptr<Socket> socket);
 
+    /**
+     * @brief Callback invoked when a client socket has free send-buffer space.
+     * Continues sending queued response bytes.
+     * @param socket The client socket.
+     * @param availableBytes The free space in the socket's send buffer.
+     */
+    void HandleSend(Ptr<Socket> socket, uint32_t availableBytes);
+
     /**
      * @brief Processes a fully assembled request received from a client.
-     * @param socket The client socket from which the request originated.
+     * @param connection The connection the request came from.
      * @param header The deserialized RequestResponseHeader from the request.
      * @param payloadSize The size of the payload that accompanied the header (may not be used by server logic).
      */
-    void ProcessRequest(Ptr<Socket> socket, RequestResponseHeader header, uint32_t payloadSize);
+    void ProcessRequest(ConnectionHandle connection, RequestResponseHeader header, uint32_t payloadSize);
+
+    /**
+     * @brief Applies the admission policy to an arriving request.
+     * @param serviceTime How long serving the request would take.
+     * @return True if the request may be served, false if it must be rejected.
+     */
+    bool AdmitRequest(Time serviceTime) const;
+
+    /**
+     * @brief Estimates how long an arriving request would take to complete: its queueing
+     * delay behind the work already waiting, spread over the workers, plus its own service
+     * time (stretched by the current sharing under processor sharing).
+     * @param serviceTime How long serving the request takes on a dedicated worker.
+     * @return The predicted latency.
+     */
+    Time PredictLatency(Time serviceTime) const;
+
+    /**
+     * @brief Puts a request into service on a free worker.
+     * @param connection The connection the request came from.
+     * @param header The request's header.
+     * @param serviceTime How long serving the request takes.
+     */
+    void StartService(ConnectionHandle connection, RequestResponseHeader header, Time serviceTime);
+
+    /**
+     * @brief Finishes a request: frees its worker, sends the response and takes the next
+     * waiting request into service. If pauses have delayed the request, it is rescheduled instead.
+     * @param connection The connection the request came from.
+     * @param header The request's header.
+     * @param workDone Work clock reading at which the request's service is complete.
+     * @param incarnation The server incarnation (see Crash()) the request was started in.
+     */
+    void CompleteService(ConnectionHandle connection, RequestResponseHeader header, Time workDone, uint32_t incarnation);
+
+    /**
+     * @brief Answers a request whose service is complete, after calling the next tier if
+     * the server has one.
+     * @param connection The connection the request came from.
+     * @param header The request's header.
+     */
+    void FinishRequest(ConnectionHandle connection, RequestResponseHeader header);
+
+    /**
+     * @brief Sends the downstream calls of a request that the DownstreamMode allows now.
+     * @param parent Id of the request in m_parents.
+     */
+    void IssueDownstreamCalls(uint64_t parent);
+
+    /**
+     * @brief Picks a next-tier server and sends it one call.
+     * @param parent Id of the request in m_parents.
+     * @param parentHeader The request's header, whose L7 identifier and deadline are passed on.
+     * @return False if no server could be picked or connected to.
+     */
+    bool SendDownstreamCall(uint64_t parent, const RequestResponseHeader& parentHeader);
+
+    /**
+     * @brief Accounts for an answered or lost downstream call and answers the request when
+     * its last call is done.
+     * @param parent Id of the request in m_parents (ignored if already answered).
+     * @param ok True if the call was answered successfully.
+     */
+    void CompleteDownstreamCall(uint64_t parent, bool ok);
+
+    /**
+     * @brief Gets the connection to a next-tier server, connecting if there is none.
+     * @param backend The next-tier server.
+     * @return The connection's socket, or null if a new connection could not be opened.
+     */
+    Ptr<Socket> GetDownstreamSocket(const InetSocketAddress& backend);
+
+    /**
+     * @brief Callback invoked when data arrives from a next-tier server.
+     * @param socket The downstream socket.
+     */
+    void HandleDownstreamRead(Ptr<Socket> socket);
+
+    /**
+     * @brief Callback invoked when a downstream socket has free send-buffer space.
+     * @param socket The downstream socket.
+     * @param availableBytes The free space in the socket's send buffer.
+     */
+    void HandleDownstreamSend(Ptr<Socket> socket, uint32_t availableBytes);
+
+    /**
+     * @brief Callback invoked when a downstream connection fails, closes or errors:
+     * its outstanding calls are reported to the picker as failures.
+     * @param socket The downstream socket.
+     */
+    void HandleDownstreamLoss(Ptr<Socket> socket);
+
+    /**
+     * @brief Closes every downstream connection and forgets the requests waiting on the next tier.
+     * @return The number of requests that were waiting.
+     */
+    uint64_t CloseDownstream();
+
+    /**
+     * @brief Gets the work clock: simulation time minus the time spent paused.
+     * Stands still during a pause.
+     * @return The current work clock reading.
+     */
+    Time GetWorkClock();
+
+    /**
+     * @brief Puts a request into processor-sharing service.
+     * @param connection The connection the request came from.
+     * @param header The request's header.
+     * @param serviceTime How long serving the request takes on a dedicated core.
+     */
+    void StartSharedService(ConnectionHandle connection, RequestResponseHeader header, Time serviceTime);
+
+    /**
+     * @brief Finishes the processor-sharing requests whose work is done and schedules the next completion.
+     */
+    void CompleteSharedService();
+
+    /**
+     * @brief Adds the service each processor-sharing request has received since the last update.
+     * Must be called before the number of requests in service changes.
+     */
+    void AdvanceSharedService();
+
+    /**
+     * @brief (Re)schedules the single completion event for the processor-sharing request that finishes first.
+     */
+    void ScheduleSharedCompletion();
+
+    /**
+     * @brief Gets the number of requests using a worker (or core) right now.
+     * @return The requests in service, at most Workers when the workers are limited.
+     */
+    uint32_t GetBusyNow() const;
+
+    /**
+     * @brief Gets the number of requests waiting for a worker (or, under processor sharing,
+     * sharing the cores beyond one request per core) right now.
+     * @return The waiting requests.
+     */
+    uint32_t GetWaitingNow() const;
+
+    /**
+     * @brief Adds the queue length and busy workers since the last change to the time averages.
+     * Must be called before either changes.
+     */
+    void AccumulateLoad();
 
     /**
      * @brief Sends a response packet back to the client.
-     * The response contains the echoed header with a zero-sized payload.
-     * @param socket The client socket to send the response to.
+     * The response contains the echoed header and a payload of the requested response size.
+     * @param connection The connection to send the response on.
      * @param header The header to include in the response (typically echoed from the request).
      */
-    void SendResponse(Ptr<Socket> socket, RequestResponseHeader header);
+    void SendResponse(ConnectionHandle connection, RequestResponseHeader header);
+
+    /**
+     * @brief Checks whether a request's deadline has passed.
+     * @param header The request's header.
+     * @return True if the request has a deadline and it is not later than now.
+     */
+    bool IsExpired(const RequestResponseHeader& header) const;
+
+    /**
+     * @brief Answers an expired request with STATUS_DEADLINE_EXCEEDED and no payload.
+     * @param connection The connection the request arrived on.
+     * @param header The request's header.
+     */
+    void FailExpiredRequest(ConnectionHandle connection, RequestResponseHeader header);
 
     // Member Variables
     uint16_t m_port;                     //!< Port number on which the server listens.
     Ptr<Socket> m_listeningSocket;       //!< The main listening socket for incoming connections.
-    std::list<Ptr<Socket>> m_socketList; //!< List of currently active client connection sockets.
+    std::vector<Connection> m_connections;   //!< Connection slab, indexed by ConnectionHandle::slot.
+    std::vector<uint32_t> m_freeConnections; //!< Released slots, reused before the slab grows.
+    std::unordered_map<const Socket*, uint32_t> m_connectionSlots; //!< Slot of each live socket, for socket callbacks.
 
     Time m_processingDelay;              //!< Configurable delay to simulate server processing time.
+    Ptr<ServiceTimeDistribution> m_serviceTime; //!< Per-request service times; overrides m_processingDelay when set.
+    std::vector<Ptr<ServiceTimeDistribution>> m_scheduledServiceTimes; //!< Distributions switched to later.
 
-    // Per-client receive buffer to handle TCP stream reassembly.
-    std::map<Ptr<Socket>, std::string> m_rxBuffers;
+    double m_slowdown;                   //!< Slowdown factor, or the target of the current ramp (attribute).
+    double m_rampFrom = 1.0;             //!< Slowdown factor at the start of the ramp.
+    Time m_rampStart;                    //!< Start of the ramp.
+    Time m_rampEnd;                      //!< End of the ramp (0 when not ramping).
+
+    Time m_pauseStart;                   //!< Start of the current pause.
+    Time m_pausedUntil;                  //!< End of the current pause (0 when not paused).
+    Time m_pausedTotal;                  //!< Length of the pauses that have ended.
+    uint32_t m_pauses = 0;               //!< Pauses so far.
+
+    bool m_running = false;              //!< True between StartApplication() and StopApplication().
+    uint32_t m_incarnation = 0;          //!< Crashes so far; completions of earlier incarnations are void.
+    Time m_hungUntil;                    //!< End of the current hang (Time::Max() = for good).
+    uint64_t m_requestsLost = 0;         //!< Requests lost to crashes and hangs.
+    bool m_honorServiceTimeHint;         //!< If true, a non-zero request service-time hint overrides m_processingDelay.
 
     uint64_t m_requestsReceived = 0;     //!< Counter for the total number of requests processed.
+
+    /**
+     * @brief A request waiting for a worker.
+     */
+    struct QueuedRequest
+    {
+        ConnectionHandle connection;     //!< Connection the request came from.
+        RequestResponseHeader header;    //!< The request's header.
+        Time serviceTime;                //!< How long serving the request takes.
+        Time arrival;                    //!< When the request was queued.
+    };
+
+    uint32_t m_workers;                  //!< Requests served concurrently (0 = unlimited) (attribute).
+    uint32_t m_maxQueueLength;           //!< Waiting requests beyond which arrivals are rejected (0 = unbounded) (attribute).
+    QueueDiscipline m_discipline;        //!< Order of service for waiting requests (attribute).
+    ServiceModel m_serviceModel;         //!< Worker pool or processor sharing (attribute).
+    AdmissionPolicy m_admissionPolicy;   //!< When requests are rejected (attribute).
+    uint32_t m_admissionQueueLength;     //!< Waiting requests at which QueueLength admission rejects (attribute).
+    Time m_admissionLatencyTarget;       //!< Predicted latency above which LatencyTarget admission rejects (attribute).
+    CachePolicy m_cachePolicy;           //!< Eviction policy of the cache model (attribute).
+    uint32_t m_cacheCapacity;            //!< Keys the cache holds (attribute).
+    Time m_cacheHitServiceTime;          //!< Service time of a request whose key is cached (attribute).
+    std::unique_ptr<RequestCache> m_cache; //!< The cache model, null with CACHE_NONE.
+
+    /**
+     * @brief A connection to a next-tier server.
+     */
+    struct DownstreamConnection
+    {
+        Ptr<Socket> socket;              //!< The socket (connecting or connected).
+        std::string rxBuffer;            //!< Received bytes not yet parsed into responses.
+        SocketTxQueue txQueue;           //!< Call bytes waiting for send-buffer space.
+    };
+
+    /**
+     * @brief A call in flight to the next tier.
+     */
+    struct DownstreamCall
+    {
+        uint64_t parent;                 //!< Id of the request that made the call.
+        InetSocketAddress backend;       //!< The next-tier server called.
+        Ptr<Socket> socket;              //!< The connection the call went out on.
+        Time sendTime;                   //!< When the call was sent.
+    };
+
+    /**
+     * @brief A request waiting on its downstream calls.
+     */
+    struct ParentRequest
+    {
+        ConnectionHandle connection;     //!< Connection the request came from.
+        RequestResponseHeader header;    //!< The request's header.
+        uint32_t callsLeft;              //!< Calls not sent yet.
+        uint32_t outstanding;            //!< Calls sent and not answered yet.
+    };
+
+    Ptr<LoadBalancerApp> m_downstream;   //!< Picker over the next tier, null for a leaf server (attribute).
+    uint32_t m_downstreamCallsPerRequest; //!< Calls to the next tier per request (attribute).
+    DownstreamMode m_downstreamMode;     //!< Sequential or parallel calls (attribute).
+    uint32_t m_downstreamRequestSize;    //!< Payload bytes of a downstream call (attribute).
+    uint32_t m_downstreamResponseSize;   //!< Response payload bytes a downstream call asks for (attribute).
+    std::map<InetSocketAddress, DownstreamConnection> m_downstreamConnections; //!< One connection per next-tier server.
+    std::unordered_map<uint32_t, DownstreamCall> m_downstreamInFlight; //!< Calls in flight by sequence number.
+    std::unordered_map<uint64_t, ParentRequest> m_parents; //!< Requests waiting on the next tier by id.
+    uint64_t m_nextParent = 0;           //!< Id of the next request to wait on the next tier.
+    uint32_t m_downstreamSeq = 0;        //!< Sequence number of the last downstream call.
+    uint64_t m_downstreamCallsSent = 0;  //!< Calls sent to the next tier.
+    uint64_t m_downstreamFailures = 0;   //!< Requests failed by a rejected or lost call.
+
+    // Waiting requests, served in key order. The key encodes the discipline: the arrival
+    // number (FIFO), its negation (LIFO), or the service time (shortest first; the multimap
+    // keeps equal keys in arrival order).
+    std::multimap<int64_t, QueuedRequest> m_queue;
+    uint64_t m_arrivals = 0;             //!< Requests queued so far (arrival numbers).
+    uint32_t m_busyWorkers = 0;          //!< Requests currently in service.
+    uint32_t m_peakQueueLength = 0;      //!< Longest queue seen.
+    uint64_t m_queueFullRejections = 0;  //!< Requests rejected because the queue was full.
+    uint64_t m_requestsRejected = 0;     //!< Requests rejected by the admission policy.
+    uint64_t m_deadlineMisses = 0;       //!< Requests answered with STATUS_DEADLINE_EXCEEDED.
+    Time m_queuedWork;                   //!< Sum of the service times of the waiting requests.
+    uint64_t m_requestsStarted = 0;      //!< Requests taken into service.
+    Time m_queueingDelayTotal;           //!< Sum of the queue waits of the requests taken into service.
+    Time m_loadStart;                    //!< Start of the time averages.
+    Time m_lastLoadUpdate;               //!< Time of the last AccumulateLoad().
+    Time m_loadEnd;                      //!< End of the time averages (0 while running).
+    double m_queueLengthArea = 0.0;      //!< Integral of the queue length over time (request-seconds).
+    double m_busyWorkersArea = 0.0;      //!< Integral of the busy workers over time (request-seconds).
+
+    /**
+     * @brief A request in processor-sharing service.
+     */
+    struct SharedRequest
+    {
+        ConnectionHandle connection;     //!< Connection the request came from.
+        RequestResponseHeader header;    //!< The request's header.
+    };
+
+    // Processor-sharing requests keyed by the attained service (seconds of a dedicated core)
+    // at which they finish. Every request in service attains service at the same rate, so a
+    // single running total orders them all: an arrival or departure only changes the rate,
+    // never the order, and only the first request needs a scheduled event.
+    std::multimap<double, SharedRequest> m_sharedRequests;
+    double m_attainedService = 0.0;      //!< Service a request in service since the start would have received (seconds).
+    Time m_sharedLastUpdate;             //!< Work clock reading of the last AdvanceSharedService().
+    EventId m_sharedCompletion;          //!< Completion event of the first request to finish.
 };
 
 } // namespace ns3
@@ -0,0 +1,127 @@
+#include "latency_time_series.h"
+
+#include "ns3/log.h"
+
+#include <algorithm> // For std::max
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("LatencyTimeSeries");
+
+LatencyTimeSeries::LatencyTimeSeries(Time windowLength, Time highestTrackable, uint32_t significantDigits)
+    : m_windowLength(windowLength),
+      m_highestTrackable(highestTrackable),
+      m_significantDigits(significantDigits)
+{
+    if (!windowLength.IsStrictlyPositive()) {
+        NS_FATAL_ERROR("LatencyTimeSeries window length must be positive, got " << windowLength);
+    }
+}
+
+LatencyTimeSeries::Window&
+LatencyTimeSeries::WindowAt(size_t index)
+{
+    if (index >= m_windows.size()) {
+        m_windows.resize(index + 1);
+    }
+    if (!m_windows[index]) {
+        m_windows[index] = std::make_unique<Window>(Window{LatencyHistogram(m_highestTrackable, m_significantDigits)});
+    }
+    return *m_windows[index];
+}
+
+void
+LatencyTimeSeries::Record(Time at, Time latency, uint64_t bytes)
+{
+    const int64_t index = std::max<int64_t>(at.GetNanoSeconds(), 0) / m_windowLength.GetNanoSeconds();
+    Window& window = WindowAt(static_cast<size_t>(index));
+    window.latencies.Record(latency);
+    window.bytes += bytes;
+}
+
+void
+LatencyTimeSeries::Merge(const LatencyTimeSeries& other)
+{
+    if (other.m_windowLength != m_windowLength) {
+        NS_FATAL_ERROR("Cannot merge time series with windows of " << other.m_windowLength
+                       << " into windows of " << m_windowLength);
+    }
+    for (size_t i = 0; i < other.m_windows.size(); ++i) {
+        if (other.m_windows[i]) {
+            Window& window = WindowAt(i);
+            window.latencies.Merge(other.m_windows[i]->latencies);
+            window.bytes += other.m_windows[i]->bytes;
+        }
+    }
+}
+
+void
+LatencyTimeSeries::Reset()
+{
+    m_windows.clear();
+}
+
+Time
+LatencyTimeSeries::GetWindowLength() const
+{
+    return m_windowLength;
+}
+
+size_t
+LatencyTimeSeries::GetWindowCount() const
+{
+    return m_windows.size();
+}
+
+Time
+LatencyTimeSeries::GetWindowStart(size_t index) const
+{
+    return NanoSeconds(m_windowLength.GetNanoSeconds() * static_cast<int64_t>(index));
+}
+
+const LatencyHistogram*
+LatencyTimeSeries::GetLatencies(size_t index) const
+{
+    return m_windows[index] ? &m_windows[index]->latencies : nullptr;
+}
+
+uint64_t
+LatencyTimeSeries::GetBytes(size_t index) const
+{
+    return m_windows[index] ? m_windows[index]->bytes : 0;
+}
+
+bool
+LatencyTimeSeries::GetConvergenceTime(Time after, double quantile, double tolerance, Time& convergence) const
+{
+    const size_t first = static_cast<size_t>(std::max<int64_t>(after.GetNanoSeconds(), 0) / m_windowLength.GetNanoSeconds());
+    if (first >= m_windows.size()) {
+        return false;
+    }
+
+    // Steady state: all responses in the last quarter of the windows after the transient.
+    const size_t tailStart = first + (m_windows.size() - first) * 3 / 4;
+    LatencyHistogram steady(m_highestTrackable, m_significantDigits);
+    for (size_t i = tailStart; i < m_windows.size(); ++i) {
+        if (m_windows[i]) {
+            steady.Merge(m_windows[i]->latencies);
+        }
+    }
+    if (steady.GetCount() == 0) {
+        return false;
+    }
+    const double limitNs = static_cast<double>(steady.GetPercentile(quantile).GetNanoSeconds()) * (1.0 + tolerance);
+
+    Time settled = after;
+    for (size_t i = first; i < m_windows.size(); ++i) {
+        if (m_windows[i] && static_cast<double>(m_windows[i]->latencies.GetPercentile(quantile).GetNanoSeconds()) > limitNs) {
+            settled = GetWindowStart(i + 1);
+        }
+    }
+    convergence = std::max(settled - after, Time(0));
+    NS_LOG_DEBUG("Converged " << convergence << " after " << after << " (P" << quantile * 100 << " limit "
+                 << limitNs / 1e6 << " ms)");
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,138 @@
+#ifndef LATENCY_TIME_SERIES_H
+#define LATENCY_TIME_SERIES_H
+
+// NS-3 Includes
+#include "ns3/nstime.h" // For ns3::Time
+
+// Standard Library Includes
+#include <cstddef> // For size_t
+#include <cstdint> // For uint32_t, uint64_t
+#include <memory>  // For std::unique_ptr
+#include <vector>
+
+// Project-Specific Includes
+#include "latency_histogram.h" // Per-window latency distribution
+
+namespace ns3 {
+
+/**
+ * @brief Latency and throughput over time, in fixed windows of simulation time.
+ *
+ * Window @c i covers [i * WindowLength, (i + 1) * WindowLength) of absolute simulation
+ * time, so series recorded by different clients line up and merge window by window.
+ * Each window holds its own LatencyHistogram plus response and byte counts; samples
+ * are added as responses arrive, so nothing is kept per response. A window's histogram
+ * is only allocated once it receives a sample, and a low default precision keeps the
+ * per-window footprint small.
+ */
+class LatencyTimeSeries
+{
+  public:
+    /**
+     * @brief Creates an empty series.
+     * @param windowLength Width of each window (must be positive).
+     * @param highestTrackable Largest latency tracked precisely by the window histograms.
+     * @param significantDigits Decimal digits of precision of the window histograms (1 to 5).
+     */
+    explicit LatencyTimeSeries(Time windowLength = MilliSeconds(100),
+                               Time highestTrackable = Seconds(60),
+                               uint32_t significantDigits = 2);
+
+    LatencyTimeSeries(LatencyTimeSeries&&) = default;
+    LatencyTimeSeries& operator=(LatencyTimeSeries&&) = default;
+
+    /**
+     * @brief Records one response.
+     * @param at Simulation time the response arrived (selects the window).
+     * @param latency The response's latency.
+     * @param bytes The response's size in bytes.
+     */
+    void Record(Time at, Time latency, uint64_t bytes);
+
+    /**
+     * @brief Adds all windows of another series to this one.
+     * Aborts the simulation if the window lengths differ.
+     * @param other The series to merge in.
+     */
+    void Merge(const LatencyTimeSeries& other);
+
+    /**
+     * @brief Removes all samples, keeping the configuration.
+     */
+    void Reset();
+
+    /**
+     * @brief Gets the width of each window.
+     * @return The window length.
+     */
+    Time GetWindowLength() const;
+
+    /**
+     * @brief Gets the number of windows up to and including the last one with data.
+     * @return The window count.
+     */
+    size_t GetWindowCount() const;
+
+    /**
+     * @brief Gets the start time of a window.
+     * @param index The window index.
+     * @return The window's start in simulation time.
+     */
+    Time GetWindowStart(size_t index) const;
+
+    /**
+     * @brief Gets the latency histogram of a window.
+     * @param index The window index (< GetWindowCount()).
+     * @return The histogram, or nullptr if the window received no responses.
+     */
+    const LatencyHistogram* GetLatencies(size_t index) const;
+
+    /**
+     * @brief Gets the response bytes received in a window.
+     * @param index The window index (< GetWindowCount()).
+     * @return The byte count.
+     */
+    uint64_t GetBytes(size_t index) const;
+
+    /**
+     * @brief Measures how long a latency quantile takes to settle after a point in time.
+     *
+     * The steady-state level is the quantile over the last quarter of the windows after
+     * @p after. The series has converged from the end of the last window whose quantile
+     * exceeds that level by more than @p tolerance (relative); windows without responses
+     * are skipped.
+     *
+     * @param after Start of the transient (e.g., simulation start or a backend slowdown).
+     * @param quantile The latency quantile tracked (e.g., 0.9).
+     * @param tolerance Allowed relative excess over the steady-state level (e.g., 0.2).
+     * @param[out] convergence Time from @p after until the series settled.
+     * @return False if there are no responses after @p after, true otherwise.
+     */
+    bool GetConvergenceTime(Time after, double quantile, double tolerance, Time& convergence) const;
+
+  private:
+    /**
+     * @brief Responses of one window.
+     */
+    struct Window
+    {
+        LatencyHistogram latencies; //!< Latency distribution of the window's responses.
+        uint64_t bytes = 0;         //!< Response bytes received in the window.
+    };
+
+    /**
+     * @brief Returns the window with the given index, allocating it (and growing the series) if needed.
+     * @param index The window index.
+     * @return The window.
+     */
+    Window& WindowAt(size_t index);
+
+    Time m_windowLength;                          //!< Width of each window.
+    Time m_highestTrackable;                      //!< Range of the window histograms.
+    uint32_t m_significantDigits;                 //!< Precision of the window histograms.
+    std::vector<std::unique_ptr<Window>> m_windows; //!< Windows by index (nullptr until first sample).
+};
+
+} // namespace ns3
+
+#endif // LATENCY_TIME_SERIES_H
@@ -35,7 +35,6 @@ TypeId LeastRequestLoadBalancer::GetTypeId()
 
 LeastRequestLoadBalancer::LeastRequestLoadBalancer()
     : m_weightsAreEqual(true), // Assume equal until backends are set
-      m_randomGenerator(CreateObject<UniformRandomVariable>()),
       m_activeRequestBias(1.0) // Default, will be overridden by attribute if set
 {
     NS_LOG_FUNCTION(this);
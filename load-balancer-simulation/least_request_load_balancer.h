@@ -94,7 +94,6 @@ class LeastRequestLoadBalancer : public LoadBalancerApp
 
     // Member Variables specific to Least Request logic
     bool m_weightsAreEqual;                     //!< True if all backend weights are equal, enabling P2C.
-    Ptr<UniformRandomVariable> m_randomGenerator; //!< Random number generator for P2C and weighted selection.
     double m_activeRequestBias;                 //!< Bias factor for active requests in weighted calculation (attribute).
 };
 
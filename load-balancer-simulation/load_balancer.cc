@@ -11,6 +11,8 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/enum.h"
+#include "ns3/boolean.h"
 #include "ns3/tcp-socket-factory.h"
 #include "request_response_header.h" // Custom L7 header
 
@@ -24,6 +26,7 @@
 #include <cstring>   // For std::strerror
 #include <cerrno>    // For errno values (though ns-3 uses its own Socket::SocketErrno)
 #include <cstdint>
+#include <cmath>     // For std::exp
 
 namespace ns3 {
 
@@ -64,6 +67,9 @@ std::string InetAddressToString(const InetSocketAddress& addr) {
     return oss.str();
 }
 
+// Weight of the newest response time in a backend's latency estimate.
+constexpr double kLatencyEstimateWeight = 0.2;
+
 } // anonymous namespace
 
 
@@ -78,13 +84,52 @@ TypeId LoadBalancerApp::GetTypeId()
                                           "Port on which the load balancer listens for TCP connections.",
                                           UintegerValue(LB_PORT),
                                           MakeUintegerAccessor(&LoadBalancerApp::m_port),
-                                          MakeUintegerChecker<uint16_t>());
+                                          MakeUintegerChecker<uint16_t>())
+                            .AddAttribute("RejectionFeedback",
+                                          "How a response rejected by a backend is reported to the algorithm: as a "
+                                          "failure, or (naively) as the latency of a fast response.",
+                                          EnumValue(LoadBalancerApp::REJECTION_AS_FAILURE),
+                                          MakeEnumAccessor<RejectionFeedback>(&LoadBalancerApp::m_rejectionFeedback),
+                                          MakeEnumChecker(LoadBalancerApp::REJECTION_AS_FAILURE, "Failure",
+                                                          LoadBalancerApp::REJECTION_AS_LATENCY, "Latency"))
+                            .AddAttribute("MaxRetries",
+                                          "Times a request that a backend rejected, or lost to a refused, closed "
+                                          "or reset connection, is sent again to a backend chosen anew before the "
+                                          "client sees the rejection or the request counts as lost.",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(&LoadBalancerApp::m_maxRetries),
+                                          MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("RequestTimeout",
+                                          "Time a backend has to answer a request before it is handled like one "
+                                          "lost to its connection: retried or counted as lost (0 = no timeout).",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&LoadBalancerApp::m_requestTimeout),
+                                          MakeTimeChecker(Seconds(0)))
+                            .AddAttribute("DeadlineAware",
+                                          "Answer a request at once with STATUS_DEADLINE_EXCEEDED when its deadline "
+                                          "has passed or the chosen backend's estimated response time overruns it.",
+                                          BooleanValue(true),
+                                          MakeBooleanAccessor(&LoadBalancerApp::m_deadlineAware),
+                                          MakeBooleanChecker())
+                            .AddAttribute("EstimateDecayTime",
+                                          "Time constant over which a backend's latency estimate decays towards zero "
+                                          "since its last sample. Without it, a backend whose estimate overruns the "
+                                          "deadlines would never be sent a request to measure it again.",
+                                          TimeValue(Seconds(1)),
+                                          MakeTimeAccessor(&LoadBalancerApp::m_estimateDecayTime),
+                                          MakeTimeChecker(MilliSeconds(1)));
     return tid;
 }
 
 LoadBalancerApp::LoadBalancerApp()
     : m_port(LB_PORT),
-      m_listeningSocket(nullptr)
+      m_randomGenerator(CreateObject<UniformRandomVariable>()),
+      m_listeningSocket(nullptr),
+      m_rejectionFeedback(REJECTION_AS_FAILURE),
+      m_maxRetries(0),
+      m_requestTimeout(Seconds(0)),
+      m_deadlineAware(true),
+      m_estimateDecayTime(Seconds(1))
 {
     NS_LOG_FUNCTION(this);
 }
@@ -223,8 +268,11 @@ void LoadBalancerApp::StopApplication()
 
     m_clientRxBuffers.clear();
     m_backendRxBuffers.clear();
+    m_txQueues.clear();
     m_backendClientMap.clear();
-    m_requestSendTimes.clear();
+    m_backendRequests.clear();
+    Simulator::Cancel(m_backendTimeoutEvent);
+    m_backendDeadlines.clear();
 
     NS_LOG_INFO("LB App (L7 TCP) on Node " << GetNode()->GetId() << " stopped.");
 }
@@ -236,9 +284,162 @@ void LoadBalancerApp::DoDispose(void) {
         NS_LOG_DEBUG("DoDispose called while LB App was still active. Calling StopApplication first.");
         StopApplication();
     }
+    m_randomGenerator = nullptr;
     Application::DoDispose();
 }
 
+int64_t LoadBalancerApp::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_randomGenerator->SetStream(stream);
+    return 1;
+}
+
+bool LoadBalancerApp::PickBackend(uint64_t l7Identifier, InetSocketAddress& chosenBackend)
+{
+    NS_LOG_FUNCTION(this << l7Identifier);
+    // None of the algorithms inspect the packet or the client address.
+    return ChooseBackend(nullptr, Address(), l7Identifier, chosenBackend);
+}
+
+void LoadBalancerApp::ReportRequestSent(const InetSocketAddress& backendAddress)
+{
+    CountRouted(backendAddress);
+    NotifyRequestSent(backendAddress);
+}
+
+void LoadBalancerApp::ReportRequestFinished(const InetSocketAddress& backendAddress)
+{
+    NotifyRequestFinished(backendAddress);
+}
+
+void LoadBalancerApp::ReportBackendLatency(const InetSocketAddress& backendAddress, Time rtt)
+{
+    UpdateLatencyEstimate(backendAddress, rtt);
+    RecordBackendLatency(backendAddress, rtt);
+}
+
+void LoadBalancerApp::ReportBackendRejection(const InetSocketAddress& backendAddress, Time rtt)
+{
+    m_rejections++;
+    ApplyRejectionFeedback(backendAddress, rtt);
+}
+
+void LoadBalancerApp::ReportBackendDeadlineMiss(const InetSocketAddress& backendAddress, Time rtt)
+{
+    ApplyRejectionFeedback(backendAddress, rtt);
+}
+
+void LoadBalancerApp::ApplyRejectionFeedback(const InetSocketAddress& backendAddress, Time rtt)
+{
+    if (m_rejectionFeedback == REJECTION_AS_LATENCY) {
+        RecordBackendLatency(backendAddress, rtt);
+    } else {
+        RecordBackendFailure(backendAddress);
+    }
+}
+
+void LoadBalancerApp::ReportBackendFailure(const InetSocketAddress& backendAddress)
+{
+    RecordBackendFailure(backendAddress);
+}
+
+void LoadBalancerApp::RecordBackendFailure(InetSocketAddress backendAddress)
+{
+    NS_LOG_DEBUG("LB (L7): Backend " << backendAddress << " failed a request; no failure feedback in this algorithm.");
+}
+
+uint64_t LoadBalancerApp::GetRejectionCount() const
+{
+    return m_rejections;
+}
+
+uint64_t LoadBalancerApp::GetRetryCount() const
+{
+    return m_retries;
+}
+
+uint64_t LoadBalancerApp::GetLostRequestCount() const
+{
+    return m_lostRequests;
+}
+
+uint64_t LoadBalancerApp::GetTimedOutCount() const
+{
+    return m_timedOutRequests;
+}
+
+uint64_t LoadBalancerApp::GetDeadlineFailCount() const
+{
+    return m_deadlineFailures;
+}
+
+Time LoadBalancerApp::GetLatencyEstimate(const InetSocketAddress& backendAddress) const
+{
+    const BackendInfo* info = FindBackendInfo(backendAddress);
+    if (!info || info->latencyEstimate.IsZero()) {
+        return Time(0);
+    }
+    const double age = (Simulator::Now() - info->latencyEstimateTime).GetSeconds();
+    return NanoSeconds(static_cast<int64_t>(info->latencyEstimate.GetNanoSeconds()
+                                            * std::exp(-age / m_estimateDecayTime.GetSeconds())));
+}
+
+uint64_t LoadBalancerApp::GetRoutedCount(const InetSocketAddress& backendAddress) const
+{
+    auto it = m_routing.find(backendAddress);
+    return (it != m_routing.end()) ? it->second.routed : 0;
+}
+
+Time LoadBalancerApp::GetLastRoutedTime(const InetSocketAddress& backendAddress) const
+{
+    auto it = m_routing.find(backendAddress);
+    return (it != m_routing.end()) ? it->second.lastRouted : Time(0);
+}
+
+void LoadBalancerApp::CountRouted(const InetSocketAddress& backendAddress)
+{
+    RoutingRecord& record = m_routing[backendAddress];
+    record.routed++;
+    record.lastRouted = Simulator::Now();
+}
+
+void LoadBalancerApp::UpdateLatencyEstimate(const InetSocketAddress& backendAddress, Time rtt)
+{
+    BackendInfo* info = FindBackendInfo(backendAddress);
+    if (!info) {
+        return;
+    }
+    const Time current = GetLatencyEstimate(backendAddress);
+    if (current.IsZero()) {
+        info->latencyEstimate = rtt;
+    } else {
+        const double estimateNs = current.GetNanoSeconds() * (1.0 - kLatencyEstimateWeight)
+                                  + rtt.GetNanoSeconds() * kLatencyEstimateWeight;
+        info->latencyEstimate = NanoSeconds(static_cast<int64_t>(estimateNs));
+    }
+    info->latencyEstimateTime = Simulator::Now();
+}
+
+void LoadBalancerApp::HandleFailedRequest(Ptr<Socket> clientSocket, const InetSocketAddress& backendAddress,
+                                          Ptr<Packet> requestPacket, uint32_t attempt)
+{
+    NS_LOG_FUNCTION(this << clientSocket << backendAddress << attempt);
+    RecordBackendFailure(backendAddress);
+    NotifyRequestFinished(backendAddress);
+    if (requestPacket && attempt < m_maxRetries && clientSocket
+        && m_clientBackendSockets.find(clientSocket) != m_clientBackendSockets.end()) {
+        m_retries++;
+        Address clientAddress;
+        clientSocket->GetPeerName(clientAddress);
+        // Retry once the failed connection's state has been cleaned up.
+        Simulator::ScheduleNow(&LoadBalancerApp::AttemptForwardRequest, this, clientSocket, requestPacket,
+                               clientAddress, attempt + 1);
+        return;
+    }
+    m_lostRequests++;
+}
+
 void LoadBalancerApp::HandleAccept(Ptr<Socket> acceptedSocket, const Address& from)
 {
     NS_LOG_FUNCTION(this << acceptedSocket << from);
@@ -288,9 +489,12 @@ void LoadBalancerApp::HandleClientRead(Ptr<Socket> clientSocket)
 
     NS_LOG_DEBUG("LB (L7): Client " << clientSocket << " buffer size after recv loop: " << currentRxBuffer.size());
 
-    uint32_t headerSize = RequestResponseHeader().GetSerializedSize();
-    while (currentRxBuffer.size() >= headerSize)
+    while (currentRxBuffer.size() >= RequestResponseHeader::PREFIX_SIZE)
     {
+        const uint32_t headerSize = RequestResponseHeader::PeekSerializedSize(reinterpret_cast<const uint8_t*>(currentRxBuffer.data()));
+        if (currentRxBuffer.size() < headerSize) {
+            break; // Header extensions still incomplete.
+        }
         Ptr<Packet> tempPacket = Create<Packet>(reinterpret_cast<const uint8_t*>(currentRxBuffer.data()), headerSize);
         RequestResponseHeader reqHeader;
         if (tempPacket->PeekHeader(reqHeader) != headerSize) {
@@ -333,8 +537,9 @@ void LoadBalancerApp::HandleClientRead(Ptr<Socket> clientSocket)
     }
 }
 
-void LoadBalancerApp::AttemptForwardRequest(Ptr<Socket> clientSocket, Ptr<Packet> requestPacket, const Address& clientAddress) {
-    NS_LOG_FUNCTION(this << clientSocket << requestPacket << clientAddress);
+void LoadBalancerApp::AttemptForwardRequest(Ptr<Socket> clientSocket, Ptr<Packet> requestPacket, const Address& clientAddress,
+                                            uint32_t attempt) {
+    NS_LOG_FUNCTION(this << clientSocket << requestPacket << clientAddress << attempt);
 
     InetSocketAddress chosenBackendAddress(Ipv4Address::GetAny(), 0);
     RequestResponseHeader traceHeader;
@@ -354,8 +559,28 @@ void LoadBalancerApp::AttemptForwardRequest(Ptr<Socket> clientSocket, Ptr<Packet
                       << " from " << clientAddrStr << " (L7Id=" << l7Identifier << "). Dropping request.");
         return;
     }
+
+    // Reading the deadline decodes the extensions, which a plain proxy never needs to do.
+    const Time deadline = m_deadlineAware ? traceHeader.GetDeadline() : Time(0);
+    const Time estimate = GetLatencyEstimate(chosenBackendAddress);
+    if (!deadline.IsZero() && Simulator::Now() + estimate >= deadline) {
+        // Forwarding would only spend backend capacity on a request that is already lost.
+        m_deadlineFailures++;
+        NS_LOG_INFO("LB (L7): Request Seq=" << currentSeq << " cannot meet its deadline on Backend "
+                      << chosenBackendAddress << " (" << (deadline - Simulator::Now()).As(Time::MS)
+                      << " left, estimate " << estimate.As(Time::MS) << "). Failing it.");
+        RequestResponseHeader failHeader = traceHeader;
+        failHeader.SetStatus(RequestResponseHeader::STATUS_DEADLINE_EXCEEDED);
+        failHeader.SetPayloadSize(0);
+        failHeader.SetResponseSize(0);
+        Ptr<Packet> failPacket = Create<Packet>(0);
+        failPacket->AddHeader(failHeader);
+        SendToClient(clientSocket, failPacket);
+        return;
+    }
     NS_LOG_INFO("LB (L7): Request Seq=" << currentSeq << " from " << clientAddrStr << " (L7Id=" << l7Identifier << ")"
                   << " assigned to Backend " << chosenBackendAddress);
+    CountRouted(chosenBackendAddress);
 
     auto client_backends_it = m_clientBackendSockets.find(clientSocket);
     if (client_backends_it == m_clientBackendSockets.end()) {
@@ -389,8 +614,7 @@ void LoadBalancerApp::AttemptForwardRequest(Ptr<Socket> clientSocket, Ptr<Packet
                      << " for request Seq=" << currentSeq << " to " << chosenBackendAddress);
 
         NotifyRequestSent(chosenBackendAddress); 
-        m_requestSendTimes[{backendSocketToUse, currentSeq}] = Simulator::Now();
-        SendToBackend(backendSocketToUse, requestPacket);
+        SendToBackend(backendSocketToUse, TrackBackendRequest(backendSocketToUse, requestPacket, attempt));
     }
     else
     {
@@ -408,7 +632,7 @@ void LoadBalancerApp::AttemptForwardRequest(Ptr<Socket> clientSocket, Ptr<Packet
 
         auto emplaceResult = m_pendingBackendRequests.emplace(
             newBackendSocket,
-            PendingRequest{clientSocket, requestPacket->Copy(), clientAddress, chosenBackendAddress}
+            PendingRequest{clientSocket, requestPacket->Copy(), clientAddress, chosenBackendAddress, attempt}
         );
 
         if (!emplaceResult.second) { 
@@ -470,12 +694,68 @@ void LoadBalancerApp::HandleBackendConnectSuccess(Ptr<Socket> backendSocket)
     backendSocket->SetRecvCallback(MakeCallback(&LoadBalancerApp::HandleBackendRead, this));
     backendSocket->SetSendCallback(MakeCallback(&LoadBalancerApp::HandleSend, this));
 
+    SendToBackend(backendSocket, TrackBackendRequest(backendSocket, requestPacket, pendingInfo.attempt));
+}
+
+Ptr<Packet> LoadBalancerApp::TrackBackendRequest(Ptr<Socket> backendSocket, Ptr<Packet> requestPacket, uint32_t attempt)
+{
+    // Keep a copy only while the request may still be retried.
+    Ptr<Packet> retryCopy = (attempt < m_maxRetries) ? requestPacket->Copy() : nullptr;
+    Ptr<Packet> wirePacket = requestPacket->Copy();
     RequestResponseHeader reqHeader;
-    requestPacket->PeekHeader(reqHeader);
-    uint32_t currentSeq = reqHeader.GetSeq();
-    m_requestSendTimes[{backendSocket, currentSeq}] = Simulator::Now(); 
+    wirePacket->RemoveHeader(reqHeader);
+    const uint32_t clientSeq = reqHeader.GetSeq();
+    const RequestKey key{backendSocket, ++m_backendSeq};
+    reqHeader.SetSeq(key.second);
+    wirePacket->AddHeader(reqHeader);
+    m_backendRequests[key] = BackendRequest{Simulator::Now(), retryCopy, attempt, clientSeq};
+    if (m_requestTimeout.IsStrictlyPositive()) {
+        m_backendDeadlines.push_back(BackendDeadline{Simulator::Now() + m_requestTimeout, key});
+        if (!m_backendTimeoutEvent.IsPending()) {
+            m_backendTimeoutEvent = Simulator::Schedule(m_requestTimeout, &LoadBalancerApp::ExpireBackendRequests, this);
+        }
+    }
+    return wirePacket;
+}
 
-    SendToBackend(backendSocket, requestPacket);
+void LoadBalancerApp::ExpireBackendRequests()
+{
+    NS_LOG_FUNCTION(this);
+    const Time now = Simulator::Now();
+    while (!m_backendDeadlines.empty() && m_backendDeadlines.front().deadline <= now)
+    {
+        const BackendDeadline entry = m_backendDeadlines.front();
+        m_backendDeadlines.pop_front();
+        auto it = m_backendRequests.find(entry.key);
+        if (it == m_backendRequests.end()) {
+            continue; // Answered, or failed with its connection, in time.
+        }
+        Ptr<Socket> backendSocket = entry.key.first;
+        auto client_it = m_backendClientMap.find(backendSocket);
+        Ptr<Socket> clientSocket = (client_it != m_backendClientMap.end()) ? client_it->second : nullptr;
+        InetSocketAddress backendAddress(Ipv4Address::GetAny(), 0);
+        Address peerAddr;
+        if (backendSocket->GetPeerName(peerAddr) == 0 && InetSocketAddress::IsMatchingType(peerAddr)) {
+            backendAddress = InetSocketAddress::ConvertFrom(peerAddr);
+        } else if (auto backends_it = m_clientBackendSockets.find(clientSocket);
+                   backends_it != m_clientBackendSockets.end()) {
+            for (const auto& [addr, sock] : backends_it->second) {
+                if (sock == backendSocket) {
+                    backendAddress = addr;
+                }
+            }
+        }
+        NS_LOG_INFO("LB (L7): Backend " << backendAddress << " did not answer Seq=" << it->second.clientSeq
+                      << " within " << m_requestTimeout.As(Time::MS) << "; failing it.");
+        const BackendRequest request = it->second;
+        m_backendRequests.erase(it);
+        m_timedOutRequests++;
+        HandleFailedRequest(clientSocket, backendAddress, request.requestPacket, request.attempt);
+    }
+    if (!m_backendDeadlines.empty()) {
+        m_backendTimeoutEvent = Simulator::Schedule(m_backendDeadlines.front().deadline - now,
+                                                    &LoadBalancerApp::ExpireBackendRequests, this);
+    }
 }
 
 
@@ -499,10 +779,11 @@ void LoadBalancerApp::HandleBackendConnectFail(Ptr<Socket> backendSocket)
         pending_it->second.requestPacket->PeekHeader(reqHeader);
         NS_LOG_WARN("LB (L7): Failed to connect to backend " << targetBackendAddress
                       << " (socket " << backendSocketIdStr << "). Errno: " << error
-                      << " (" << std::strerror(error) << "). Dropping request Seq=" << reqHeader.GetSeq());
+                      << " (" << std::strerror(error) << "). Failing request Seq=" << reqHeader.GetSeq());
 
-        NotifyRequestFinished(targetBackendAddress); 
+        PendingRequest pendingInfo = pending_it->second;
         m_pendingBackendRequests.erase(pending_it);
+        HandleFailedRequest(pendingInfo.clientSocket, targetBackendAddress, pendingInfo.requestPacket, pendingInfo.attempt);
     } else {
         Address peerAddrAttempt;
         if (backendSocket->GetPeerName(peerAddrAttempt) == 0 && InetSocketAddress::IsMatchingType(peerAddrAttempt)) {
@@ -569,9 +850,15 @@ void LoadBalancerApp::HandleBackendRead(Ptr<Socket> backendSocket)
     }
     NS_LOG_DEBUG("LB (L7): Backend " << backendSocket << " (" << backendAddrStr << ") buffer size after recv loop: " << currentRxBuffer.size());
 
-    uint32_t headerSize = RequestResponseHeader().GetSerializedSize();
-    while (currentRxBuffer.size() >= headerSize)
+    // Rejected requests to send again, once the buffer has been parsed.
+    std::vector<std::pair<Ptr<Packet>, uint32_t>> retries;
+
+    while (currentRxBuffer.size() >= RequestResponseHeader::PREFIX_SIZE)
     {
+        const uint32_t headerSize = RequestResponseHeader::PeekSerializedSize(reinterpret_cast<const uint8_t*>(currentRxBuffer.data()));
+        if (currentRxBuffer.size() < headerSize) {
+            break; // Header extensions still incomplete.
+        }
         Ptr<Packet> tempPacket = Create<Packet>(reinterpret_cast<const uint8_t*>(currentRxBuffer.data()), headerSize);
         RequestResponseHeader respHeader;
         if (tempPacket->PeekHeader(respHeader) != headerSize) {
@@ -592,22 +879,50 @@ void LoadBalancerApp::HandleBackendRead(Ptr<Socket> backendSocket)
             currentRxBuffer.erase(0, expectedTotalSize);
             NS_LOG_DEBUG("LB (L7): Consumed " << expectedTotalSize << " bytes from backend buffer. Remaining: " << currentRxBuffer.size());
 
-            uint32_t currentSeq = respHeader.GetSeq();
-            auto sendTimeIt = m_requestSendTimes.find({backendSocket, currentSeq});
+            const bool rejected = (respHeader.GetStatus() == RequestResponseHeader::STATUS_REJECTED);
+            const bool expired = (respHeader.GetStatus() == RequestResponseHeader::STATUS_DEADLINE_EXCEEDED);
+            Ptr<Packet> retryPacket = nullptr;
+            uint32_t attempt = 0;
+            auto sendTimeIt = m_backendRequests.find({backendSocket, respHeader.GetSeq()});
+            if (sendTimeIt == m_backendRequests.end()) {
+                // Already failed by RequestTimeout (and possibly retried): the client must not see it.
+                NS_LOG_INFO("LB (L7): Discarding response to backend Seq=" << respHeader.GetSeq() << " from "
+                              << backendAddrStr << " (socket " << backendSocket
+                              << "), which no longer has an outstanding request");
+                continue;
+            }
+
+            // Hand the response back under the client's own sequence number.
+            const uint32_t currentSeq = sendTimeIt->second.clientSeq;
+            packetToForwardToClient->RemoveHeader(respHeader);
+            respHeader.SetSeq(currentSeq);
+            packetToForwardToClient->AddHeader(respHeader);
 
-            if (backendAddrResolved && sendTimeIt != m_requestSendTimes.end()) {
-                Time sendTime = sendTimeIt->second;
+            if (backendAddrResolved) {
+                Time sendTime = sendTimeIt->second.sendTime;
                 Time rtt = Simulator::Now() - sendTime;
-                NS_LOG_DEBUG("LB (L7): Calculated RTT for Seq=" << currentSeq << " on backend " << backendInetAddr << " is " << rtt);
-                RecordBackendLatency(backendInetAddr, rtt);
-                m_requestSendTimes.erase(sendTimeIt);
-            } else if (!backendAddrResolved) {
+                if (rejected) {
+                    NS_LOG_INFO("LB (L7): Backend " << backendInetAddr << " rejected Seq=" << currentSeq
+                                  << " after " << rtt << " (attempt " << sendTimeIt->second.attempt << ")");
+                    ReportBackendRejection(backendInetAddr, rtt);
+                    retryPacket = sendTimeIt->second.requestPacket;
+                    attempt = sendTimeIt->second.attempt;
+                } else if (expired) {
+                    // Too late to retry. The request may have reached the backend already expired,
+                    // so it is fed back like a rejection, not as a failure of the backend.
+                    NS_LOG_INFO("LB (L7): Backend " << backendInetAddr << " missed the deadline of Seq=" << currentSeq
+                                  << " after " << rtt);
+                    ApplyRejectionFeedback(backendInetAddr, rtt);
+                } else {
+                    NS_LOG_DEBUG("LB (L7): Calculated RTT for Seq=" << currentSeq << " on backend " << backendInetAddr << " is " << rtt);
+                    UpdateLatencyEstimate(backendInetAddr, rtt);
+                    RecordBackendLatency(backendInetAddr, rtt);
+                }
+            } else {
                 NS_LOG_WARN("LB (L7): Cannot record latency for Seq=" << currentSeq
                               << ", backend address unknown for socket " << backendSocket);
-            } else {
-                NS_LOG_WARN("LB (L7): Could not find send time for response Seq=" << currentSeq
-                              << " from backend " << backendInetAddr << " (socket " << backendSocket << ")");
             }
+            m_backendRequests.erase(sendTimeIt);
 
             if(backendAddrResolved) {
                 NotifyRequestFinished(backendInetAddr);
@@ -616,7 +931,11 @@ void LoadBalancerApp::HandleBackendRead(Ptr<Socket> backendSocket)
                                << ", backend address unknown for socket " << backendSocket);
             }
 
-            SendToClient(clientSocket, packetToForwardToClient);
+            if (retryPacket) {
+                retries.emplace_back(retryPacket, attempt + 1);
+            } else {
+                SendToClient(clientSocket, packetToForwardToClient);
+            }
         }
         else
         {
@@ -626,6 +945,16 @@ void LoadBalancerApp::HandleBackendRead(Ptr<Socket> backendSocket)
         }
     }
 
+    if (!retries.empty()) {
+        Address clientAddress;
+        clientSocket->GetPeerName(clientAddress);
+        for (auto& [retryPacket, attempt] : retries) {
+            m_retries++;
+            NS_LOG_DEBUG("LB (L7): Retrying rejected request (retry " << attempt << " of " << m_maxRetries << ")");
+            AttemptForwardRequest(clientSocket, retryPacket, clientAddress, attempt);
+        }
+    }
+
     Socket::SocketErrno sock_errno = backendSocket->GetErrno();
     if (sock_errno != Socket::ERROR_NOTERROR &&
         sock_errno != Socket::ERROR_AGAIN &&
@@ -654,16 +983,15 @@ void LoadBalancerApp::SendToClient(Ptr<Socket> clientSocket, Ptr<Packet> respons
     NS_LOG_DEBUG("LB (L7): Forwarding response Seq=" << respHeader.GetSeq() << " (Size=" << responsePacket->GetSize()
                  << ") to client " << clientSocket << " (" << GetPeerNameString(clientSocket) << ")");
 
-    int sentBytes = clientSocket->Send(responsePacket);
-
-    if (sentBytes < 0) {
+    SocketTxQueue& txQueue = m_txQueues[clientSocket];
+    if (!txQueue.Send(clientSocket, responsePacket)) {
         Socket::SocketErrno error = clientSocket->GetErrno();
         NS_LOG_WARN("LB (L7): Error sending L7 response Seq=" << respHeader.GetSeq() << " to client "
                       << clientSocket << " (" << GetPeerNameString(clientSocket) << "): Errno " << error
                       << " (" << std::strerror(error) << ")");
-    } else if (static_cast<uint32_t>(sentBytes) < responsePacket->GetSize()) {
-        NS_LOG_WARN("LB (L7): Could not send full L7 response Seq=" << respHeader.GetSeq() << " to client "
-                      << clientSocket << " immediately. Sent " << sentBytes << "/" << responsePacket->GetSize()
+    } else if (txQueue.HasPending()) {
+        NS_LOG_DEBUG("LB (L7): Could not send full L7 response Seq=" << respHeader.GetSeq() << " to client "
+                      << clientSocket << " immediately. " << txQueue.GetPendingBytes() << " bytes queued"
                       << ". Disabling reads from associated backend sockets temporarily.");
 
         auto client_backends_it = m_clientBackendSockets.find(clientSocket);
@@ -723,9 +1051,8 @@ void LoadBalancerApp::SendToBackend(Ptr<Socket> backendSocket, Ptr<Packet> reque
     NS_LOG_DEBUG("LB (L7): Forwarding request Seq=" << reqHeader.GetSeq() << " (Size=" << requestPacket->GetSize()
                  << ") to backend " << backendSocket << " (" << GetPeerNameString(backendSocket) << ")");
 
-    int sentBytes = backendSocket->Send(requestPacket);
-
-    if (sentBytes < 0) {
+    SocketTxQueue& txQueue = m_txQueues[backendSocket];
+    if (!txQueue.Send(backendSocket, requestPacket)) {
         Socket::SocketErrno error = backendSocket->GetErrno();
         NS_LOG_WARN("LB (L7): Error sending L7 request Seq=" << reqHeader.GetSeq() << " to backend "
                       << backendSocket << " (" << GetPeerNameString(backendSocket) << "): Errno " << error
@@ -733,9 +1060,9 @@ void LoadBalancerApp::SendToBackend(Ptr<Socket> backendSocket, Ptr<Packet> reque
         if (targetAddrKnown) {
             NotifyRequestFinished(targetBackendAddress); 
         }
-    } else if (static_cast<uint32_t>(sentBytes) < requestPacket->GetSize()) {
-        NS_LOG_WARN("LB (L7): Could not send full L7 request Seq=" << reqHeader.GetSeq() << " to backend "
-                      << backendSocket << " immediately. Sent " << sentBytes << "/" << requestPacket->GetSize()
+    } else if (txQueue.HasPending()) {
+        NS_LOG_DEBUG("LB (L7): Could not send full L7 request Seq=" << reqHeader.GetSeq() << " to backend "
+                      << backendSocket << " immediately. " << txQueue.GetPendingBytes() << " bytes queued"
                       << ". Disabling reads from associated client socket temporarily.");
         auto client_it = m_backendClientMap.find(backendSocket);
         if (client_it != m_backendClientMap.end()) {
@@ -754,6 +1081,18 @@ void LoadBalancerApp::HandleSend(Ptr<Socket> socket, uint32_t availableBytes)
 {
     NS_LOG_FUNCTION(this << socket << availableBytes);
 
+    // Drain queued bytes first; reads stay disabled until the queue is empty.
+    auto queue_it = m_txQueues.find(socket);
+    if (queue_it != m_txQueues.end()) {
+        if (!queue_it->second.Flush(socket)) {
+            NS_LOG_WARN("LB (L7): Error flushing queued bytes on socket " << socket << " (" << GetPeerNameString(socket)
+                          << "): Errno " << socket->GetErrno());
+        }
+        if (queue_it->second.HasPending()) {
+            return;
+        }
+    }
+
     auto backend_client_it = m_backendClientMap.find(socket);
     if (backend_client_it != m_backendClientMap.end()) {
         Ptr<Socket> clientSocket = backend_client_it->second;
@@ -814,18 +1153,20 @@ void LoadBalancerApp::HandleBackendClose(Ptr<Socket> backendSocket)
                   << " (socket " << backendSocket << ") closed connection normally.");
 
     if (addrKnown) {
+        auto client_it = m_backendClientMap.find(backendSocket);
+        Ptr<Socket> clientSocket = (client_it != m_backendClientMap.end()) ? client_it->second : nullptr;
         uint32_t count = 0;
-        for(auto it = m_requestSendTimes.begin(); it != m_requestSendTimes.end(); ) {
+        for(auto it = m_backendRequests.begin(); it != m_backendRequests.end(); ) {
             if(it->first.first == backendSocket) { 
-                NotifyRequestFinished(backendAddress); 
+                HandleFailedRequest(clientSocket, backendAddress, it->second.requestPacket, it->second.attempt);
                 count++;
-                it = m_requestSendTimes.erase(it);
+                it = m_backendRequests.erase(it);
             } else {
                 ++it;
             }
         }
-        if(count > 0) NS_LOG_DEBUG(" -- Notified request finished for " << count
-                                   << " outstanding requests on normally closed backend " << backendAddress);
+        if(count > 0) NS_LOG_WARN(" -- Backend " << backendAddress << " closed with " << count
+                                  << " requests outstanding; reported them as failures.");
     } else {
         NS_LOG_WARN(" -- Could not get backend address for normally closed socket " << backendSocket
                       << " to notify finish for outstanding requests.");
@@ -853,20 +1194,24 @@ void LoadBalancerApp::HandleBackendError(Ptr<Socket> backendSocket)
     if (pending_it != m_pendingBackendRequests.end()) {
         InetSocketAddress targetAddr = pending_it->second.targetBackendAddress;
         NS_LOG_WARN(" -- Backend error occurred on a socket with a PENDING connection request to " << targetAddr);
-        NotifyRequestFinished(targetAddr); 
+        PendingRequest pendingInfo = pending_it->second;
+        m_pendingBackendRequests.erase(pending_it);
+        HandleFailedRequest(pendingInfo.clientSocket, targetAddr, pendingInfo.requestPacket, pendingInfo.attempt);
     } else if (addrKnown) {
+        auto client_it = m_backendClientMap.find(backendSocket);
+        Ptr<Socket> clientSocket = (client_it != m_backendClientMap.end()) ? client_it->second : nullptr;
         uint32_t count = 0;
-        for(auto it = m_requestSendTimes.begin(); it != m_requestSendTimes.end(); ) {
+        for(auto it = m_backendRequests.begin(); it != m_backendRequests.end(); ) {
             if(it->first.first == backendSocket) {
-                NotifyRequestFinished(backendAddress);
+                HandleFailedRequest(clientSocket, backendAddress, it->second.requestPacket, it->second.attempt);
                 count++;
-                it = m_requestSendTimes.erase(it);
+                it = m_backendRequests.erase(it);
             } else {
                 ++it;
             }
         }
-        if(count > 0) NS_LOG_DEBUG(" -- Notified request finished for " << count
-                                   << " outstanding requests on errored backend " << backendAddress);
+        if(count > 0) NS_LOG_WARN(" -- Backend " << backendAddress << " errored with " << count
+                                  << " requests outstanding; reported them as failures.");
     } else {
         NS_LOG_WARN(" -- Could not determine address for errored backend socket " << backendSocket
                       << " to precisely notify request finished for outstanding requests.");
@@ -899,6 +1244,7 @@ void LoadBalancerApp::CleanupClient(Ptr<Socket> clientSocket) {
     }
 
     m_clientRxBuffers.erase(clientSocket);
+    m_txQueues.erase(clientSocket);
 
     for (auto it = m_pendingBackendRequests.begin(); it != m_pendingBackendRequests.end(); ) {
         if (it->second.clientSocket == clientSocket) {
@@ -979,6 +1325,7 @@ void LoadBalancerApp::CleanupBackendSocket(Ptr<Socket> backendSocket, bool mapEr
     }
 
     m_backendRxBuffers.erase(backendSocket);
+    m_txQueues.erase(backendSocket);
 
     auto pending_it = m_pendingBackendRequests.find(backendSocket);
     if (pending_it != m_pendingBackendRequests.end()) {
@@ -991,7 +1338,7 @@ void LoadBalancerApp::CleanupBackendSocket(Ptr<Socket> backendSocket, bool mapEr
     }
 
     uint32_t removed_send_times = 0;
-    for (auto it = m_requestSendTimes.begin(); it != m_requestSendTimes.end(); ) {
+    for (auto it = m_backendRequests.begin(); it != m_backendRequests.end(); ) {
         if (it->first.first == backendSocket) {
             if (addrForNotifyKnown) { 
                 NotifyRequestFinished(backendAddressForNotify);
@@ -999,14 +1346,14 @@ void LoadBalancerApp::CleanupBackendSocket(Ptr<Socket> backendSocket, bool mapEr
                  NS_LOG_WARN(" -- Cannot notify request finished for outstanding request on socket "
                                << backendSocket << ", backend address unknown.");
             }
-            it = m_requestSendTimes.erase(it);
+            it = m_backendRequests.erase(it);
             removed_send_times++;
         } else {
             ++it;
         }
     }
     if(removed_send_times > 0) NS_LOG_DEBUG(" -- Removed and notified finish for " << removed_send_times
-                                           << " entries from m_requestSendTimes for backend socket " << backendSocket);
+                                           << " entries from m_backendRequests for backend socket " << backendSocket);
 
     if (!mapEraseOnly) {
         if (backendSocket->GetErrno() != Socket::ERROR_SHUTDOWN) { 
@@ -10,9 +10,11 @@
 #include "ns3/ptr.h"             // For Ptr<Socket>, Ptr<Packet>
 #include "ns3/socket.h"          // For Ptr<Socket> forward declaration resolution & Address
 #include "ns3/packet.h"          // For Ptr<Packet> forward declaration resolution
+#include "ns3/random-variable-stream.h" // For Ptr<UniformRandomVariable>
 
 // Standard Library Includes
 #include <vector>
+#include <deque>
 #include <map>
 #include <string>
 #include <list>
@@ -22,6 +24,7 @@
 
 // Project-Specific Includes
 #include "request_response_header.h" // Custom L7 header
+#include "socket_tx_queue.h"         // Send queues for messages larger than a socket buffer
 
 namespace ns3 {
 
@@ -35,6 +38,8 @@ struct BackendInfo {
     InetSocketAddress address;           //!< Backend server address (IP:Port).
     uint32_t weight;                     //!< Weight assigned for load balancing decisions.
     uint32_t activeRequests;             //!< Count of L7 requests currently active on this backend.
+    Time latencyEstimate;                //!< EWMA of the backend's response times (zero before the first).
+    Time latencyEstimateTime;            //!< When latencyEstimate last took a sample.
 
     /**
      * @brief Constructs BackendInfo with a specific address and weight.
@@ -42,13 +47,14 @@ struct BackendInfo {
      * @param w The weight for the backend.
      */
     BackendInfo(InetSocketAddress addr, uint32_t w)
-        : address(addr), weight(w), activeRequests(0) {}
+        : address(addr), weight(w), activeRequests(0), latencyEstimate(0), latencyEstimateTime(0) {}
 
     /**
      * @brief Default constructor. Initializes with a default address and weight.
      * Required for some standard container operations.
      */
-    BackendInfo() : address(Ipv4Address::GetAny(), 0), weight(1), activeRequests(0) {}
+    BackendInfo()
+        : address(Ipv4Address::GetAny(), 0), weight(1), activeRequests(0), latencyEstimate(0), latencyEstimateTime(0) {}
 
     BackendInfo(const BackendInfo& other) = default;
 
@@ -65,6 +71,21 @@ struct BackendInfo {
  * - Parsing a custom `RequestResponseHeader` to identify requests and responses.
  * - Forwarding client requests to a chosen backend.
  * - Relaying backend responses back to the appropriate client.
+ * - Handling responses a backend marks as rejected (load shedding): they are counted, reported
+ *   to the algorithm as failures (`RecordBackendFailure`) rather than as fast responses, and
+ *   optionally retried on a backend chosen anew (MaxRetries) before the client sees them.
+ * - Handling backend failures: a request whose backend connection is refused, closed or
+ *   reset before the response is reported as a failure too, and retried or counted as lost.
+ * - Backend timeouts (RequestTimeout): a request a backend has not answered in time (e.g. a
+ *   hung server) is handled like one lost to its connection, which releases its in-flight
+ *   count. A response arriving after that is discarded.
+ * - Deadline-aware dispatch (DeadlineAware): a request whose header carries a deadline that
+ *   the chosen backend cannot meet, judged by an EWMA of that backend's response times, is
+ *   answered at once with STATUS_DEADLINE_EXCEEDED instead of being forwarded. The estimate
+ *   decays towards zero while the backend gets no requests (EstimateDecayTime), so a backend
+ *   judged too slow is probed again and can recover. A STATUS_DEADLINE_EXCEEDED answer from
+ *   a backend is fed back by the RejectionFeedback policy, without counting as a rejection,
+ *   and is not retried.
  *
  * Derived classes must implement the specific backend selection logic (`ChooseBackend`)
  * and potentially update their internal state based on request lifecycle events
@@ -79,6 +100,15 @@ class LoadBalancerApp : public Application
      */
     static TypeId GetTypeId(void);
 
+    /**
+     * @brief How a rejected response is reported to the algorithm.
+     */
+    enum RejectionFeedback
+    {
+        REJECTION_AS_FAILURE, //!< Report a failure (RecordBackendFailure); the RTT is ignored.
+        REJECTION_AS_LATENCY  //!< Report the rejection's RTT like any other response (naive).
+    };
+
     LoadBalancerApp();
     virtual ~LoadBalancerApp() override;
 
@@ -111,6 +141,124 @@ class LoadBalancerApp : public Application
         return m_backends;
     }
 
+    /**
+     * @brief Assigns a fixed random variable stream to the generator used for backend selection.
+     * @param stream The first stream index to use.
+     * @return The number of stream indices assigned (1).
+     */
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+    /**
+     * @brief Gets the number of rejected responses received from backends (including retried ones).
+     * @return The rejection count.
+     */
+    uint64_t GetRejectionCount() const;
+
+    /**
+     * @brief Gets the number of rejected requests sent again to a backend.
+     * @return The retry count.
+     */
+    uint64_t GetRetryCount() const;
+
+    /**
+     * @brief Gets the number of requests lost because their backend connection was refused,
+     * closed or reset before the response, and that were not retried.
+     * @return The lost request count.
+     */
+    uint64_t GetLostRequestCount() const;
+
+    /**
+     * @brief Gets the number of requests a backend did not answer within RequestTimeout
+     * (retried ones included).
+     * @return The timed-out request count.
+     */
+    uint64_t GetTimedOutCount() const;
+
+    /**
+     * @brief Gets the number of requests failed fast because their deadline could not be met.
+     * @return The deadline fast-fail count.
+     */
+    uint64_t GetDeadlineFailCount() const;
+
+    /**
+     * @brief Gets the estimated response time of a backend used for deadline checks.
+     * @param backendAddress The backend.
+     * @return The EWMA of its response times, decayed by the time since its last sample
+     * (zero if unknown or not yet measured).
+     */
+    Time GetLatencyEstimate(const InetSocketAddress& backendAddress) const;
+
+    /**
+     * @brief Gets the number of requests routed to a backend so far (retries included).
+     * @param backendAddress The backend.
+     * @return The routed request count.
+     */
+    uint64_t GetRoutedCount(const InetSocketAddress& backendAddress) const;
+
+    /**
+     * @brief Gets when a request was last routed to a backend.
+     * @param backendAddress The backend.
+     * @return The time of the last routing decision for it (zero if none).
+     */
+    Time GetLastRoutedTime(const InetSocketAddress& backendAddress) const;
+
+    // --- Embedded Picker Interface ---
+    // A LoadBalancerApp that is never installed on a node can serve as the backend picker
+    // of a client doing client-side (sidecar) load balancing. The client forwards its own
+    // request lifecycle events, so the picker only learns from that client's traffic.
+
+    /**
+     * @brief Chooses a backend for a request without proxying it.
+     * @param l7Identifier The request's L7 identifier.
+     * @param[out] chosenBackend The selected backend.
+     * @return True if a backend was chosen, false otherwise.
+     */
+    bool PickBackend(uint64_t l7Identifier, InetSocketAddress& chosenBackend);
+
+    /**
+     * @brief Reports that a request has been sent to a backend.
+     * @param backendAddress The backend the request was sent to.
+     */
+    void ReportRequestSent(const InetSocketAddress& backendAddress);
+
+    /**
+     * @brief Reports that a request to a backend has finished (answered, timed out or lost).
+     * @param backendAddress The backend the request was sent to.
+     */
+    void ReportRequestFinished(const InetSocketAddress& backendAddress);
+
+    /**
+     * @brief Reports the round-trip time of a request answered by a backend.
+     * Call before ReportRequestFinished() for the same request, as the proxy does.
+     * @param backendAddress The backend that answered.
+     * @param rtt The measured round-trip time.
+     */
+    void ReportBackendLatency(const InetSocketAddress& backendAddress, Time rtt);
+
+    /**
+     * @brief Reports a request the backend rejected, applying the RejectionFeedback policy.
+     * Call instead of ReportBackendLatency() and before ReportRequestFinished() for the request.
+     * @param backendAddress The backend that rejected the request.
+     * @param rtt The round-trip time of the rejection.
+     */
+    void ReportBackendRejection(const InetSocketAddress& backendAddress, Time rtt);
+
+    /**
+     * @brief Reports a request answered with a missed deadline. Feeds it back like a rejection,
+     * as the RejectionFeedback policy says, but does not count it in GetRejectionCount().
+     * Call instead of ReportBackendLatency() and before ReportRequestFinished() for the request.
+     * @param backendAddress The backend that answered.
+     * @param rtt The round-trip time of the answer.
+     */
+    void ReportBackendDeadlineMiss(const InetSocketAddress& backendAddress, Time rtt);
+
+    /**
+     * @brief Reports a request lost because its connection to the backend closed or failed.
+     * Call before ReportRequestFinished() for the request.
+     * @param backendAddress The backend the request was sent to.
+     */
+    void ReportBackendFailure(const InetSocketAddress& backendAddress);
+
   protected:
     /**
      * @brief Called by the simulation core to dispose of the application's resources.
@@ -146,6 +294,16 @@ class LoadBalancerApp : public Application
      */
     virtual void RecordBackendLatency(InetSocketAddress backendAddress, Time rtt) = 0;
 
+    /**
+     * @brief Records that a backend failed a request without serving it (e.g. rejected it).
+     *
+     * Latency-aware algorithms should override this so that a backend answering quickly
+     * with failures does not look fast. The default does nothing.
+     *
+     * @param backendAddress The address of the backend server that failed the request.
+     */
+    virtual void RecordBackendFailure(InetSocketAddress backendAddress);
+
     /**
      * @brief Pure virtual method called when a request has been successfully sent (or queued for sending
      * if a new backend connection is being established) to a backend server.
@@ -171,6 +329,7 @@ class LoadBalancerApp : public Application
     // Member Variables accessible by derived classes
     uint16_t m_port;                         //!< Port number on which the load balancer listens.
     std::vector<BackendInfo> m_backends;     //!< List of backend server information structures.
+    Ptr<UniformRandomVariable> m_randomGenerator; //!< Shared RNG for all randomized backend selection; see AssignStreams.
 
     /**
      * @brief Finds BackendInfo for a given address (non-const version).
@@ -207,6 +366,17 @@ class LoadBalancerApp : public Application
         Ptr<Packet> requestPacket;          //!< The request packet to send once connected.
         Address clientAddress;              //!< Original client address (for context/logging).
         InetSocketAddress targetBackendAddress; //!< The backend chosen for this pending request.
+        uint32_t attempt;                   //!< Retries of this request so far.
+    };
+
+    /**
+     * @brief Holds state for a request sent to a backend and not yet answered.
+     */
+    struct BackendRequest {
+        Time sendTime;                      //!< When the request was sent, for the RTT.
+        Ptr<Packet> requestPacket;          //!< Copy of the request for retries (null when none remain).
+        uint32_t attempt;                   //!< Retries of this request so far.
+        uint32_t clientSeq;                 //!< The client's sequence number, restored in the response.
     };
 
     Ptr<Socket> m_listeningSocket; //!< Socket listening for incoming client TCP connections.
@@ -218,6 +388,11 @@ class LoadBalancerApp : public Application
     // Key: Backend Socket, Value: Associated receive buffer for data from this backend.
     std::map<Ptr<Socket>, std::string> m_backendRxBuffers;
 
+    // Bytes accepted for forwarding but not yet taken by the socket's send buffer.
+    // Key: Client or Backend Socket, Value: Its send queue. Full messages are buffered here,
+    // so large bodies are store-and-forward through the load balancer.
+    std::map<Ptr<Socket>, SocketTxQueue> m_txQueues;
+
     // Tracks which backend sockets are associated with which client socket.
     // Key: Client Socket, Value: Map of <Backend Address, Backend Socket Ptr> for this client.
     // This allows a client to have connections to multiple backends if the LB logic dictates (e.g. retries to different backends).
@@ -231,10 +406,44 @@ class LoadBalancerApp : public Application
     // Key: Backend Socket (the one being connected), Value: PendingRequest details.
     std::map<Ptr<Socket>, PendingRequest> m_pendingBackendRequests;
 
-    // Stores send timestamps for requests to backends, used for RTT calculation.
-    // Key: Pair of <Backend Socket Ptr, Request Sequence Number>, Value: Time request was sent.
-    using RequestKey = std::pair<Ptr<Socket>, uint32_t>; // Assuming sequence number is uint32_t
-    std::map<RequestKey, Time> m_requestSendTimes;
+    // Stores requests outstanding at backends, used for RTT calculation and retries.
+    // Key: Pair of <Backend Socket Ptr, Backend Sequence Number>, Value: Send time and retry state.
+    // Every attempt goes out under a fresh sequence number of the LB's own, so a late answer to
+    // an attempt that timed out can never be taken for the answer to its retry.
+    using RequestKey = std::pair<Ptr<Socket>, uint32_t>;
+    std::map<RequestKey, BackendRequest> m_backendRequests;
+    uint32_t m_backendSeq = 0;              //!< Last sequence number given to a backend request.
+
+    /**
+     * @brief When a request outstanding at a backend times out.
+     */
+    struct BackendDeadline {
+        Time deadline;                      //!< When the request times out.
+        RequestKey key;                     //!< The request's entry in m_backendRequests.
+    };
+    // All requests share one timeout, so deadlines are queued in send order behind a single timer.
+    std::deque<BackendDeadline> m_backendDeadlines;
+    EventId m_backendTimeoutEvent;          //!< Fires at the earliest queued deadline.
+    uint64_t m_timedOutRequests = 0;        //!< Requests timed out at their backend.
+
+    RejectionFeedback m_rejectionFeedback; //!< How rejections are reported to the algorithm (attribute).
+    uint32_t m_maxRetries;                 //!< Retries of a rejected or failed request before it is given up (attribute).
+    uint64_t m_rejections = 0;             //!< Rejected responses received.
+    uint64_t m_retries = 0;                //!< Rejected or failed requests sent again.
+    uint64_t m_lostRequests = 0;           //!< Requests lost to backend connection failures.
+    Time m_requestTimeout;                 //!< Time a backend has to answer (0 = no timeout) (attribute).
+    bool m_deadlineAware;                  //!< Fail requests that cannot meet their deadline (attribute).
+    Time m_estimateDecayTime;              //!< Time constant of the latency estimate's decay (attribute).
+    uint64_t m_deadlineFailures = 0;       //!< Requests failed fast for their deadline.
+
+    /**
+     * @brief Routing decisions for one backend.
+     */
+    struct RoutingRecord {
+        uint64_t routed = 0;                //!< Requests routed to the backend.
+        Time lastRouted;                    //!< Time of the latest one.
+    };
+    std::map<InetSocketAddress, RoutingRecord> m_routing; //!< Routing decisions per backend.
 
     // --- TCP Callback Handlers ---
     void HandleAccept(Ptr<Socket> socket, const Address& from);
@@ -253,7 +462,44 @@ class LoadBalancerApp : public Application
     void HandleSend(Ptr<Socket> socket, uint32_t availableBytes);
 
     // --- Core L7 Proxy Logic ---
-    void AttemptForwardRequest(Ptr<Socket> clientSocket, Ptr<Packet> requestPacket, const Address& clientAddress);
+    void AttemptForwardRequest(Ptr<Socket> clientSocket, Ptr<Packet> requestPacket, const Address& clientAddress,
+                               uint32_t attempt = 0);
+    /**
+     * @brief Records a request about to be sent to a backend under a fresh backend sequence number.
+     * @param backendSocket The backend connection.
+     * @param requestPacket The request as the client sent it.
+     * @param attempt Retries of the request so far.
+     * @return The packet to send: the request renumbered for the backend.
+     */
+    Ptr<Packet> TrackBackendRequest(Ptr<Socket> backendSocket, Ptr<Packet> requestPacket, uint32_t attempt);
+    /**
+     * @brief Fails the requests whose RequestTimeout has elapsed, then re-arms the timer.
+     */
+    void ExpireBackendRequests();
+    void CountRouted(const InetSocketAddress& backendAddress);
+    /**
+     * @brief Folds a response time into a backend's (decayed) latency estimate.
+     * @param backendAddress The backend that answered.
+     * @param rtt The measured round-trip time.
+     */
+    void UpdateLatencyEstimate(const InetSocketAddress& backendAddress, Time rtt);
+    /**
+     * @brief Reports a response that failed without being served (a rejection or a missed
+     * deadline) to the algorithm, as the RejectionFeedback policy says.
+     * @param backendAddress The backend that answered.
+     * @param rtt The round-trip time of the answer.
+     */
+    void ApplyRejectionFeedback(const InetSocketAddress& backendAddress, Time rtt);
+    /**
+     * @brief Handles a request lost by its backend connection (refused, closed or reset):
+     * reports the failure to the algorithm, then retries the request or counts it as lost.
+     * @param clientSocket The client the request came from (null if unknown).
+     * @param backendAddress The backend the request was sent to.
+     * @param requestPacket The request, or null if it may not be retried.
+     * @param attempt Retries of the request so far.
+     */
+    void HandleFailedRequest(Ptr<Socket> clientSocket, const InetSocketAddress& backendAddress,
+                             Ptr<Packet> requestPacket, uint32_t attempt);
     void SendToClient(Ptr<Socket> clientSocket, Ptr<Packet> responsePacket);
     void SendToBackend(Ptr<Socket> backendSocket, Ptr<Packet> requestPacket);
 
@@ -6,7 +6,7 @@
 #include "ns3/inet-socket-address.h" // For InetSocketAddress
 #include "ns3/ipv4-address.h"        // For Ipv4Address::GetAny()
 #include "ns3/uinteger.h"            // For UintegerValue
-#include "ns3/simulator.h"           // For Simulator::GetContext() in fallback
+#include "ns3/random-variable-stream.h" // For UniformRandomVariable (fallback random selection)
 
 #include <cmath>     // For std::sqrt in IsPrime, std::max
 #include <algorithm> // For std::max, std::min, std::sort
@@ -245,9 +245,7 @@ bool MaglevLoadBalancer::ChooseBackend(Ptr<Packet> packet [[maybe_unused]],
                 }
             }
             if (!eligibleFallbackIndices.empty()) {
-                // Note: Simulator::GetContext() provides some variability but isn't a strong RNG.
-                // For a robust fallback, a Ptr<RandomVariableStream> member would be better.
-                uint32_t randomIndexIntoEligible = Simulator::GetContext() % eligibleFallbackIndices.size();
+                uint32_t randomIndexIntoEligible = m_randomGenerator->GetInteger(0, eligibleFallbackIndices.size() - 1);
                 chosenBackend = m_backends[eligibleFallbackIndices[randomIndexIntoEligible]].address;
                 NS_LOG_WARN("Maglev LB: Fallback selected backend " << chosenBackend << " randomly.");
                 return true;
@@ -6,7 +6,7 @@
 #include "ns3/inet-socket-address.h"    // For InetSocketAddress
 #include "ns3/uinteger.h"               // For UintegerValue
 #include "ns3/double.h"                 // For DoubleValue (though not directly used for attributes here)
-#include "ns3/simulator.h"              // For Simulator::GetContext(), Simulator::Now()
+#include "ns3/simulator.h"              // For Simulator::Now()
 #include "ns3/random-variable-stream.h" // For UniformRandomVariable (already in .h but good for context)
 #include "ns3/core-module.h"            // For Time, Seconds (often includes Simulator and RVS)
 
@@ -33,18 +33,21 @@ TypeId PeakEwmaLoadBalancer::GetTypeId()
                                           "Determines how quickly the EWMA adapts to new latency measurements.",
                                           TimeValue(Seconds(10.0)), // Default decay window
                                           MakeTimeAccessor(&PeakEwmaLoadBalancer::m_decayTime),
-                                          MakeTimeChecker(Time(MilliSeconds(1)))); // Ensure decay time is positive
+                                          MakeTimeChecker(Time(MilliSeconds(1)))) // Ensure decay time is positive
+                            .AddAttribute("FailurePenalty",
+                                          "RTT recorded for a request the backend failed (e.g. rejected). "
+                                          "Being a peak, it takes effect at once and decays over DecayTime.",
+                                          TimeValue(Seconds(1.0)),
+                                          MakeTimeAccessor(&PeakEwmaLoadBalancer::m_failurePenalty),
+                                          MakeTimeChecker(Time(0)));
     return tid;
 }
 
 PeakEwmaLoadBalancer::PeakEwmaLoadBalancer()
     : m_decayTime(Seconds(10.0)), // Default, will be overridden by attribute
-      m_randomGenerator(CreateObject<UniformRandomVariable>())
+      m_failurePenalty(Seconds(1.0))
 {
     NS_LOG_FUNCTION(this);
-    // It's good practice to seed the RNG stream if it's not done by default or if specific behavior is needed.
-    // Using Simulator::GetContext() can provide a unique seed per simulation run context.
-    m_randomGenerator->SetStream(Simulator::GetContext());
 }
 
 PeakEwmaLoadBalancer::~PeakEwmaLoadBalancer()
@@ -232,6 +235,23 @@ void PeakEwmaLoadBalancer::RecordBackendLatency(InetSocketAddress backendAddress
     }
 }
 
+void PeakEwmaLoadBalancer::RecordBackendFailure(InetSocketAddress backendAddress)
+{
+    NS_LOG_FUNCTION(this << backendAddress);
+
+    auto metric_it = m_backendMetrics.find(backendAddress);
+    if (metric_it != m_backendMetrics.end())
+    {
+        metric_it->second.Observe(m_failurePenalty.GetNanoSeconds());
+        NS_LOG_DEBUG("PeakEWMA: Recorded failure penalty " << m_failurePenalty.GetMilliSeconds() << "ms for backend "
+                     << backendAddress << ". New cost: " << metric_it->second.GetCurrentCostNs() / 1e6 << "ms");
+    }
+    else
+    {
+        NS_LOG_WARN("PeakEWMA LB: Cannot record failure for unknown backend " << backendAddress);
+    }
+}
+
 void PeakEwmaLoadBalancer::NotifyRequestSent(InetSocketAddress backendAddress)
 {
     NS_LOG_FUNCTION(this << backendAddress);
@@ -198,12 +198,18 @@ protected:
 
     // Override notification methods from LoadBalancerApp to update EwmaMetrics
     virtual void RecordBackendLatency(InetSocketAddress backendAddress, Time rtt) override;
+    /**
+     * @brief Records a failed request as an RTT of FailurePenalty, so that a backend
+     * rejecting requests quickly looks slow rather than fast.
+     * @param backendAddress The backend that failed the request.
+     */
+    virtual void RecordBackendFailure(InetSocketAddress backendAddress) override;
     virtual void NotifyRequestSent(InetSocketAddress backendAddress) override;
     virtual void NotifyRequestFinished(InetSocketAddress backendAddress) override;
 
 private:
     Time m_decayTime; //!< Configurable decay time for EWMA calculations (attribute).
-    Ptr<UniformRandomVariable> m_randomGenerator; //!< RNG for P2C selection.
+    Time m_failurePenalty; //!< RTT recorded for a failed request (attribute).
 
     //! Map storing EwmaMetric for each backend server, keyed by address.
     std::map<InetSocketAddress, EwmaMetric> m_backendMetrics;
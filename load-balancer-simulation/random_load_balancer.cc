@@ -4,8 +4,7 @@
 #include "ns3/object.h"                 // For NS_OBJECT_ENSURE_REGISTERED
 #include "ns3/packet.h"                 // For Ptr<Packet>
 #include "ns3/inet-socket-address.h"    // For InetSocketAddress
-#include "ns3/simulator.h"              // For Simulator::GetContext()
-#include "ns3/random-variable-stream.h" // For UniformRandomVariable (already in .h)
+#include "ns3/random-variable-stream.h" // For UniformRandomVariable (base-class m_randomGenerator)
 
 // Standard Library Includes (none strictly needed beyond what ns-3 headers provide for this simple class)
 
@@ -25,12 +24,8 @@ TypeId RandomLoadBalancer::GetTypeId()
 }
 
 RandomLoadBalancer::RandomLoadBalancer()
-    : m_randomGenerator(CreateObject<UniformRandomVariable>())
 {
     NS_LOG_FUNCTION(this);
-    // Seed the random number generator stream using the simulation context
-    // to ensure different behavior across different runs or nodes if desired.
-    m_randomGenerator->SetStream(Simulator::GetContext());
 }
 
 RandomLoadBalancer::~RandomLoadBalancer()
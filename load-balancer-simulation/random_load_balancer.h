@@ -77,9 +77,6 @@ class RandomLoadBalancer : public LoadBalancerApp
      * @param backendAddress The address of the backend whose request finished.
      */
     virtual void NotifyRequestFinished(InetSocketAddress backendAddress) override;
-
-  private:
-    Ptr<UniformRandomVariable> m_randomGenerator; //!< Random number generator for selecting backends.
 };
 
 } // namespace ns3
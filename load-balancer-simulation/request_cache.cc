@@ -0,0 +1,214 @@
+#include "request_cache.h"
+
+#include "ns3/assert.h"
+
+#include <algorithm> // For std::min, std::max
+
+namespace ns3 {
+
+RequestCache::RequestCache(uint32_t capacity)
+    : m_capacity(capacity)
+{
+    NS_ASSERT_MSG(capacity > 0, "A request cache needs room for at least one key");
+}
+
+RequestCache::~RequestCache()
+{
+}
+
+bool
+RequestCache::Access(uint64_t key)
+{
+    const bool hit = DoAccess(key);
+    if (hit) {
+        m_hits++;
+    } else {
+        m_misses++;
+    }
+    return hit;
+}
+
+uint32_t
+RequestCache::GetCapacity() const
+{
+    return m_capacity;
+}
+
+uint64_t
+RequestCache::GetHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+RequestCache::GetMisses() const
+{
+    return m_misses;
+}
+
+double
+RequestCache::GetHitRatio() const
+{
+    const uint64_t accesses = m_hits + m_misses;
+    return (accesses > 0) ? static_cast<double>(m_hits) / static_cast<double>(accesses) : 0.0;
+}
+
+LruRequestCache::LruRequestCache(uint32_t capacity)
+    : RequestCache(capacity)
+{
+}
+
+bool
+LruRequestCache::Contains(uint64_t key) const
+{
+    return m_index.count(key) > 0;
+}
+
+size_t
+LruRequestCache::GetSize() const
+{
+    return m_index.size();
+}
+
+void
+LruRequestCache::Clear()
+{
+    m_order.clear();
+    m_index.clear();
+}
+
+bool
+LruRequestCache::DoAccess(uint64_t key)
+{
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_order.splice(m_order.begin(), m_order, it->second);
+        return true;
+    }
+    if (m_index.size() >= m_capacity) {
+        m_index.erase(m_order.back());
+        m_order.pop_back();
+    }
+    m_order.push_front(key);
+    m_index.emplace(key, m_order.begin());
+    return false;
+}
+
+ArcRequestCache::ArcRequestCache(uint32_t capacity)
+    : RequestCache(capacity)
+{
+}
+
+bool
+ArcRequestCache::Contains(uint64_t key) const
+{
+    auto it = m_index.find(key);
+    return it != m_index.end() && (it->second.list == T1 || it->second.list == T2);
+}
+
+size_t
+ArcRequestCache::GetSize() const
+{
+    return m_lists[T1].size() + m_lists[T2].size();
+}
+
+void
+ArcRequestCache::Clear()
+{
+    for (std::list<uint64_t>& list : m_lists)
+    {
+        list.clear();
+    }
+    m_index.clear();
+    m_targetT1 = 0;
+}
+
+bool
+ArcRequestCache::DoAccess(uint64_t key)
+{
+    const size_t c = m_capacity;
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        switch (it->second.list)
+        {
+        case T1:
+        case T2:
+            MoveTo(key, T2);
+            return true;
+        case B1: {
+            // Would have hit with a larger T1: grow its target.
+            const size_t delta = std::max<size_t>(m_lists[B2].size() / m_lists[B1].size(), 1);
+            m_targetT1 = std::min(m_targetT1 + delta, c);
+            Replace(false);
+            MoveTo(key, T2);
+            return false;
+        }
+        case B2: {
+            // Would have hit with a larger T2: shrink T1's target.
+            const size_t delta = std::max<size_t>(m_lists[B1].size() / m_lists[B2].size(), 1);
+            m_targetT1 = (m_targetT1 > delta) ? m_targetT1 - delta : 0;
+            Replace(true);
+            MoveTo(key, T2);
+            return false;
+        }
+        default:
+            break;
+        }
+    }
+
+    // A key in no list.
+    const size_t l1 = m_lists[T1].size() + m_lists[B1].size();
+    const size_t total = l1 + m_lists[T2].size() + m_lists[B2].size();
+    if (l1 == c)
+    {
+        if (m_lists[T1].size() < c) {
+            DropLru(B1);
+            Replace(false);
+        } else {
+            DropLru(T1); // B1 is empty: evict from the cache outright.
+        }
+    }
+    else if (total >= c)
+    {
+        if (total == 2 * c) {
+            DropLru(B2);
+        }
+        Replace(false);
+    }
+    m_lists[T1].push_front(key);
+    m_index[key] = Entry{T1, m_lists[T1].begin()};
+    return false;
+}
+
+void
+ArcRequestCache::Replace(bool keyInB2)
+{
+    const size_t t1 = m_lists[T1].size();
+    if (t1 > 0 && (t1 > m_targetT1 || (keyInB2 && t1 == m_targetT1))) {
+        MoveTo(m_lists[T1].back(), B1);
+    } else if (!m_lists[T2].empty()) {
+        MoveTo(m_lists[T2].back(), B2);
+    }
+}
+
+void
+ArcRequestCache::MoveTo(uint64_t key, ListId to)
+{
+    Entry& entry = m_index.at(key);
+    m_lists[to].splice(m_lists[to].begin(), m_lists[entry.list], entry.where);
+    entry.list = to;
+    entry.where = m_lists[to].begin();
+}
+
+void
+ArcRequestCache::DropLru(ListId list)
+{
+    if (m_lists[list].empty()) {
+        return;
+    }
+    m_index.erase(m_lists[list].back());
+    m_lists[list].pop_back();
+}
+
+} // namespace ns3
@@ -0,0 +1,181 @@
+#ifndef REQUEST_CACHE_H
+#define REQUEST_CACHE_H
+
+// Standard Library Includes
+#include <cstddef> // For size_t
+#include <cstdint> // For uint32_t, uint64_t
+#include <list>
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * @brief Model of a server-side cache of request keys (L7 identifiers).
+ *
+ * Only the keys are tracked: whether a request hits decides how long serving it takes,
+ * not what it returns. Every access of a missing key inserts it, evicting by the policy
+ * of the subclass once Capacity keys are cached.
+ */
+class RequestCache
+{
+  public:
+    /**
+     * @brief Creates an empty cache.
+     * @param capacity Number of keys the cache holds (at least 1).
+     */
+    explicit RequestCache(uint32_t capacity);
+    virtual ~RequestCache();
+
+    /**
+     * @brief Checks whether a key is cached, without changing the cache.
+     * @param key The request key.
+     * @return True if an access now would hit.
+     */
+    virtual bool Contains(uint64_t key) const = 0;
+
+    /**
+     * @brief Accesses a key: a hit refreshes it, a miss inserts it.
+     * @param key The request key.
+     * @return True on a hit.
+     */
+    bool Access(uint64_t key);
+
+    /**
+     * @brief Gets the number of keys cached.
+     * @return The cache size.
+     */
+    virtual size_t GetSize() const = 0;
+
+    /**
+     * @brief Empties the cache (e.g. when the server restarts). Counters are kept.
+     */
+    virtual void Clear() = 0;
+
+    /**
+     * @brief Gets the number of keys the cache holds when full.
+     * @return The capacity.
+     */
+    uint32_t GetCapacity() const;
+
+    /**
+     * @brief Gets the number of accesses that hit.
+     * @return The hit count.
+     */
+    uint64_t GetHits() const;
+
+    /**
+     * @brief Gets the number of accesses that missed.
+     * @return The miss count.
+     */
+    uint64_t GetMisses() const;
+
+    /**
+     * @brief Gets the fraction of accesses that hit.
+     * @return The hit ratio, 0 before the first access.
+     */
+    double GetHitRatio() const;
+
+  protected:
+    /**
+     * @brief Accesses a key, updating the policy's state.
+     * @param key The request key.
+     * @return True on a hit.
+     */
+    virtual bool DoAccess(uint64_t key) = 0;
+
+    uint32_t m_capacity; //!< Keys held when full.
+
+  private:
+    uint64_t m_hits = 0;   //!< Accesses that hit.
+    uint64_t m_misses = 0; //!< Accesses that missed.
+};
+
+/**
+ * @brief Least recently used eviction.
+ */
+class LruRequestCache : public RequestCache
+{
+  public:
+    explicit LruRequestCache(uint32_t capacity);
+
+    virtual bool Contains(uint64_t key) const override;
+    virtual size_t GetSize() const override;
+    virtual void Clear() override;
+
+  protected:
+    virtual bool DoAccess(uint64_t key) override;
+
+  private:
+    std::list<uint64_t> m_order; //!< Cached keys, most recently used first.
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> m_index; //!< Position of each cached key.
+};
+
+/**
+ * @brief Adaptive Replacement Cache (Megiddo and Modha, FAST 2003).
+ *
+ * Cached keys are split between T1 (seen once recently) and T2 (seen at least twice);
+ * ghost lists B1 and B2 remember the keys recently evicted from each. A miss on a ghost
+ * shifts the target size of T1 towards the list that would have hit, so the cache adapts
+ * between recency and frequency and a one-off scan cannot flush the popular keys.
+ */
+class ArcRequestCache : public RequestCache
+{
+  public:
+    explicit ArcRequestCache(uint32_t capacity);
+
+    virtual bool Contains(uint64_t key) const override;
+    virtual size_t GetSize() const override;
+    virtual void Clear() override;
+
+  protected:
+    virtual bool DoAccess(uint64_t key) override;
+
+  private:
+    /**
+     * @brief The four ARC lists.
+     */
+    enum ListId
+    {
+        T1, //!< Cached, seen once.
+        T2, //!< Cached, seen more than once.
+        B1, //!< Ghosts evicted from T1.
+        B2, //!< Ghosts evicted from T2.
+        LIST_COUNT
+    };
+
+    /**
+     * @brief Where a key is.
+     */
+    struct Entry
+    {
+        ListId list;                         //!< The list holding the key.
+        std::list<uint64_t>::iterator where; //!< Position in that list.
+    };
+
+    /**
+     * @brief Evicts the least recently used key of T1 or T2 into its ghost list.
+     * @param keyInB2 True if the key being inserted was found in B2.
+     */
+    void Replace(bool keyInB2);
+
+    /**
+     * @brief Moves a key to the most recently used end of a list.
+     * @param key The key (already in the index).
+     * @param to The destination list.
+     */
+    void MoveTo(uint64_t key, ListId to);
+
+    /**
+     * @brief Forgets the least recently used key of a list.
+     * @param list The list.
+     */
+    void DropLru(ListId list);
+
+    std::list<uint64_t> m_lists[LIST_COUNT];       //!< Keys of each list, most recently used first.
+    std::unordered_map<uint64_t, Entry> m_index;   //!< List and position of every key in any list.
+    size_t m_targetT1 = 0;                         //!< Adaptive target size of T1 (ARC's p).
+};
+
+} // namespace ns3
+
+#endif // REQUEST_CACHE_H
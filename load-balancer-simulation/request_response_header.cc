@@ -4,11 +4,32 @@
 #include "ns3/simulator.h" // For Simulator::Now() if used for default timestamp (not in this constructor)
 #include "ns3/buffer.h"    // For Buffer::Iterator serialization/deserialization
 
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For std::lround
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE("RequestResponseHeader");
 NS_OBJECT_ENSURE_REGISTERED(RequestResponseHeader); // Ensure TypeId system registration
 
+namespace { // Anonymous namespace for internal linkage helpers
+
+// Load report utilization is sent in units of 1/10000.
+constexpr double kUtilizationScale = 10000.0;
+
+// Reads a big-endian unsigned integer of up to 8 bytes.
+uint64_t ReadBigEndian(const uint8_t* bytes, uint32_t size)
+{
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+} // namespace
+
 TypeId
 RequestResponseHeader::GetTypeId()
 {
@@ -20,10 +41,22 @@ RequestResponseHeader::GetTypeId()
 }
 
 RequestResponseHeader::RequestResponseHeader()
-    : m_seq(0),
+    : m_version(VERSION),
+      m_seq(0),
       m_timestamp(Seconds(0.0)), // Initialize timestamp to zero
       m_payloadSize(0),
-      m_l7Identifier(0)
+      m_l7Identifier(0),
+      m_decoded(true), // Nothing raw to decode: the defaults below are the extensions.
+      m_rawSize(0),
+      m_status(STATUS_OK),
+      m_priority(0),
+      m_deadline(Seconds(0.0)),
+      m_hasLoadReport(false),
+      m_loadReport{0, 0.0},
+      m_traceId(0),
+      m_sessionKey(0),
+      m_responseSize(0),
+      m_serviceTimeHint(Seconds(0.0))
 {
     NS_LOG_FUNCTION(this);
 }
@@ -39,26 +72,58 @@ RequestResponseHeader::GetInstanceTypeId() const
     return GetTypeId();
 }
 
+uint32_t
+RequestResponseHeader::PeekSerializedSize(const uint8_t* prefix)
+{
+    // The extension length is the second byte of the prefix, right after the version.
+    return PREFIX_SIZE + prefix[1];
+}
+
 void
 RequestResponseHeader::Print(std::ostream& os) const
 {
     // Print all member variables for debugging and logging
-    os << "Seq=" << m_seq
+    DecodeExtensions();
+    os << "Version=" << static_cast<uint32_t>(m_version)
+       << ", Seq=" << m_seq
        << ", Timestamp=" << m_timestamp.GetSeconds() << "s"
        << " (or " << m_timestamp.GetNanoSeconds() << "ns)" // Also show ns for precision
        << ", PayloadSize=" << m_payloadSize
-       << ", L7Id=" << m_l7Identifier;
+       << ", L7Id=" << m_l7Identifier
+       << ", ServiceTimeHint=" << m_serviceTimeHint.GetNanoSeconds() << "ns"
+       << ", ResponseSize=" << m_responseSize
+       << ", Status=" << static_cast<uint32_t>(m_status)
+       << ", Priority=" << static_cast<uint32_t>(m_priority)
+       << ", Deadline=" << m_deadline.GetNanoSeconds() << "ns"
+       << ", TraceId=" << m_traceId
+       << ", SessionKey=" << m_sessionKey;
+    if (m_hasLoadReport) {
+        os << ", Load=" << m_loadReport.activeRequests << "/" << m_loadReport.utilization;
+    }
 }
 
 uint32_t
 RequestResponseHeader::GetSerializedSize() const
 {
-    // Calculate the total size of the header when serialized:
-    // Sequence Number (uint32_t)
-    // Timestamp (int64_t, as nanoseconds)
-    // Payload Size (uint32_t)
-    // L7 Identifier (uint64_t)
-    return sizeof(m_seq) + sizeof(int64_t) + sizeof(m_payloadSize) + sizeof(m_l7Identifier);
+    // Prefix: version (u8), extension length (u8), reserved (u16), sequence number (u32),
+    // timestamp (i64 ns), payload size (u32), L7 identifier (u64); then the extensions.
+    return PREFIX_SIZE + (m_decoded ? GetEncodedExtensionSize() : m_rawSize);
+}
+
+uint32_t
+RequestResponseHeader::GetEncodedExtensionSize() const
+{
+    // Each extension is a type byte and a length byte followed by its value.
+    uint32_t size = 0;
+    size += (m_status != STATUS_OK) ? 2 + 1 : 0;
+    size += (m_priority != 0) ? 2 + 1 : 0;
+    size += !m_deadline.IsZero() ? 2 + 8 : 0;
+    size += m_hasLoadReport ? 2 + 6 : 0;
+    size += (m_traceId != 0) ? 2 + 8 : 0;
+    size += (m_sessionKey != 0) ? 2 + 8 : 0;
+    size += (m_responseSize != 0) ? 2 + 4 : 0;
+    size += !m_serviceTimeHint.IsZero() ? 2 + 8 : 0;
+    return size;
 }
 
 void
@@ -66,11 +131,65 @@ RequestResponseHeader::Serialize(Buffer::Iterator start) const
 {
     NS_LOG_FUNCTION(this << &start);
 
+    const uint32_t extensionSize = m_decoded ? GetEncodedExtensionSize() : m_rawSize;
+    NS_ASSERT(extensionSize <= MAX_EXTENSION_SIZE);
+
     // Write members in network byte order (Host TO Network = hton)
+    start.WriteU8(VERSION);
+    start.WriteU8(static_cast<uint8_t>(extensionSize));
+    start.WriteHtonU16(0); // Reserved
     start.WriteHtonU32(m_seq);
     start.WriteHtonU64(m_timestamp.GetNanoSeconds()); // Serialize timestamp as nanoseconds
     start.WriteHtonU32(m_payloadSize);
     start.WriteHtonU64(m_l7Identifier);
+
+    if (!m_decoded) {
+        // Never looked at: forward the extensions as received.
+        start.Write(m_raw, m_rawSize);
+        return;
+    }
+    if (m_status != STATUS_OK) {
+        start.WriteU8(EXT_STATUS);
+        start.WriteU8(1);
+        start.WriteU8(m_status);
+    }
+    if (m_priority != 0) {
+        start.WriteU8(EXT_PRIORITY);
+        start.WriteU8(1);
+        start.WriteU8(m_priority);
+    }
+    if (!m_deadline.IsZero()) {
+        start.WriteU8(EXT_DEADLINE);
+        start.WriteU8(8);
+        start.WriteHtonU64(m_deadline.GetNanoSeconds());
+    }
+    if (m_hasLoadReport) {
+        const double utilization = std::min(std::max(m_loadReport.utilization, 0.0), 1.0);
+        start.WriteU8(EXT_LOAD_REPORT);
+        start.WriteU8(6);
+        start.WriteHtonU32(m_loadReport.activeRequests);
+        start.WriteHtonU16(static_cast<uint16_t>(std::lround(utilization * kUtilizationScale)));
+    }
+    if (m_traceId != 0) {
+        start.WriteU8(EXT_TRACE_ID);
+        start.WriteU8(8);
+        start.WriteHtonU64(m_traceId);
+    }
+    if (m_sessionKey != 0) {
+        start.WriteU8(EXT_SESSION_KEY);
+        start.WriteU8(8);
+        start.WriteHtonU64(m_sessionKey);
+    }
+    if (m_responseSize != 0) {
+        start.WriteU8(EXT_RESPONSE_SIZE);
+        start.WriteU8(4);
+        start.WriteHtonU32(m_responseSize);
+    }
+    if (!m_serviceTimeHint.IsZero()) {
+        start.WriteU8(EXT_SERVICE_TIME_HINT);
+        start.WriteU8(8);
+        start.WriteHtonU64(m_serviceTimeHint.GetNanoSeconds());
+    }
 }
 
 uint32_t
@@ -79,14 +198,106 @@ RequestResponseHeader::Deserialize(Buffer::Iterator start)
     NS_LOG_FUNCTION(this << &start);
 
     // Read members in network byte order (Network TO Host = ntoh)
+    m_version = start.ReadU8();
+    if (m_version != VERSION) {
+        // Read nothing: callers check the size read, and treat the stream as corrupt.
+        NS_LOG_WARN("RequestResponseHeader: unsupported wire format version " << static_cast<uint32_t>(m_version)
+                      << " (expected " << static_cast<uint32_t>(VERSION) << ").");
+        return 0;
+    }
+    m_rawSize = start.ReadU8();
+    start.ReadNtohU16(); // Reserved
     m_seq = start.ReadNtohU32();
     int64_t timeNs = start.ReadNtohU64(); // Read timestamp as nanoseconds
     m_timestamp = NanoSeconds(timeNs);    // Convert back to ns3::Time
     m_payloadSize = start.ReadNtohU32();
     m_l7Identifier = start.ReadNtohU64();
 
-    // Return the number of bytes read, which should match GetSerializedSize()
-    return GetSerializedSize();
+    // Keep the extensions raw; DecodeExtensions() parses them if someone asks.
+    start.Read(m_raw, m_rawSize);
+    m_decoded = false;
+
+    return PREFIX_SIZE + m_rawSize;
+}
+
+void
+RequestResponseHeader::DecodeExtensions() const
+{
+    if (m_decoded) {
+        return;
+    }
+    m_decoded = true;
+    m_status = STATUS_OK;
+    m_priority = 0;
+    m_deadline = Seconds(0.0);
+    m_hasLoadReport = false;
+    m_loadReport = LoadReport{0, 0.0};
+    m_traceId = 0;
+    m_sessionKey = 0;
+    m_responseSize = 0;
+    m_serviceTimeHint = Seconds(0.0);
+
+    uint32_t pos = 0;
+    while (pos + 2 <= m_rawSize)
+    {
+        const uint8_t type = m_raw[pos];
+        const uint8_t length = m_raw[pos + 1];
+        const uint8_t* value = m_raw + pos + 2;
+        pos += 2 + length;
+        if (pos > m_rawSize) {
+            NS_LOG_WARN("RequestResponseHeader: extension " << static_cast<uint32_t>(type)
+                          << " overruns the header; ignoring it.");
+            break;
+        }
+        // A known type with an unexpected length is treated like an unknown one: skipped.
+        switch (type)
+        {
+        case EXT_STATUS:
+            if (length == 1) {
+                m_status = static_cast<Status>(value[0]);
+            }
+            break;
+        case EXT_PRIORITY:
+            if (length == 1) {
+                m_priority = value[0];
+            }
+            break;
+        case EXT_DEADLINE:
+            if (length == 8) {
+                m_deadline = NanoSeconds(static_cast<int64_t>(ReadBigEndian(value, 8)));
+            }
+            break;
+        case EXT_LOAD_REPORT:
+            if (length == 6) {
+                m_hasLoadReport = true;
+                m_loadReport.activeRequests = static_cast<uint32_t>(ReadBigEndian(value, 4));
+                m_loadReport.utilization = ReadBigEndian(value + 4, 2) / kUtilizationScale;
+            }
+            break;
+        case EXT_TRACE_ID:
+            if (length == 8) {
+                m_traceId = ReadBigEndian(value, 8);
+            }
+            break;
+        case EXT_SESSION_KEY:
+            if (length == 8) {
+                m_sessionKey = ReadBigEndian(value, 8);
+            }
+            break;
+        case EXT_RESPONSE_SIZE:
+            if (length == 4) {
+                m_responseSize = static_cast<uint32_t>(ReadBigEndian(value, 4));
+            }
+            break;
+        case EXT_SERVICE_TIME_HINT:
+            if (length == 8) {
+                m_serviceTimeHint = NanoSeconds(static_cast<int64_t>(ReadBigEndian(value, 8)));
+            }
+            break;
+        default:
+            break; // Added by a newer peer: skip.
+        }
+    }
 }
 
 // --- Accessor and Mutator Implementations ---
@@ -139,4 +350,130 @@ RequestResponseHeader::GetL7Identifier() const
     return m_l7Identifier;
 }
 
+uint8_t
+RequestResponseHeader::GetVersion() const
+{
+    return m_version;
+}
+
+void
+RequestResponseHeader::SetServiceTimeHint(Time hint)
+{
+    DecodeExtensions();
+    m_serviceTimeHint = hint;
+}
+
+Time
+RequestResponseHeader::GetServiceTimeHint() const
+{
+    DecodeExtensions();
+    return m_serviceTimeHint;
+}
+
+void
+RequestResponseHeader::SetResponseSize(uint32_t size)
+{
+    DecodeExtensions();
+    m_responseSize = size;
+}
+
+uint32_t
+RequestResponseHeader::GetResponseSize() const
+{
+    DecodeExtensions();
+    return m_responseSize;
+}
+
+void
+RequestResponseHeader::SetStatus(Status status)
+{
+    DecodeExtensions();
+    m_status = status;
+}
+
+RequestResponseHeader::Status
+RequestResponseHeader::GetStatus() const
+{
+    DecodeExtensions();
+    return m_status;
+}
+
+void
+RequestResponseHeader::SetPriority(uint8_t priority)
+{
+    DecodeExtensions();
+    m_priority = priority;
+}
+
+uint8_t
+RequestResponseHeader::GetPriority() const
+{
+    DecodeExtensions();
+    return m_priority;
+}
+
+void
+RequestResponseHeader::SetDeadline(Time deadline)
+{
+    DecodeExtensions();
+    m_deadline = deadline;
+}
+
+Time
+RequestResponseHeader::GetDeadline() const
+{
+    DecodeExtensions();
+    return m_deadline;
+}
+
+void
+RequestResponseHeader::SetLoadReport(const LoadReport& report)
+{
+    DecodeExtensions();
+    m_hasLoadReport = true;
+    m_loadReport = report;
+}
+
+bool
+RequestResponseHeader::HasLoadReport() const
+{
+    DecodeExtensions();
+    return m_hasLoadReport;
+}
+
+RequestResponseHeader::LoadReport
+RequestResponseHeader::GetLoadReport() const
+{
+    DecodeExtensions();
+    return m_loadReport;
+}
+
+void
+RequestResponseHeader::SetTraceId(uint64_t traceId)
+{
+    DecodeExtensions();
+    m_traceId = traceId;
+}
+
+uint64_t
+RequestResponseHeader::GetTraceId() const
+{
+    DecodeExtensions();
+    return m_traceId;
+}
+
+void
+RequestResponseHeader::SetSessionKey(uint64_t key)
+{
+    DecodeExtensions();
+    m_sessionKey = key;
+}
+
+uint64_t
+RequestResponseHeader::GetSessionKey() const
+{
+    DecodeExtensions();
+    return m_sessionKey;
+}
+
 } // namespace ns3
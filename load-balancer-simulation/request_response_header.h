@@ -6,7 +6,7 @@
 #include "ns3/nstime.h" // For ns3::Time
 
 // Standard Library Includes
-#include <cstdint> // For uint32_t, uint64_t
+#include <cstdint> // For uint8_t, uint32_t, uint64_t
 #include <ostream> // For std::ostream (used in Print method)
 
 namespace ns3 {
@@ -14,12 +14,24 @@ namespace ns3 {
 /**
  * @brief A custom header for request and response messages in network simulations.
  *
- * This header facilitates tracking and routing of messages by including:
+ * The header starts with a fixed prefix (PREFIX_SIZE bytes) holding what every hop reads:
+ * - A wire format version and the length of the extensions that follow the prefix.
  * - A sequence number (`m_seq`) for identifying individual messages or ordering.
  * - A timestamp (`m_timestamp`) typically used to mark the send time for latency calculations.
  * - The size of the payload (`m_payloadSize`) that follows this header in a packet.
  * - A Layer 7 identifier (`m_l7Identifier`) which can be used for consistent hashing
  * or flow identification by load balancers or other application-level entities.
+ *
+ * Everything else travels as optional type-length-value extensions, each sent only when it
+ * differs from its default: response status, priority, deadline, server load report, trace
+ * id, session key, response size and service-time hint. A new feature adds an extension
+ * type rather than changing the prefix; receivers skip extension types they do not know.
+ * The version only changes when the prefix itself does.
+ *
+ * Deserializing copies the extensions as raw bytes into the header, without allocating,
+ * and decodes them on first access, so a hop that only routes on the prefix never parses
+ * them. Once decoded (or modified), the extensions are re-encoded from the decoded values;
+ * unknown extensions are dropped at that point.
  */
 class RequestResponseHeader : public Header
 {
@@ -31,6 +43,52 @@ class RequestResponseHeader : public Header
      */
     static TypeId GetTypeId();
 
+    /**
+     * @brief Outcome of a request, carried by its response.
+     */
+    enum Status : uint8_t
+    {
+        STATUS_OK = 0,               //!< The request was served (also the value carried by requests).
+        STATUS_REJECTED = 1,         //!< The server shed the request without serving it.
+        STATUS_DEADLINE_EXCEEDED = 2 //!< The request's deadline passed, or could not be met, before it was served.
+    };
+
+    /**
+     * @brief Type codes of the optional extensions.
+     */
+    enum ExtensionType : uint8_t
+    {
+        EXT_STATUS = 1,            //!< u8 response status.
+        EXT_PRIORITY = 2,          //!< u8 request priority.
+        EXT_DEADLINE = 3,          //!< i64 absolute deadline (ns).
+        EXT_LOAD_REPORT = 4,       //!< u32 active requests, u16 utilization (1/10000).
+        EXT_TRACE_ID = 5,          //!< u64 trace id.
+        EXT_SESSION_KEY = 6,       //!< u64 session key.
+        EXT_RESPONSE_SIZE = 7,     //!< u32 response payload size.
+        EXT_SERVICE_TIME_HINT = 8  //!< i64 service-time hint (ns).
+    };
+
+    /**
+     * @brief Load a server reports in its responses.
+     */
+    struct LoadReport
+    {
+        uint32_t activeRequests; //!< Requests in progress at the server.
+        double utilization;      //!< Busy fraction of the server's workers, in [0, 1].
+    };
+
+    static constexpr uint8_t VERSION = 1;               //!< Wire format version written by this header.
+    static constexpr uint32_t PREFIX_SIZE = 28;         //!< Bytes of the fixed prefix.
+    static constexpr uint32_t MAX_EXTENSION_SIZE = 255; //!< Largest extension block.
+
+    /**
+     * @brief Reads the full serialized size of a header from its prefix, without
+     * deserializing it, to frame messages in a byte stream.
+     * @param prefix At least PREFIX_SIZE bytes starting at the header.
+     * @return The header size in bytes (prefix plus extensions).
+     */
+    static uint32_t PeekSerializedSize(const uint8_t* prefix);
+
     RequestResponseHeader();
     virtual ~RequestResponseHeader() override;
 
@@ -65,11 +123,12 @@ class RequestResponseHeader : public Header
     virtual void Serialize(Buffer::Iterator start) const override;
 
     /**
-     * @brief Deserializes the header's data members from a byte buffer.
+     * @brief Deserializes the prefix and copies the extensions for lazy decoding.
      * Data is read assuming network byte order.
      * @param start An iterator pointing to the start of the buffer segment from
      * which the header should be read.
-     * @return The number of bytes read from the buffer (should match GetSerializedSize()).
+     * @return The number of bytes read from the buffer (should match GetSerializedSize()),
+     * or 0 on an unknown version.
      */
     virtual uint32_t Deserialize(Buffer::Iterator start) override;
 
@@ -124,11 +183,145 @@ class RequestResponseHeader : public Header
      */
     uint64_t GetL7Identifier() const;
 
+    /**
+     * @brief Gets the wire format version the header was received with.
+     * @return The version (VERSION for headers built locally).
+     */
+    uint8_t GetVersion() const;
+
+    /**
+     * @brief Sets the service-time hint for this request.
+     * @param hint The service time the backend should simulate (zero for none).
+     */
+    void SetServiceTimeHint(Time hint);
+
+    /**
+     * @brief Gets the service-time hint for this request.
+     * @return The hinted service time, or zero if none was set.
+     */
+    Time GetServiceTimeHint() const;
+
+    /**
+     * @brief Sets the payload size the server should send back in its response.
+     * @param size The response payload size in bytes.
+     */
+    void SetResponseSize(uint32_t size);
+
+    /**
+     * @brief Gets the payload size requested for the response.
+     * @return The response payload size in bytes.
+     */
+    uint32_t GetResponseSize() const;
+
+    /**
+     * @brief Sets the response status.
+     * @param status The outcome of the request.
+     */
+    void SetStatus(Status status);
+
+    /**
+     * @brief Gets the response status.
+     * @return The outcome of the request.
+     */
+    Status GetStatus() const;
+
+    /**
+     * @brief Sets the request priority.
+     * @param priority The priority (0, the default, is the lowest).
+     */
+    void SetPriority(uint8_t priority);
+
+    /**
+     * @brief Gets the request priority.
+     * @return The priority, 0 if none was set.
+     */
+    uint8_t GetPriority() const;
+
+    /**
+     * @brief Sets the absolute time by which the request must complete.
+     * @param deadline The deadline (zero for none).
+     */
+    void SetDeadline(Time deadline);
+
+    /**
+     * @brief Gets the absolute deadline of the request.
+     * @return The deadline, or zero if none was set.
+     */
+    Time GetDeadline() const;
+
+    /**
+     * @brief Attaches a server load report (normally to a response).
+     * @param report The server's load.
+     */
+    void SetLoadReport(const LoadReport& report);
+
+    /**
+     * @brief Checks whether the header carries a load report.
+     * @return True if a load report was set.
+     */
+    bool HasLoadReport() const;
+
+    /**
+     * @brief Gets the server load report.
+     * @return The report (all zero if none was set).
+     */
+    LoadReport GetLoadReport() const;
+
+    /**
+     * @brief Sets the distributed trace id.
+     * @param traceId The trace id (zero for none).
+     */
+    void SetTraceId(uint64_t traceId);
+
+    /**
+     * @brief Gets the distributed trace id.
+     * @return The trace id, or zero if none was set.
+     */
+    uint64_t GetTraceId() const;
+
+    /**
+     * @brief Sets the session key, e.g. for session affinity.
+     * @param key The session key (zero for none).
+     */
+    void SetSessionKey(uint64_t key);
+
+    /**
+     * @brief Gets the session key.
+     * @return The session key, or zero if none was set.
+     */
+    uint64_t GetSessionKey() const;
+
   private:
+    /**
+     * @brief Decodes the raw extensions, if that has not happened yet.
+     */
+    void DecodeExtensions() const;
+
+    /**
+     * @brief Computes the size of the extensions encoded from the decoded values.
+     * @return The size in bytes.
+     */
+    uint32_t GetEncodedExtensionSize() const;
+
+    uint8_t m_version;       //!< Wire format version.
     uint32_t m_seq;          //!< Sequence number of the message.
     Time m_timestamp;        //!< Timestamp, e.g., for latency calculation.
     uint32_t m_payloadSize;  //!< Size of the payload immediately following this header.
     uint64_t m_l7Identifier; //!< Layer 7 identifier, e.g., for consistent hashing or flow tracking.
+
+    // Extensions: raw bytes as received until first accessed, then the decoded values below.
+    mutable bool m_decoded;            //!< The decoded values are authoritative.
+    uint8_t m_rawSize;                 //!< Bytes in m_raw.
+    uint8_t m_raw[MAX_EXTENSION_SIZE]; //!< Extensions as received.
+    mutable Status m_status;           //!< Outcome of the request (responses only).
+    mutable uint8_t m_priority;        //!< Request priority.
+    mutable Time m_deadline;           //!< Absolute deadline (zero when none).
+    mutable bool m_hasLoadReport;      //!< A load report was set.
+    mutable LoadReport m_loadReport;   //!< Server load report.
+    mutable uint64_t m_traceId;        //!< Trace id (zero when none).
+    mutable uint64_t m_sessionKey;     //!< Session key (zero when none).
+    mutable uint32_t m_responseSize;   //!< Payload size the response should carry.
+    mutable Time m_serviceTimeHint;    //!< Requested backend service time (zero when not specified).
 };
 
 } // namespace ns3
@@ -6,8 +6,7 @@
 #include "ns3/inet-socket-address.h"    // For InetSocketAddress
 #include "ns3/ipv4-address.h"           // For Ipv4Address (used in address conversion for logging)
 #include "ns3/uinteger.h"               // For UintegerValue
-#include "ns3/simulator.h"              // For Simulator::GetContext() (used in fallback)
-#include "ns3/random-variable-stream.h" // For fallback random selection (though simple modulo is used)
+#include "ns3/random-variable-stream.h" // For UniformRandomVariable (fallback random selection)
 
 #include <cmath>     // For std::round, std::max, std::min
 #include <vector>
@@ -212,7 +211,7 @@ bool RingHashLoadBalancer::ChooseBackend(Ptr<Packet> packet [[maybe_unused]],
                 if (m_backends[i].weight > 0) eligibleIndices.push_back(i);
             }
             if (!eligibleIndices.empty()) {
-                uint32_t randIdxPos = Simulator::GetContext() % eligibleIndices.size();
+                uint32_t randIdxPos = m_randomGenerator->GetInteger(0, eligibleIndices.size() - 1);
                 chosenBackend = m_backends[eligibleIndices[randIdxPos]].address;
                 return true;
             }
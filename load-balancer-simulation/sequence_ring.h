@@ -0,0 +1,250 @@
+#ifndef SEQUENCE_RING_H
+#define SEQUENCE_RING_H
+
+// NS-3 Includes
+#include "ns3/assert.h" // For NS_ASSERT_MSG
+
+// Standard Library Includes
+#include <cstddef> // For size_t
+#include <cstdint> // For uint8_t, uint64_t
+#include <utility> // For std::move
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @brief Map from monotonically increasing sequence numbers to values, stored in a ring.
+ *
+ * Entries live in a power-of-two array at index @c seq mod capacity, so insert, lookup
+ * and erase are O(1) with no allocation in steady state. The ring covers the window
+ * [oldest unresolved sequence, newest sequence]; it doubles when a new sequence would
+ * not fit, and slides forward as the oldest entries are erased.
+ *
+ * An entry can be turned into a tombstone (e.g., when its request times out). A
+ * tombstone keeps its value so a late answer can still be recognised, but it does not
+ * count as live and never forces the ring to grow: when space is needed, tombstones at
+ * the old end of the window are discarded instead.
+ *
+ * @tparam T Value type (must be default-constructible and movable).
+ */
+template <typename T>
+class SequenceRing
+{
+  public:
+    /**
+     * @brief Creates an empty ring.
+     * @param initialCapacity Initial number of slots (rounded up to a power of two).
+     */
+    explicit SequenceRing(size_t initialCapacity = 64)
+    {
+        size_t capacity = 1;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        m_slots.resize(capacity);
+    }
+
+    /**
+     * @brief Inserts a value for a new sequence number.
+     * @param seq Sequence number; must be newer than every sequence inserted so far.
+     * @param value The value to store.
+     */
+    void Insert(uint64_t seq, T value)
+    {
+        if (m_head == m_tail) {
+            m_head = m_tail = seq; // Empty window: restart it at seq.
+        }
+        NS_ASSERT_MSG(seq >= m_tail, "SequenceRing requires increasing sequence numbers");
+
+        while (seq - m_head >= m_slots.size()) {
+            Slot& oldest = m_slots[Index(m_head)];
+            if (oldest.state == kLive) {
+                Grow();
+            } else {
+                oldest.state = kEmpty; // Drop an expired tombstone (or a gap) to make room.
+                ++m_head;
+            }
+        }
+
+        for (uint64_t gap = m_tail; gap < seq; ++gap) {
+            m_slots[Index(gap)].state = kEmpty;
+        }
+        Slot& slot = m_slots[Index(seq)];
+        slot.value = std::move(value);
+        slot.state = kLive;
+        m_tail = seq + 1;
+        ++m_liveCount;
+    }
+
+    /**
+     * @brief Finds the value of a live entry.
+     * @param seq The sequence number.
+     * @return Pointer to the value, or nullptr if absent or tombstoned.
+     */
+    T* Find(uint64_t seq)
+    {
+        Slot* slot = SlotFor(seq);
+        return (slot && slot->state == kLive) ? &slot->value : nullptr;
+    }
+
+    /**
+     * @brief Finds the value of a tombstoned entry.
+     * @param seq The sequence number.
+     * @return Pointer to the value, or nullptr if absent or still live.
+     */
+    T* FindTombstone(uint64_t seq)
+    {
+        Slot* slot = SlotFor(seq);
+        return (slot && slot->state == kTombstone) ? &slot->value : nullptr;
+    }
+
+    /**
+     * @brief Turns a live entry into a tombstone.
+     * @param seq The sequence number.
+     * @return True if a live entry was tombstoned.
+     */
+    bool MarkTombstone(uint64_t seq)
+    {
+        Slot* slot = SlotFor(seq);
+        if (!slot || slot->state != kLive) {
+            return false;
+        }
+        slot->state = kTombstone;
+        --m_liveCount;
+        return true;
+    }
+
+    /**
+     * @brief Removes a live or tombstoned entry.
+     * @param seq The sequence number.
+     * @return True if an entry was removed.
+     */
+    bool Erase(uint64_t seq)
+    {
+        Slot* slot = SlotFor(seq);
+        if (!slot || slot->state == kEmpty) {
+            return false;
+        }
+        if (slot->state == kLive) {
+            --m_liveCount;
+        }
+        slot->state = kEmpty;
+        while (m_head != m_tail && m_slots[Index(m_head)].state == kEmpty) {
+            ++m_head;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Visits every live entry, oldest first.
+     * The visitor may modify values but must not insert or erase entries.
+     * @param visit Callable invoked as visit(uint64_t seq, T& value).
+     */
+    template <typename F>
+    void ForEachLive(F&& visit)
+    {
+        for (uint64_t seq = m_head; seq < m_tail; ++seq) {
+            Slot& slot = m_slots[Index(seq)];
+            if (slot.state == kLive) {
+                visit(seq, slot.value);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes all entries, keeping the current capacity.
+     */
+    void Clear()
+    {
+        for (Slot& slot : m_slots) {
+            slot.state = kEmpty;
+        }
+        m_head = m_tail = 0;
+        m_liveCount = 0;
+    }
+
+    /**
+     * @brief Gets the number of live (non-tombstoned) entries.
+     * @return The live entry count.
+     */
+    size_t Size() const
+    {
+        return m_liveCount;
+    }
+
+    /**
+     * @brief Checks whether there are no live entries.
+     * @return True if Size() is zero.
+     */
+    bool IsEmpty() const
+    {
+        return m_liveCount == 0;
+    }
+
+    /**
+     * @brief Gets the number of slots currently allocated.
+     * @return The capacity.
+     */
+    size_t GetCapacity() const
+    {
+        return m_slots.size();
+    }
+
+  private:
+    static constexpr uint8_t kEmpty = 0;     //!< Slot holds nothing.
+    static constexpr uint8_t kLive = 1;      //!< Slot holds a live entry.
+    static constexpr uint8_t kTombstone = 2; //!< Slot holds a tombstoned entry.
+
+    /**
+     * @brief A ring slot.
+     */
+    struct Slot {
+        T value{};               //!< Stored value (meaningful unless empty).
+        uint8_t state = kEmpty;  //!< kEmpty, kLive or kTombstone.
+    };
+
+    /**
+     * @brief Maps a sequence number to its slot index.
+     * @param seq The sequence number.
+     * @return seq mod capacity.
+     */
+    size_t Index(uint64_t seq) const
+    {
+        return static_cast<size_t>(seq) & (m_slots.size() - 1);
+    }
+
+    /**
+     * @brief Gets the slot of a sequence number inside the current window.
+     * @param seq The sequence number.
+     * @return The slot, or nullptr if seq is outside the window.
+     */
+    Slot* SlotFor(uint64_t seq)
+    {
+        if (seq < m_head || seq >= m_tail) {
+            return nullptr;
+        }
+        return &m_slots[Index(seq)];
+    }
+
+    /**
+     * @brief Doubles the capacity, re-homing every entry of the window.
+     */
+    void Grow()
+    {
+        std::vector<Slot> grown(m_slots.size() * 2);
+        const size_t mask = grown.size() - 1;
+        for (uint64_t seq = m_head; seq < m_tail; ++seq) {
+            grown[static_cast<size_t>(seq) & mask] = std::move(m_slots[Index(seq)]);
+        }
+        m_slots.swap(grown);
+    }
+
+    std::vector<Slot> m_slots; //!< Ring storage; size is a power of two.
+    uint64_t m_head = 0;       //!< Oldest sequence still in the window.
+    uint64_t m_tail = 0;       //!< One past the newest inserted sequence.
+    size_t m_liveCount = 0;    //!< Number of live entries.
+};
+
+} // namespace ns3
+
+#endif // SEQUENCE_RING_H
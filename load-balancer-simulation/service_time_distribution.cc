@@ -0,0 +1,414 @@
+#include "service_time_distribution.h"
+
+#include "utils.h" // For SplitSpec, ParseSpecNumber, LoadEmpiricalCdf
+#include "ns3/log.h"
+#include "ns3/double.h"                 // For DoubleValue
+#include "ns3/string.h"                 // For StringValue
+#include "ns3/random-variable-stream.h"
+#include "ns3/core-module.h"            // For CreateObject
+
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For std::log
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("ServiceTimeDistribution");
+
+NS_OBJECT_ENSURE_REGISTERED(ServiceTimeDistribution);
+NS_OBJECT_ENSURE_REGISTERED(ConstantServiceTime);
+NS_OBJECT_ENSURE_REGISTERED(ExponentialServiceTime);
+NS_OBJECT_ENSURE_REGISTERED(LogNormalServiceTime);
+NS_OBJECT_ENSURE_REGISTERED(BimodalServiceTime);
+NS_OBJECT_ENSURE_REGISTERED(ParetoServiceTime);
+NS_OBJECT_ENSURE_REGISTERED(EmpiricalServiceTime);
+
+namespace { // Anonymous namespace for internal linkage helpers
+
+// Converts a drawn duration in seconds to a Time, clamping it to [0, bound] (bound 0 = none).
+Time ToServiceTime(double seconds, Time bound = Time(0))
+{
+    Time time = Seconds(std::max(seconds, 0.0));
+    if (bound.IsStrictlyPositive()) {
+        time = std::min(time, bound);
+    }
+    return time;
+}
+
+} // namespace
+
+// --- ServiceTimeDistribution ---
+
+TypeId ServiceTimeDistribution::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ServiceTimeDistribution")
+                            .SetParent<Object>()
+                            .SetGroupName("Applications");
+    return tid;
+}
+
+ServiceTimeDistribution::ServiceTimeDistribution()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ServiceTimeDistribution::~ServiceTimeDistribution()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+// --- ConstantServiceTime ---
+
+TypeId ConstantServiceTime::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ConstantServiceTime")
+                            .SetParent<ServiceTimeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<ConstantServiceTime>()
+                            .AddAttribute("Time",
+                                          "Service time of every request.",
+                                          TimeValue(MilliSeconds(0)),
+                                          MakeTimeAccessor(&ConstantServiceTime::m_time),
+                                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+ConstantServiceTime::ConstantServiceTime()
+    : m_time(MilliSeconds(0))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ConstantServiceTime::~ConstantServiceTime()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time ConstantServiceTime::GetNextServiceTime()
+{
+    return m_time;
+}
+
+int64_t ConstantServiceTime::AssignStreams(int64_t stream [[maybe_unused]])
+{
+    return 0; // Deterministic, no random variables.
+}
+
+// --- ExponentialServiceTime ---
+
+TypeId ExponentialServiceTime::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ExponentialServiceTime")
+                            .SetParent<ServiceTimeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<ExponentialServiceTime>()
+                            .AddAttribute("Mean",
+                                          "Mean service time.",
+                                          TimeValue(MilliSeconds(5)),
+                                          MakeTimeAccessor(&ExponentialServiceTime::m_mean),
+                                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+ExponentialServiceTime::ExponentialServiceTime()
+    : m_mean(MilliSeconds(5)),
+      m_draw(CreateObject<ExponentialRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ExponentialServiceTime::~ExponentialServiceTime()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time ExponentialServiceTime::GetNextServiceTime()
+{
+    return ToServiceTime(m_draw->GetValue(m_mean.GetSeconds(), 0.0));
+}
+
+int64_t ExponentialServiceTime::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- LogNormalServiceTime ---
+
+TypeId LogNormalServiceTime::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LogNormalServiceTime")
+                            .SetParent<ServiceTimeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<LogNormalServiceTime>()
+                            .AddAttribute("Median",
+                                          "Median service time, i.e. e^mu.",
+                                          TimeValue(MilliSeconds(5)),
+                                          MakeTimeAccessor(&LogNormalServiceTime::m_median),
+                                          MakeTimeChecker(NanoSeconds(1)))
+                            .AddAttribute("Sigma",
+                                          "Standard deviation of the logarithm of the service time.",
+                                          DoubleValue(1.0),
+                                          MakeDoubleAccessor(&LogNormalServiceTime::m_sigma),
+                                          MakeDoubleChecker<double>(0.0))
+                            .AddAttribute("Bound",
+                                          "Upper bound on a drawn service time (0 = none).",
+                                          TimeValue(Time(0)),
+                                          MakeTimeAccessor(&LogNormalServiceTime::m_bound),
+                                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+LogNormalServiceTime::LogNormalServiceTime()
+    : m_median(MilliSeconds(5)),
+      m_sigma(1.0),
+      m_bound(Time(0)),
+      m_draw(CreateObject<LogNormalRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LogNormalServiceTime::~LogNormalServiceTime()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time LogNormalServiceTime::GetNextServiceTime()
+{
+    return ToServiceTime(m_draw->GetValue(std::log(m_median.GetSeconds()), m_sigma), m_bound);
+}
+
+int64_t LogNormalServiceTime::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- BimodalServiceTime ---
+
+TypeId BimodalServiceTime::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::BimodalServiceTime")
+                            .SetParent<ServiceTimeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<BimodalServiceTime>()
+                            .AddAttribute("Fast",
+                                          "Service time of the fast mode.",
+                                          TimeValue(MilliSeconds(5)),
+                                          MakeTimeAccessor(&BimodalServiceTime::m_fast),
+                                          MakeTimeChecker(Time(0)))
+                            .AddAttribute("Slow",
+                                          "Service time of the slow mode.",
+                                          TimeValue(MilliSeconds(50)),
+                                          MakeTimeAccessor(&BimodalServiceTime::m_slow),
+                                          MakeTimeChecker(Time(0)))
+                            .AddAttribute("SlowFraction",
+                                          "Probability that a request takes the slow mode.",
+                                          DoubleValue(0.1),
+                                          MakeDoubleAccessor(&BimodalServiceTime::m_slowFraction),
+                                          MakeDoubleChecker<double>(0.0, 1.0));
+    return tid;
+}
+
+BimodalServiceTime::BimodalServiceTime()
+    : m_fast(MilliSeconds(5)),
+      m_slow(MilliSeconds(50)),
+      m_slowFraction(0.1),
+      m_draw(CreateObject<UniformRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+BimodalServiceTime::~BimodalServiceTime()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time BimodalServiceTime::GetNextServiceTime()
+{
+    return m_draw->GetValue() < m_slowFraction ? m_slow : m_fast;
+}
+
+int64_t BimodalServiceTime::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- ParetoServiceTime ---
+
+TypeId ParetoServiceTime::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ParetoServiceTime")
+                            .SetParent<ServiceTimeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<ParetoServiceTime>()
+                            .AddAttribute("Minimum",
+                                          "Smallest service time (the Pareto scale).",
+                                          TimeValue(MilliSeconds(5)),
+                                          MakeTimeAccessor(&ParetoServiceTime::m_minimum),
+                                          MakeTimeChecker(Time(0)))
+                            .AddAttribute("Shape",
+                                          "Tail index; smaller values give heavier tails.",
+                                          DoubleValue(2.0),
+                                          MakeDoubleAccessor(&ParetoServiceTime::m_shape),
+                                          MakeDoubleChecker<double>(0.0))
+                            .AddAttribute("Bound",
+                                          "Upper bound on a drawn service time (0 = none).",
+                                          TimeValue(Time(0)),
+                                          MakeTimeAccessor(&ParetoServiceTime::m_bound),
+                                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+ParetoServiceTime::ParetoServiceTime()
+    : m_minimum(MilliSeconds(5)),
+      m_shape(2.0),
+      m_bound(Time(0)),
+      m_draw(CreateObject<ParetoRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ParetoServiceTime::~ParetoServiceTime()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time ParetoServiceTime::GetNextServiceTime()
+{
+    return ToServiceTime(m_draw->GetValue(m_minimum.GetSeconds(), m_shape, 0.0), m_bound);
+}
+
+int64_t ParetoServiceTime::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- EmpiricalServiceTime ---
+
+TypeId EmpiricalServiceTime::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::EmpiricalServiceTime")
+                            .SetParent<ServiceTimeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<EmpiricalServiceTime>()
+                            .AddAttribute("CdfFile",
+                                          "Text file of '<milliseconds> <cumulative probability>' lines.",
+                                          StringValue(""),
+                                          MakeStringAccessor(&EmpiricalServiceTime::m_cdfFile),
+                                          MakeStringChecker());
+    return tid;
+}
+
+EmpiricalServiceTime::EmpiricalServiceTime()
+    : m_draw(CreateObject<UniformRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EmpiricalServiceTime::~EmpiricalServiceTime()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Time EmpiricalServiceTime::GetNextServiceTime()
+{
+    if (m_loadedFile != m_cdfFile || m_timesMs.empty()) {
+        LoadEmpiricalCdf(m_cdfFile, "service time", m_timesMs, m_cumulative);
+        m_loadedFile = m_cdfFile;
+    }
+    return ToServiceTime(InvertEmpiricalCdf(m_draw->GetValue(), m_timesMs, m_cumulative) / 1e3);
+}
+
+int64_t EmpiricalServiceTime::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- Factory ---
+
+Ptr<ServiceTimeDistribution> CreateServiceTimeDistribution(const std::string& spec)
+{
+    NS_LOG_FUNCTION(spec);
+    std::vector<std::string> fields = SplitSpec(spec);
+    double ms = 0.0;
+    if (fields.size() == 1 && ParseSpecNumber(fields[0], ms)) {
+        fields = {"fixed", fields[0]}; // A bare number is shorthand for a fixed service time.
+    }
+    const std::string kind = fields.empty() ? "" : fields[0];
+
+    // Parses fields[index] as a number, aborting with a helpful message on failure.
+    auto numberAt = [&](size_t index, const char* what) {
+        double value = 0.0;
+        if (index >= fields.size() || !ParseSpecNumber(fields[index], value) || value < 0.0) {
+            NS_FATAL_ERROR("Invalid service-time spec '" << spec << "': expected a non-negative number for "
+                           << what << ".");
+        }
+        return value;
+    };
+    // Same, for a field in milliseconds.
+    auto timeAt = [&](size_t index, const char* what) {
+        return TimeValue(Seconds(numberAt(index, what) / 1e3));
+    };
+
+    Ptr<ServiceTimeDistribution> distribution;
+    if (kind == "fixed") {
+        distribution = CreateObject<ConstantServiceTime>();
+        distribution->SetAttribute("Time", timeAt(1, "the service time (ms)"));
+    } else if (kind == "exp" || kind == "exponential") {
+        distribution = CreateObject<ExponentialServiceTime>();
+        distribution->SetAttribute("Mean", timeAt(1, "the mean service time (ms)"));
+    } else if (kind == "lognorm" || kind == "lognormal") {
+        if (numberAt(1, "the median service time (ms)") == 0.0) {
+            NS_FATAL_ERROR("Invalid service-time spec '" << spec << "': the median must be positive.");
+        }
+        distribution = CreateObject<LogNormalServiceTime>();
+        distribution->SetAttribute("Median", timeAt(1, "the median service time (ms)"));
+        distribution->SetAttribute("Sigma", DoubleValue(numberAt(2, "sigma")));
+        if (fields.size() > 3) {
+            distribution->SetAttribute("Bound", timeAt(3, "the bound (ms)"));
+        }
+    } else if (kind == "bimodal") {
+        const double slowFraction = numberAt(3, "the slow fraction");
+        if (slowFraction > 1.0) {
+            NS_FATAL_ERROR("Invalid service-time spec '" << spec << "': the slow fraction must be in [0,1].");
+        }
+        distribution = CreateObject<BimodalServiceTime>();
+        distribution->SetAttribute("Fast", timeAt(1, "the fast service time (ms)"));
+        distribution->SetAttribute("Slow", timeAt(2, "the slow service time (ms)"));
+        distribution->SetAttribute("SlowFraction", DoubleValue(slowFraction));
+    } else if (kind == "pareto") {
+        if (numberAt(2, "the shape") == 0.0) {
+            NS_FATAL_ERROR("Invalid service-time spec '" << spec << "': the shape must be positive.");
+        }
+        distribution = CreateObject<ParetoServiceTime>();
+        distribution->SetAttribute("Minimum", timeAt(1, "the minimum service time (ms)"));
+        distribution->SetAttribute("Shape", DoubleValue(numberAt(2, "the shape")));
+        if (fields.size() > 3) {
+            distribution->SetAttribute("Bound", timeAt(3, "the bound (ms)"));
+        }
+    } else if (kind == "empirical") {
+        // Take the rest of the spec verbatim so paths may contain the delimiter.
+        const std::string path = spec.substr(spec.find(':') + 1);
+        if (fields.size() < 2 || path.empty()) {
+            NS_FATAL_ERROR("Invalid service-time spec '" << spec << "': expected empirical:<cdf file>.");
+        }
+        distribution = CreateObject<EmpiricalServiceTime>();
+        distribution->SetAttribute("CdfFile", StringValue(path));
+    } else {
+        NS_FATAL_ERROR("Unknown service-time distribution '" << kind << "' in spec '" << spec
+                       << "'. Supported: <ms>, fixed, exp, lognorm, bimodal, pareto, empirical.");
+    }
+    return distribution;
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+#ifndef SERVICE_TIME_DISTRIBUTION_H
+#define SERVICE_TIME_DISTRIBUTION_H
+
+// NS-3 Includes
+#include "ns3/nstime.h"
+#include "ns3/object.h"                 // Base class
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h" // For the RandomVariableStream subclasses
+
+// Standard Library Includes
+#include <cstdint> // For int64_t
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @brief Abstract generator of the time a server spends on each request.
+ *
+ * A constant service time makes a slow server consistently slow; the random ones give
+ * every server variance, so algorithms can be compared on noisy but equally fast hosts.
+ * All randomness comes from ns-3 RandomVariableStream objects (see AssignStreams()).
+ */
+class ServiceTimeDistribution : public Object
+{
+  public:
+    /**
+     * @brief Gets the TypeId for this class.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    ServiceTimeDistribution();
+    virtual ~ServiceTimeDistribution() override;
+
+    /**
+     * @brief Draws the service time of the next request.
+     * @return The service time (never negative).
+     */
+    virtual Time GetNextServiceTime() = 0;
+
+    /**
+     * @brief Assigns fixed random variable stream numbers to the random variables used.
+     * @param stream First stream index to use.
+     * @return The number of stream indices assigned.
+     */
+    virtual int64_t AssignStreams(int64_t stream) = 0;
+};
+
+/**
+ * @brief Every request takes the same time.
+ */
+class ConstantServiceTime : public ServiceTimeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    ConstantServiceTime();
+    virtual ~ConstantServiceTime() override;
+
+    virtual Time GetNextServiceTime() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_time; //!< Service time of every request (attribute).
+};
+
+/**
+ * @brief Exponentially distributed service times (the M/M/k textbook case).
+ */
+class ExponentialServiceTime : public ServiceTimeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    ExponentialServiceTime();
+    virtual ~ExponentialServiceTime() override;
+
+    virtual Time GetNextServiceTime() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_mean;                              //!< Mean service time (attribute).
+    Ptr<ExponentialRandomVariable> m_draw;    //!< Source of exponential variates.
+};
+
+/**
+ * @brief Log-normally distributed service times, a common fit for RPC handlers.
+ *
+ * Parameterized by the median (e^mu) rather than mu so specs read in milliseconds.
+ */
+class LogNormalServiceTime : public ServiceTimeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    LogNormalServiceTime();
+    virtual ~LogNormalServiceTime() override;
+
+    virtual Time GetNextServiceTime() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_median;                            //!< Median service time (attribute).
+    double m_sigma;                           //!< Standard deviation of ln(service time) (attribute).
+    Time m_bound;                             //!< Upper bound on a draw, 0 = none (attribute).
+    Ptr<LogNormalRandomVariable> m_draw;      //!< Source of log-normal variates.
+};
+
+/**
+ * @brief A mix of a fast and a slow service time, e.g. cache hits and misses or the
+ * occasional request that hits a garbage collection pause.
+ */
+class BimodalServiceTime : public ServiceTimeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    BimodalServiceTime();
+    virtual ~BimodalServiceTime() override;
+
+    virtual Time GetNextServiceTime() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_fast;                              //!< Service time of the fast mode (attribute).
+    Time m_slow;                              //!< Service time of the slow mode (attribute).
+    double m_slowFraction;                    //!< Probability of the slow mode (attribute).
+    Ptr<UniformRandomVariable> m_draw;        //!< Source of uniform variates.
+};
+
+/**
+ * @brief Pareto (power-law tail) service times starting at a minimum.
+ *
+ * With Shape <= 1 the mean is infinite; set Bound to keep a run's tail finite.
+ */
+class ParetoServiceTime : public ServiceTimeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    ParetoServiceTime();
+    virtual ~ParetoServiceTime() override;
+
+    virtual Time GetNextServiceTime() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    Time m_minimum;                           //!< Smallest service time, the Pareto scale (attribute).
+    double m_shape;                           //!< Tail index (attribute).
+    Time m_bound;                             //!< Upper bound on a draw, 0 = none (attribute).
+    Ptr<ParetoRandomVariable> m_draw;         //!< Source of Pareto variates.
+};
+
+/**
+ * @brief Service times drawn from an empirical CDF read from a text file.
+ *
+ * The file has the format of LoadEmpiricalCdf() with values in milliseconds, e.g. a
+ * measured latency profile of a production handler.
+ */
+class EmpiricalServiceTime : public ServiceTimeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    EmpiricalServiceTime();
+    virtual ~EmpiricalServiceTime() override;
+
+    virtual Time GetNextServiceTime() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    std::string m_cdfFile;              //!< Path of the CDF file (attribute).
+    std::string m_loadedFile;           //!< File the points below were loaded from.
+    std::vector<double> m_timesMs;      //!< CDF abscissae (milliseconds).
+    std::vector<double> m_cumulative;   //!< Cumulative probability at each time.
+    Ptr<UniformRandomVariable> m_draw;  //!< Source of uniform variates.
+};
+
+/**
+ * @brief Builds a ServiceTimeDistribution from a compact command-line spec.
+ *
+ * Supported specs (fields separated by ':', times in milliseconds):
+ * - `ms` or `fixed:ms`                          Every request takes @c ms.
+ * - `exp:meanMs`                                Exponential service times.
+ * - `lognorm:medianMs:sigma[:boundMs]`          Log-normal service times.
+ * - `bimodal:fastMs:slowMs:slowFraction`        Fast requests with a fraction of slow ones.
+ * - `pareto:minMs:shape[:boundMs]`              Pareto tail above @c minMs.
+ * - `empirical:path`                            Times from a CDF file (see EmpiricalServiceTime).
+ *
+ * Terminates the simulation with NS_FATAL_ERROR on an unknown or malformed spec.
+ *
+ * @param spec The spec string.
+ * @return The configured service-time distribution.
+ */
+Ptr<ServiceTimeDistribution> CreateServiceTimeDistribution(const std::string& spec);
+
+} // namespace ns3
+
+#endif // SERVICE_TIME_DISTRIBUTION_H
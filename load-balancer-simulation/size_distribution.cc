@@ -0,0 +1,248 @@
+#include "size_distribution.h"
+
+#include "utils.h" // For SplitSpec, ParseSpecNumber, LoadEmpiricalCdf
+#include "ns3/log.h"
+#include "ns3/double.h"                 // For DoubleValue
+#include "ns3/string.h"                 // For StringValue
+#include "ns3/uinteger.h"               // For UintegerValue
+#include "ns3/random-variable-stream.h" // For LogNormalRandomVariable, UniformRandomVariable
+#include "ns3/core-module.h"            // For CreateObject
+
+#include <algorithm> // For std::min
+#include <cmath>     // For std::log, std::llround
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("SizeDistribution");
+
+NS_OBJECT_ENSURE_REGISTERED(SizeDistribution);
+NS_OBJECT_ENSURE_REGISTERED(ConstantSizeDistribution);
+NS_OBJECT_ENSURE_REGISTERED(LogNormalSizeDistribution);
+NS_OBJECT_ENSURE_REGISTERED(EmpiricalSizeDistribution);
+
+namespace { // Anonymous namespace for internal linkage helpers
+
+constexpr uint32_t kDefaultMaxSize = 64 * 1024 * 1024; // Log-normal cap (64 MiB)
+
+// Rounds a non-negative byte count and clamps it to the 32-bit payload field.
+uint32_t ToPayloadSize(double bytes)
+{
+    const double maxBytes = static_cast<double>(std::numeric_limits<uint32_t>::max());
+    if (!(bytes > 0.0)) {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::llround(std::min(bytes, maxBytes)));
+}
+
+} // namespace
+
+// --- SizeDistribution ---
+
+TypeId SizeDistribution::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::SizeDistribution")
+                            .SetParent<Object>()
+                            .SetGroupName("Applications");
+    return tid;
+}
+
+SizeDistribution::SizeDistribution()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SizeDistribution::~SizeDistribution()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+// --- ConstantSizeDistribution ---
+
+TypeId ConstantSizeDistribution::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::ConstantSizeDistribution")
+                            .SetParent<SizeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<ConstantSizeDistribution>()
+                            .AddAttribute("Size",
+                                          "Payload size of every message (bytes).",
+                                          UintegerValue(100),
+                                          MakeUintegerAccessor(&ConstantSizeDistribution::m_size),
+                                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+ConstantSizeDistribution::ConstantSizeDistribution()
+    : m_size(100)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ConstantSizeDistribution::~ConstantSizeDistribution()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t ConstantSizeDistribution::GetNextSize()
+{
+    return m_size;
+}
+
+int64_t ConstantSizeDistribution::AssignStreams(int64_t stream [[maybe_unused]])
+{
+    return 0; // Deterministic, no random variables.
+}
+
+// --- LogNormalSizeDistribution ---
+
+TypeId LogNormalSizeDistribution::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LogNormalSizeDistribution")
+                            .SetParent<SizeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<LogNormalSizeDistribution>()
+                            .AddAttribute("Median",
+                                          "Median payload size (bytes), i.e. e^mu.",
+                                          DoubleValue(1024.0),
+                                          MakeDoubleAccessor(&LogNormalSizeDistribution::m_median),
+                                          MakeDoubleChecker<double>(1.0))
+                            .AddAttribute("Sigma",
+                                          "Standard deviation of the logarithm of the size.",
+                                          DoubleValue(1.0),
+                                          MakeDoubleAccessor(&LogNormalSizeDistribution::m_sigma),
+                                          MakeDoubleChecker<double>(0.0))
+                            .AddAttribute("MaxSize",
+                                          "Upper bound on a drawn size (bytes).",
+                                          UintegerValue(kDefaultMaxSize),
+                                          MakeUintegerAccessor(&LogNormalSizeDistribution::m_maxSize),
+                                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+LogNormalSizeDistribution::LogNormalSizeDistribution()
+    : m_median(1024.0),
+      m_sigma(1.0),
+      m_maxSize(kDefaultMaxSize),
+      m_draw(CreateObject<LogNormalRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LogNormalSizeDistribution::~LogNormalSizeDistribution()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t LogNormalSizeDistribution::GetNextSize()
+{
+    const double bytes = m_draw->GetValue(std::log(m_median), m_sigma);
+    return std::min(ToPayloadSize(bytes), m_maxSize);
+}
+
+int64_t LogNormalSizeDistribution::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- EmpiricalSizeDistribution ---
+
+TypeId EmpiricalSizeDistribution::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::EmpiricalSizeDistribution")
+                            .SetParent<SizeDistribution>()
+                            .SetGroupName("Applications")
+                            .AddConstructor<EmpiricalSizeDistribution>()
+                            .AddAttribute("CdfFile",
+                                          "Text file of '<bytes> <cumulative probability>' lines.",
+                                          StringValue(""),
+                                          MakeStringAccessor(&EmpiricalSizeDistribution::m_cdfFile),
+                                          MakeStringChecker());
+    return tid;
+}
+
+EmpiricalSizeDistribution::EmpiricalSizeDistribution()
+    : m_draw(CreateObject<UniformRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EmpiricalSizeDistribution::~EmpiricalSizeDistribution()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void EmpiricalSizeDistribution::LoadCdf()
+{
+    NS_LOG_FUNCTION(this << m_cdfFile);
+    LoadEmpiricalCdf(m_cdfFile, "size", m_sizes, m_cumulative);
+    m_loadedFile = m_cdfFile;
+}
+
+uint32_t EmpiricalSizeDistribution::GetNextSize()
+{
+    if (m_loadedFile != m_cdfFile || m_sizes.empty()) {
+        LoadCdf();
+    }
+    return ToPayloadSize(InvertEmpiricalCdf(m_draw->GetValue(), m_sizes, m_cumulative));
+}
+
+int64_t EmpiricalSizeDistribution::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_draw->SetStream(stream);
+    return 1;
+}
+
+// --- Factory ---
+
+Ptr<SizeDistribution> CreateSizeDistribution(const std::string& spec)
+{
+    NS_LOG_FUNCTION(spec);
+    std::vector<std::string> fields = SplitSpec(spec);
+    double bytes = 0.0;
+    if (fields.size() == 1 && ParseSpecNumber(fields[0], bytes)) {
+        fields = {"fixed", fields[0]}; // A bare number is shorthand for a fixed size.
+    }
+    const std::string kind = fields.empty() ? "" : fields[0];
+
+    // Parses fields[index] as a number, aborting with a helpful message on failure.
+    auto numberAt = [&](size_t index, const char* what) {
+        double value = 0.0;
+        if (index >= fields.size() || !ParseSpecNumber(fields[index], value) || value < 0.0) {
+            NS_FATAL_ERROR("Invalid size spec '" << spec << "': expected a non-negative number for " << what << ".");
+        }
+        return value;
+    };
+
+    Ptr<SizeDistribution> distribution;
+    if (kind == "fixed") {
+        distribution = CreateObject<ConstantSizeDistribution>();
+        distribution->SetAttribute("Size", UintegerValue(ToPayloadSize(numberAt(1, "the size (bytes)"))));
+    } else if (kind == "lognormal") {
+        distribution = CreateObject<LogNormalSizeDistribution>();
+        distribution->SetAttribute("Median", DoubleValue(numberAt(1, "the median size (bytes)")));
+        distribution->SetAttribute("Sigma", DoubleValue(numberAt(2, "sigma")));
+        if (fields.size() > 3) {
+            distribution->SetAttribute("MaxSize", UintegerValue(ToPayloadSize(numberAt(3, "the maximum size (bytes)"))));
+        }
+    } else if (kind == "empirical") {
+        // Take the rest of the spec verbatim so paths may contain the delimiter.
+        const std::string path = spec.substr(spec.find(':') + 1);
+        if (fields.size() < 2 || path.empty()) {
+            NS_FATAL_ERROR("Invalid size spec '" << spec << "': expected empirical:<cdf file>.");
+        }
+        distribution = CreateObject<EmpiricalSizeDistribution>();
+        distribution->SetAttribute("CdfFile", StringValue(path));
+    } else {
+        NS_FATAL_ERROR("Unknown size distribution '" << kind << "' in spec '" << spec
+                       << "'. Supported: <bytes>, fixed, lognormal, empirical.");
+    }
+    return distribution;
+}
+
+} // namespace ns3
@@ -0,0 +1,136 @@
+#ifndef SIZE_DISTRIBUTION_H
+#define SIZE_DISTRIBUTION_H
+
+// NS-3 Includes
+#include "ns3/object.h"                 // Base class
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h" // For Ptr<LogNormalRandomVariable>, Ptr<UniformRandomVariable>
+
+// Standard Library Includes
+#include <cstdint> // For int64_t, uint32_t
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * @brief Abstract generator of message payload sizes (request or response bodies).
+ *
+ * Sizes are in bytes and fit the 32-bit payload size field of RequestResponseHeader.
+ * All randomness comes from ns-3 RandomVariableStream objects (see AssignStreams()).
+ */
+class SizeDistribution : public Object
+{
+  public:
+    /**
+     * @brief Gets the TypeId for this class.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    SizeDistribution();
+    virtual ~SizeDistribution() override;
+
+    /**
+     * @brief Draws the payload size of the next message.
+     * @return The size in bytes.
+     */
+    virtual uint32_t GetNextSize() = 0;
+
+    /**
+     * @brief Assigns fixed random variable stream numbers to the random variables used.
+     * @param stream First stream index to use.
+     * @return The number of stream indices assigned.
+     */
+    virtual int64_t AssignStreams(int64_t stream) = 0;
+};
+
+/**
+ * @brief Every message has the same size.
+ */
+class ConstantSizeDistribution : public SizeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    ConstantSizeDistribution();
+    virtual ~ConstantSizeDistribution() override;
+
+    virtual uint32_t GetNextSize() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    uint32_t m_size; //!< Payload size in bytes (attribute).
+};
+
+/**
+ * @brief Log-normally distributed sizes, the usual fit for API and web body sizes.
+ *
+ * Parameterized by the median (e^mu) rather than mu so specs read in bytes. Draws
+ * are rounded to whole bytes and capped at MaxSize to keep the tail finite.
+ */
+class LogNormalSizeDistribution : public SizeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    LogNormalSizeDistribution();
+    virtual ~LogNormalSizeDistribution() override;
+
+    virtual uint32_t GetNextSize() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    double m_median;                        //!< Median size in bytes (attribute).
+    double m_sigma;                         //!< Standard deviation of ln(size) (attribute).
+    uint32_t m_maxSize;                     //!< Upper bound on a draw in bytes (attribute).
+    Ptr<LogNormalRandomVariable> m_draw;    //!< Source of log-normal variates.
+};
+
+/**
+ * @brief Sizes drawn from an empirical CDF read from a text file.
+ *
+ * Each non-empty line that does not start with '#' holds `<bytes> <cumulative probability>`.
+ * Both columns must be non-decreasing and the last probability must be 1. Sampling
+ * inverts the CDF with linear interpolation between points (a binary search per draw);
+ * probability mass below the first point maps to the first size.
+ */
+class EmpiricalSizeDistribution : public SizeDistribution
+{
+  public:
+    static TypeId GetTypeId();
+    EmpiricalSizeDistribution();
+    virtual ~EmpiricalSizeDistribution() override;
+
+    virtual uint32_t GetNextSize() override;
+    virtual int64_t AssignStreams(int64_t stream) override;
+
+  private:
+    /**
+     * @brief Loads the CDF from m_cdfFile, aborting the simulation if it is invalid.
+     */
+    void LoadCdf();
+
+    std::string m_cdfFile;              //!< Path of the CDF file (attribute).
+    std::string m_loadedFile;           //!< File the points below were loaded from.
+    std::vector<double> m_sizes;        //!< CDF abscissae (bytes).
+    std::vector<double> m_cumulative;   //!< Cumulative probability at each size.
+    Ptr<UniformRandomVariable> m_draw;  //!< Source of uniform variates.
+};
+
+/**
+ * @brief Builds a SizeDistribution from a compact command-line spec.
+ *
+ * Supported specs (fields separated by ':'):
+ * - `bytes` or `fixed:bytes`                     Every message carries @c bytes bytes.
+ * - `lognormal:medianBytes:sigma[:maxBytes]`     Log-normal sizes (cap defaults to 64 MiB).
+ * - `empirical:path`                             Sizes from a CDF file (see EmpiricalSizeDistribution).
+ *
+ * Terminates the simulation with NS_FATAL_ERROR on an unknown or malformed spec.
+ *
+ * @param spec The spec string.
+ * @return The configured size distribution.
+ */
+Ptr<SizeDistribution> CreateSizeDistribution(const std::string& spec);
+
+} // namespace ns3
+
+#endif // SIZE_DISTRIBUTION_H
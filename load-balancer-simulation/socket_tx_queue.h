@@ -0,0 +1,106 @@
+#ifndef SOCKET_TX_QUEUE_H
+#define SOCKET_TX_QUEUE_H
+
+// NS-3 Includes
+#include "ns3/packet.h" // For Ptr<Packet>
+#include "ns3/ptr.h"
+#include "ns3/socket.h" // For Socket::GetTxAvailable, Socket::Send
+
+// Standard Library Includes
+#include <algorithm> // For std::min
+#include <cstdint>   // For uint32_t, uint64_t
+#include <deque>
+
+namespace ns3 {
+
+/**
+ * @brief Application-level send queue in front of one TCP socket.
+ *
+ * ns-3 TCP sockets reject (rather than partially accept) a Send() larger than the
+ * free space in their send buffer, so messages bigger than that buffer could never
+ * be sent in one call. The queue accepts whole messages, hands the socket as many
+ * bytes as currently fit (splitting a message where needed; the receiver reassembles
+ * the byte stream anyway), and keeps the rest until Flush() is called from the
+ * socket's send callback.
+ */
+class SocketTxQueue
+{
+  public:
+    /**
+     * @brief Queues a message behind any pending bytes and sends what fits.
+     * @param socket The socket to write to.
+     * @param packet The complete message (header and payload).
+     * @return False if the socket reported an error, true otherwise.
+     */
+    bool Send(Ptr<Socket> socket, Ptr<Packet> packet)
+    {
+        m_pending.push_back(packet->Copy());
+        m_pendingBytes += packet->GetSize();
+        return Flush(socket);
+    }
+
+    /**
+     * @brief Sends as many queued bytes as the socket's send buffer accepts.
+     * @param socket The socket to write to.
+     * @return False if the socket reported an error, true otherwise.
+     */
+    bool Flush(Ptr<Socket> socket)
+    {
+        while (!m_pending.empty())
+        {
+            const uint32_t available = socket->GetTxAvailable();
+            if (available == 0) {
+                return true;
+            }
+            Ptr<Packet> front = m_pending.front();
+            const uint32_t chunk = std::min(available, front->GetSize());
+            Ptr<Packet> piece = (chunk == front->GetSize()) ? front : front->CreateFragment(0, chunk);
+            const int sent = socket->Send(piece);
+            if (sent < 0) {
+                return socket->GetErrno() == Socket::ERROR_MSGSIZE; // Buffer shrank under us; retry later.
+            }
+            m_pendingBytes -= static_cast<uint32_t>(sent);
+            if (static_cast<uint32_t>(sent) == front->GetSize()) {
+                m_pending.pop_front();
+            } else {
+                front->RemoveAtStart(static_cast<uint32_t>(sent));
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks whether bytes are still waiting for send-buffer space.
+     * @return True if the queue is not empty.
+     */
+    bool HasPending() const
+    {
+        return !m_pending.empty();
+    }
+
+    /**
+     * @brief Gets the number of bytes waiting for send-buffer space.
+     * @return The queued byte count.
+     */
+    uint64_t GetPendingBytes() const
+    {
+        return m_pendingBytes;
+    }
+
+    /**
+     * @brief Drops everything still queued (e.g., when the connection is closed).
+     */
+    void Clear()
+    {
+        m_pending.clear();
+        m_pendingBytes = 0;
+    }
+
+  private:
+    std::deque<Ptr<Packet>> m_pending; //!< Messages (the first possibly partly sent) awaiting buffer space.
+    uint64_t m_pendingBytes = 0;       //!< Total bytes in m_pending.
+};
+
+} // namespace ns3
+
+#endif // SOCKET_TX_QUEUE_H
@@ -15,12 +15,35 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE("TopologyCreator");
 
+namespace { // Anonymous namespace for internal linkage helpers
+
+// Creates the downstream tiers' nodes with their internet stacks and returns them all, nearest tier first.
+NodeContainer CreateDownstreamTiers(const std::vector<uint32_t>& tierSizes,
+                                    std::vector<NodeContainer>& tierNodes,
+                                    InternetStackHelper& internetStack)
+{
+    NodeContainer allTiers;
+    tierNodes.assign(tierSizes.size(), NodeContainer());
+    for (size_t t = 0; t < tierSizes.size(); ++t)
+    {
+        tierNodes[t].Create(tierSizes[t]);
+        internetStack.Install(tierNodes[t]);
+        allTiers.Add(tierNodes[t]);
+        NS_LOG_INFO("Downstream tier " << (t + 2) << ": " << tierSizes[t] << " server(s).");
+    }
+    return allTiers;
+}
+
+} // namespace
+
 void CreateTopology(uint32_t numClients,
                     uint32_t numServers,
                     NodeContainer& clientNodes, // Output parameter
                     Ptr<Node>& lbNode,          // Output parameter
                     NodeContainer& serverNodes, // Output parameter
-                    InternetStackHelper& internetStack)
+                    InternetStackHelper& internetStack,
+                    const std::vector<uint32_t>& downstreamTierSizes,
+                    std::vector<NodeContainer>& downstreamTierNodes) // Output parameter
 {
     NS_LOG_FUNCTION(numClients << numServers); // Log input parameters
     NS_LOG_INFO("Creating CSMA topology: " << numClients << " client(s) --- LB --- " << numServers << " server(s).");
@@ -43,6 +66,7 @@ void CreateTopology(uint32_t numClients,
     internetStack.Install(clientNodes);
     internetStack.Install(lbNode);
     internetStack.Install(serverNodes);
+    NodeContainer tierNodes = CreateDownstreamTiers(downstreamTierSizes, downstreamTierNodes, internetStack);
     NS_LOG_INFO("Internet stack installation complete.");
 
     // --- 3. Configure CSMA Channels and Devices ---
@@ -67,6 +91,7 @@ void CreateTopology(uint32_t numClients,
     NodeContainer backendLinkNodes;
     backendLinkNodes.Add(lbNode);          // LB is node 0 on this link's container
     backendLinkNodes.Add(serverNodes);     // Servers are nodes 1 to M on this link's container
+    backendLinkNodes.Add(tierNodes);       // Downstream tiers follow the servers
     NetDeviceContainer backendDevices = csmaHelper.Install(backendLinkNodes);
     // Interface indexing on nodes:
     // - lbNode's backend NetDevice: ifIndex 2 (since frontend was ifIndex 1)
@@ -102,4 +127,42 @@ void CreateTopology(uint32_t numClients,
     // needs to be called in the main simulation script after topology creation.
 }
 
+void CreateFlatTopology(uint32_t numClients,
+                        uint32_t numServers,
+                        NodeContainer& clientNodes, // Output parameter
+                        NodeContainer& serverNodes, // Output parameter
+                        InternetStackHelper& internetStack,
+                        const std::vector<uint32_t>& downstreamTierSizes,
+                        std::vector<NodeContainer>& downstreamTierNodes) // Output parameter
+{
+    NS_LOG_FUNCTION(numClients << numServers);
+    NS_LOG_INFO("Creating flat CSMA topology: " << numClients << " client(s) --- " << numServers << " server(s).");
+
+    clientNodes.Create(numClients);
+    serverNodes.Create(numServers);
+
+    internetStack.Install(serverNodes);
+    internetStack.Install(clientNodes);
+    NodeContainer tierNodes = CreateDownstreamTiers(downstreamTierSizes, downstreamTierNodes, internetStack);
+
+    // A single LAN; every node's CSMA NetDevice is its ifIndex 1 (loopback is 0).
+    CsmaHelper csmaHelper;
+    NodeContainer lanNodes;
+    lanNodes.Add(serverNodes); // Servers are nodes 0 to M-1 on this link's container
+    lanNodes.Add(clientNodes); // Clients are nodes M to M+N-1
+    lanNodes.Add(tierNodes);   // Downstream tiers follow the clients
+    NetDeviceContainer lanDevices = csmaHelper.Install(lanNodes);
+
+    Ipv4AddressHelper addressHelper;
+    addressHelper.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer lanInterfaces = addressHelper.Assign(lanDevices);
+    for (uint32_t i = 0; i < serverNodes.GetN(); ++i) {
+        NS_LOG_DEBUG("    Server " << i << " IP (on its ifIndex 1): " << lanInterfaces.GetAddress(i));
+    }
+    for (uint32_t i = 0; i < clientNodes.GetN(); ++i) {
+        NS_LOG_DEBUG("    Client " << i << " IP (on its ifIndex 1): " << lanInterfaces.GetAddress(numServers + i));
+    }
+    NS_LOG_INFO("Flat topology creation finished.");
+}
+
 } // namespace ns3
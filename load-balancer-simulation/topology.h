@@ -7,7 +7,8 @@
 #include "ns3/internet-module.h"    // For InternetStackHelper, Ipv4AddressHelper (implicitly)
 #include "ns3/csma-module.h"        // For CsmaHelper (used in .cc)
 
-// Standard Library Includes (none strictly needed in this header)
+// Standard Library Includes
+#include <vector>
 
 namespace ns3 {
 
@@ -25,15 +26,48 @@ namespace ns3 {
  * @param[out] clientNodes A NodeContainer that will be populated with the created client nodes.
  * @param[out] lbNode A Ptr<Node> that will point to the created load balancer node.
  * @param[out] serverNodes A NodeContainer that will be populated with the created server nodes.
+ * For multi-tier service graphs, the servers of every downstream tier join the backend
+ * network after the servers (they are called by the tier before them, not by the LB).
+ *
  * @param internetStack An InternetStackHelper instance used to install the internet stack on all nodes.
  * It is passed by reference as its state might be modified (though typically not in basic installs).
+ * @param downstreamTierSizes Number of servers in each downstream tier, nearest tier first (empty for none).
+ * @param[out] downstreamTierNodes Populated with one NodeContainer per downstream tier.
  */
 void CreateTopology(uint32_t numClients,
                     uint32_t numServers,
                     NodeContainer& clientNodes,
                     Ptr<Node>& lbNode,
                     NodeContainer& serverNodes,
-                    InternetStackHelper& internetStack);
+                    InternetStackHelper& internetStack,
+                    const std::vector<uint32_t>& downstreamTierSizes,
+                    std::vector<NodeContainer>& downstreamTierNodes);
+
+/**
+ * @brief Creates a flat topology for client-side load balancing: clients and servers on one LAN.
+ *
+ * Clients --- CSMA LAN (10.1.1.0/24) --- Servers
+ *
+ * There is no load balancer node; each client balances its own requests over the servers.
+ * Servers take the first addresses of the LAN (.1, .2, ...), then the clients.
+ *
+ * @param numClients The number of client nodes to create.
+ * @param numServers The number of backend server nodes to create.
+ * @param[out] clientNodes A NodeContainer that will be populated with the created client nodes.
+ * @param[out] serverNodes A NodeContainer that will be populated with the created server nodes.
+ * Downstream tiers, if any, join the same LAN after the clients.
+ *
+ * @param internetStack An InternetStackHelper instance used to install the internet stack on all nodes.
+ * @param downstreamTierSizes Number of servers in each downstream tier, nearest tier first (empty for none).
+ * @param[out] downstreamTierNodes Populated with one NodeContainer per downstream tier.
+ */
+void CreateFlatTopology(uint32_t numClients,
+                        uint32_t numServers,
+                        NodeContainer& clientNodes,
+                        NodeContainer& serverNodes,
+                        InternetStackHelper& internetStack,
+                        const std::vector<uint32_t>& downstreamTierSizes,
+                        std::vector<NodeContainer>& downstreamTierNodes);
 
 } // namespace ns3
 
@@ -0,0 +1,183 @@
+#include "trace_reader.h"
+
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+#include <cerrno>   // For errno
+#include <cstring>  // For std::memcmp, std::strerror
+
+#include <fcntl.h>    // For open()
+#include <sys/mman.h> // For mmap(), madvise(), munmap()
+#include <sys/stat.h> // For fstat()
+#include <unistd.h>   // For close(), sysconf()
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("TraceReader");
+
+namespace {
+
+constexpr char kTraceMagic[8] = {'L', 'B', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr uint32_t kTraceVersion = 1;
+constexpr size_t kHeaderSize = 32;
+constexpr uint32_t kMinRecordSize = 24;
+constexpr size_t kReleaseWindowBytes = 64 * 1024 * 1024; // Consumed bytes dropped per madvise call
+
+uint32_t ReadLe32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t ReadLe64(const uint8_t* p)
+{
+    return static_cast<uint64_t>(ReadLe32(p)) | (static_cast<uint64_t>(ReadLe32(p + 4)) << 32);
+}
+
+} // namespace
+
+TraceReader::TraceReader()
+    : m_base(nullptr),
+      m_mappedSize(0),
+      m_recordSize(0),
+      m_recordCount(0),
+      m_nextIndex(0),
+      m_shardCount(1),
+      m_releasedUpTo(0),
+      m_lastSendOffset(0)
+{
+}
+
+TraceReader::~TraceReader()
+{
+    Close();
+}
+
+bool
+TraceReader::Open(const std::string& path, uint32_t shardIndex, uint32_t shardCount)
+{
+    NS_LOG_FUNCTION(this << path << shardIndex << shardCount);
+    Close();
+
+    if (shardCount == 0 || shardIndex >= shardCount) {
+        NS_LOG_ERROR("Invalid trace shard " << shardIndex << "/" << shardCount);
+        return false;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        NS_LOG_ERROR("Cannot open trace file '" << path << "': " << std::strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kHeaderSize) {
+        NS_LOG_ERROR("Trace file '" << path << "' is too small to hold a trace header.");
+        ::close(fd);
+        return false;
+    }
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file referenced.
+    if (mapping == MAP_FAILED) {
+        NS_LOG_ERROR("Cannot map trace file '" << path << "': " << std::strerror(errno));
+        return false;
+    }
+    ::madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    m_base = static_cast<const uint8_t*>(mapping);
+    m_mappedSize = fileSize;
+
+    const uint32_t version = ReadLe32(m_base + 8);
+    m_recordSize = ReadLe32(m_base + 12);
+    const uint64_t declaredCount = ReadLe64(m_base + 16);
+    if (std::memcmp(m_base, kTraceMagic, sizeof(kTraceMagic)) != 0 || version != kTraceVersion ||
+        m_recordSize < kMinRecordSize) {
+        NS_LOG_ERROR("'" << path << "' is not a version " << kTraceVersion << " trace file (version "
+                         << version << ", record size " << m_recordSize << ").");
+        Close();
+        return false;
+    }
+
+    const uint64_t presentCount = (fileSize - kHeaderSize) / m_recordSize;
+    m_recordCount = declaredCount;
+    if (presentCount < declaredCount) {
+        NS_LOG_WARN("Trace file '" << path << "' is truncated: header declares " << declaredCount
+                                   << " records, file holds " << presentCount << ". Replaying what is present.");
+        m_recordCount = presentCount;
+    }
+
+    m_nextIndex = shardIndex;
+    m_shardCount = shardCount;
+    m_releasedUpTo = 0;
+    m_lastSendOffset = Seconds(0);
+
+    NS_LOG_INFO("Opened trace '" << path << "': " << m_recordCount << " records of " << m_recordSize
+                                 << " bytes, shard " << shardIndex << "/" << shardCount);
+    return true;
+}
+
+void
+TraceReader::Close()
+{
+    if (m_base) {
+        ::munmap(const_cast<uint8_t*>(m_base), m_mappedSize);
+    }
+    m_base = nullptr;
+    m_mappedSize = 0;
+    m_recordCount = 0;
+    m_nextIndex = 0;
+    m_releasedUpTo = 0;
+}
+
+bool
+TraceReader::Next(TraceRecord& record)
+{
+    if (!m_base || m_nextIndex >= m_recordCount) {
+        return false;
+    }
+
+    const size_t offset = kHeaderSize + static_cast<size_t>(m_nextIndex) * m_recordSize;
+    const uint8_t* p = m_base + offset;
+    record.sendOffset = NanoSeconds(static_cast<int64_t>(ReadLe64(p)));
+    record.l7Identifier = ReadLe64(p + 8);
+    record.requestSize = ReadLe32(p + 16);
+    record.serviceTimeHint = MicroSeconds(ReadLe32(p + 20));
+    if (record.sendOffset < m_lastSendOffset) {
+        NS_FATAL_ERROR("Trace record " << m_nextIndex << " goes back in time: send offset "
+                                       << record.sendOffset.GetNanoSeconds() << " ns after "
+                                       << m_lastSendOffset.GetNanoSeconds() << " ns.");
+    }
+    m_lastSendOffset = record.sendOffset;
+
+    m_nextIndex += m_shardCount;
+    ReleaseConsumed(offset);
+    return true;
+}
+
+uint64_t
+TraceReader::GetRecordCount() const
+{
+    return m_recordCount;
+}
+
+bool
+TraceReader::IsOpen() const
+{
+    return m_base != nullptr;
+}
+
+void
+TraceReader::ReleaseConsumed(size_t consumedUpTo)
+{
+    if (consumedUpTo - m_releasedUpTo < kReleaseWindowBytes) {
+        return;
+    }
+    static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t releaseEnd = consumedUpTo - (consumedUpTo % pageSize);
+    ::madvise(const_cast<uint8_t*>(m_base) + m_releasedUpTo, releaseEnd - m_releasedUpTo, MADV_DONTNEED);
+    m_releasedUpTo = releaseEnd;
+}
+
+} // namespace ns3
@@ -0,0 +1,107 @@
+#ifndef TRACE_READER_H
+#define TRACE_READER_H
+
+// NS-3 Includes
+#include "ns3/nstime.h" // For ns3::Time
+
+// Standard Library Includes
+#include <cstddef> // For size_t
+#include <cstdint> // For uint32_t, uint64_t
+#include <string>
+
+namespace ns3 {
+
+/**
+ * @brief One request of a recorded workload.
+ */
+struct TraceRecord {
+    Time sendOffset;        //!< Send time relative to the start of the trace.
+    uint64_t l7Identifier;  //!< Request key, used as the L7 identifier.
+    uint32_t requestSize;   //!< Request payload size in bytes.
+    Time serviceTimeHint;   //!< Recorded backend service time (zero if not captured).
+};
+
+/**
+ * @brief Streams request records out of a memory-mapped binary trace file.
+ *
+ * File layout (all integers little-endian):
+ * - Header (32 bytes): magic "LBTRACE1", u32 version (1), u32 record size (>= 24),
+ *   u64 record count, u64 reserved.
+ * - Records, each `record size` bytes: u64 send offset (ns), u64 key / L7 id,
+ *   u32 request size (bytes), u32 service-time hint (us, 0 = none). Bytes past the
+ *   first 24 of a record are ignored, so newer writers may append fields.
+ *
+ * Records must be in send-offset order; a record whose offset goes backwards is a fatal
+ * error rather than being replayed out of order. The file is mapped read-only and
+ * consumed strictly front to back: the kernel is told the access is sequential, and
+ * pages behind the read position are released in large windows, so resident memory
+ * stays bounded no matter how large the trace is.
+ *
+ * A reader can be restricted to one shard of the trace: shard @c s of @c n yields
+ * records @c s, @c s+n, @c s+2n, ... so that @c n clients together replay every
+ * record exactly once while each keeps the overall traffic shape.
+ */
+class TraceReader
+{
+  public:
+    TraceReader();
+    ~TraceReader();
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    /**
+     * @brief Maps a trace file and positions the reader at the first record of the shard.
+     * @param path Path of the trace file.
+     * @param shardIndex Index of the shard to read (must be < shardCount).
+     * @param shardCount Total number of shards the trace is split into (>= 1).
+     * @return True on success; false (with an error logged) if the file cannot be
+     * mapped or is not a valid trace.
+     */
+    bool Open(const std::string& path, uint32_t shardIndex = 0, uint32_t shardCount = 1);
+
+    /**
+     * @brief Unmaps the trace file. Safe to call when nothing is open.
+     */
+    void Close();
+
+    /**
+     * @brief Reads the next record of this reader's shard.
+     * @param[out] record Filled in on success.
+     * @return True if a record was read, false once the shard is exhausted.
+     * Aborts if the record's send offset is earlier than the previous one.
+     */
+    bool Next(TraceRecord& record);
+
+    /**
+     * @brief Gets the number of records in the whole trace (all shards).
+     * @return The record count.
+     */
+    uint64_t GetRecordCount() const;
+
+    /**
+     * @brief Checks whether a trace is currently mapped.
+     * @return True if Open() succeeded and Close() has not been called since.
+     */
+    bool IsOpen() const;
+
+  private:
+    /**
+     * @brief Drops already-consumed pages from the mapping once a full window has been read.
+     * @param consumedUpTo Byte offset into the file below which nothing will be read again.
+     */
+    void ReleaseConsumed(size_t consumedUpTo);
+
+    const uint8_t* m_base;   //!< Start of the mapping (nullptr when closed).
+    size_t m_mappedSize;     //!< Length of the mapping in bytes.
+    uint32_t m_recordSize;   //!< Stride between consecutive records.
+    uint64_t m_recordCount;  //!< Number of complete records in the file.
+    uint64_t m_nextIndex;    //!< Index of the next record to return.
+    uint32_t m_shardCount;   //!< Stride between records of this shard.
+    size_t m_releasedUpTo;   //!< Byte offset below which pages have been released.
+    Time m_lastSendOffset;   //!< Send offset of the previous record returned.
+};
+
+} // namespace ns3
+
+#endif // TRACE_READER_H
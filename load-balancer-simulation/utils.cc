@@ -8,8 +8,13 @@
 #include "ns3/node-container.h"             // For NodeContainer
 #include "ns3/simulator.h"                  // For Simulator::Now()
 
+#include <algorithm> // For std::upper_bound
+#include <charconv>  // For std::from_chars
+#include <fstream>   // For std::ifstream
 #include <stdexcept> // For std::runtime_error
 #include <sstream>   // For std::stringstream
+#include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -22,6 +27,11 @@ const uint32_t PACKET_SIZE = 1024; // Bytes
 const uint16_t SERVER_PORT = 9;    // Default Echo port, often used for simple servers
 const uint16_t LB_PORT = 80;       // Standard HTTP port, common for load balancers
 
+const int64_t RNG_STREAMS_PER_APP = 16;
+const int64_t RNG_STREAM_BASE_LB = 100;
+const int64_t RNG_STREAM_BASE_SERVERS = 1000;
+const int64_t RNG_STREAM_BASE_CLIENTS = 1000000;
+
 // --- Helper Functions Implementation ---
 
 Ipv4Address GetIpv4Address(Ptr<Node> node, uint32_t interfaceIndex)
@@ -117,4 +127,103 @@ void LogSimulationTime(const std::string& message) {
     NS_LOG_INFO(Simulator::Now().GetSeconds() << "s - " << message);
 }
 
+std::vector<std::string> SplitSpec(const std::string& spec, char delimiter)
+{
+    std::vector<std::string> fields;
+    if (spec.empty()) {
+        return fields;
+    }
+    std::stringstream ss(spec);
+    std::string field;
+    while (std::getline(ss, field, delimiter)) {
+        field.erase(0, field.find_first_not_of(" \t\n\r\f\v"));
+        field.erase(field.find_last_not_of(" \t\n\r\f\v") + 1);
+        fields.push_back(field);
+    }
+    if (spec.back() == delimiter) {
+        fields.emplace_back(); // getline drops a trailing empty field
+    }
+    return fields;
+}
+
+bool ParseSpecNumber(const std::string& field, double& value)
+{
+    if (field.empty()) {
+        return false;
+    }
+    double parsed = 0.0;
+    auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), parsed);
+    if (ec != std::errc() || ptr != field.data() + field.size()) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+void LoadEmpiricalCdf(const std::string& path, const std::string& what,
+                      std::vector<double>& values, std::vector<double>& cumulative)
+{
+    NS_LOG_FUNCTION(path << what);
+    std::ifstream in(path);
+    if (!in) {
+        NS_FATAL_ERROR("Cannot open " << what << " CDF file '" << path << "'.");
+    }
+
+    values.clear();
+    cumulative.clear();
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        double value = 0.0;
+        double probability = 0.0;
+        if (!(fields >> value >> probability) || value < 0.0 || probability < 0.0 || probability > 1.0) {
+            NS_FATAL_ERROR("The " << what << " CDF file '" << path << "' line " << lineNumber
+                           << ": expected '<" << what << "> <cumulative probability in [0,1]>'.");
+        }
+        if (!values.empty() && (value < values.back() || probability < cumulative.back())) {
+            NS_FATAL_ERROR("The " << what << " CDF file '" << path << "' line " << lineNumber
+                           << ": values and probabilities must be non-decreasing.");
+        }
+        values.push_back(value);
+        cumulative.push_back(probability);
+    }
+    if (cumulative.empty() || cumulative.back() != 1.0) {
+        NS_FATAL_ERROR("The " << what << " CDF file '" << path << "' must end at cumulative probability 1.");
+    }
+    NS_LOG_DEBUG("Loaded " << values.size() << " CDF points from '" << path << "'");
+}
+
+double InvertEmpiricalCdf(double u, const std::vector<double>& values, const std::vector<double>& cumulative)
+{
+    const size_t i = std::upper_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+    if (i == 0) {
+        return values.front();
+    }
+    if (i == cumulative.size()) {
+        return values.back();
+    }
+    // Interpolate within the segment (i - 1, i]; its probability span is non-zero since u crossed it.
+    const double fraction = (u - cumulative[i - 1]) / (cumulative[i] - cumulative[i - 1]);
+    return values[i - 1] + fraction * (values[i] - values[i - 1]);
+}
+
+int64_t AssignStreamBlock(Ptr<Application> app, int64_t roleBase, uint32_t index)
+{
+    NS_LOG_FUNCTION(app << roleBase << index);
+    const int64_t first = roleBase + static_cast<int64_t>(index) * RNG_STREAMS_PER_APP;
+    const int64_t used = app->AssignStreams(first);
+    if (used > RNG_STREAMS_PER_APP) {
+        NS_FATAL_ERROR("Application " << index << " at stream base " << roleBase << " uses " << used
+                       << " RNG streams, more than its block of " << RNG_STREAMS_PER_APP);
+    }
+    return used;
+}
+
 } // namespace ns3
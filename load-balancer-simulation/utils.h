@@ -5,9 +5,11 @@
 #include "ns3/core-module.h"        // For Ptr, Time, Simulator, uint32_t, uint16_t
 #include "ns3/network-module.h"     // For NodeContainer, Node, Ipv4Address (via internet-module below)
 #include "ns3/internet-module.h"    // For Ipv4, Ipv4Address, Ipv4InterfaceAddress
+#include "ns3/application.h"        // For Ptr<Application> (stream assignment)
 
 // Standard Library Includes
 #include <string> // For std::string
+#include <vector> // For std::vector
 
 namespace ns3 {
 
@@ -21,6 +23,16 @@ extern const uint32_t PACKET_SIZE;    //!< Default packet size in bytes.
 extern const uint16_t SERVER_PORT;    //!< Default port number for backend server applications.
 extern const uint16_t LB_PORT;        //!< Default port number on which the load balancer listens.
 
+// --- RNG Stream Layout ---
+// Every application gets a fixed block of RNG streams keyed by its role and index, so
+// adding a random variable to one application never shifts the draws of another and two
+// runs that differ only in the load balancing algorithm see identical client workloads.
+
+extern const int64_t RNG_STREAMS_PER_APP;      //!< Size of the stream block reserved for each application.
+extern const int64_t RNG_STREAM_BASE_LB;       //!< First stream of the load balancer block.
+extern const int64_t RNG_STREAM_BASE_SERVERS;  //!< First stream of server 0's block.
+extern const int64_t RNG_STREAM_BASE_CLIENTS;  //!< First stream of client 0's block.
+
 // --- Helper Functions ---
 
 /**
@@ -57,6 +69,58 @@ void PrintNodeIps(const NodeContainer& nodes); // Pass by const reference
  */
 void LogSimulationTime(const std::string& message);
 
+/**
+ * @brief Splits a compact command-line spec (e.g., "pareto:1.5") into its fields.
+ * Each field is trimmed of surrounding whitespace; empty fields are preserved so
+ * callers can detect them.
+ * @param spec The spec string to split.
+ * @param delimiter The field separator (':' by default).
+ * @return The list of fields. An empty spec yields an empty vector.
+ */
+std::vector<std::string> SplitSpec(const std::string& spec, char delimiter = ':');
+
+/**
+ * @brief Parses a whole spec field as a floating-point number.
+ * @param field The field text (already trimmed).
+ * @param[out] value The parsed value; untouched on failure.
+ * @return True if the entire field was a valid number, false otherwise.
+ */
+bool ParseSpecNumber(const std::string& field, double& value);
+
+/**
+ * @brief Reads an empirical CDF from a text file.
+ * Each non-empty line that does not start with '#' holds `<value> <cumulative probability>`.
+ * Both columns must be non-decreasing and the last probability must be 1. Aborts the
+ * simulation if the file cannot be read or is malformed.
+ * @param path The file to read.
+ * @param what What the values are (e.g., "size"), for error messages.
+ * @param[out] values The CDF abscissae.
+ * @param[out] cumulative The cumulative probability at each value.
+ */
+void LoadEmpiricalCdf(const std::string& path, const std::string& what,
+                      std::vector<double>& values, std::vector<double>& cumulative);
+
+/**
+ * @brief Inverts an empirical CDF with linear interpolation between points (a binary search).
+ * Probability mass below the first point maps to the first value.
+ * @param u A probability in [0, 1], usually a uniform variate.
+ * @param values The CDF abscissae (non-empty, as loaded by LoadEmpiricalCdf()).
+ * @param cumulative The cumulative probability at each value.
+ * @return The value at probability @p u.
+ */
+double InvertEmpiricalCdf(double u, const std::vector<double>& values, const std::vector<double>& cumulative);
+
+/**
+ * @brief Assigns an application the RNG streams of its fixed block.
+ * Application @p index of a role starts at roleBase + index * RNG_STREAMS_PER_APP.
+ * Aborts the simulation if the application needs more streams than one block.
+ * @param app The application (its AssignStreams is called).
+ * @param roleBase One of the RNG_STREAM_BASE_* constants.
+ * @param index The application's index within its role.
+ * @return The number of streams the application used.
+ */
+int64_t AssignStreamBlock(Ptr<Application> app, int64_t roleBase, uint32_t index);
+
 } // namespace ns3
 
 #endif // UTILS_H